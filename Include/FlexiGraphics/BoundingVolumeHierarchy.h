@@ -0,0 +1,680 @@
+#ifndef BoundingVolumeHierarchy_H__
+#define BoundingVolumeHierarchy_H__
+/**
+ * @file
+ * @brief Defines BoundingVolumeHierarchy, a box tree over triangles or objects.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiUtil\Parallel.h"
+#include "FlexiMath\FlexiMath.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief A binary tree of axis-aligned boxes over a set of primitives, each
+ *  known only by its bounds, for ray and overlap queries.
+ *
+ * build() splits primitives with the surface area heuristic evaluated over a
+ * fixed number of bins per axis. The top of the tree is split with the binning
+ * spread across cores until there is enough independent work, and the subtrees
+ * below are then built in parallel. Nodes are stored depth-first in a 64-byte
+ * aligned array of 32-byte nodes: an inner node's first child directly follows
+ * it, so only the second child's index is stored.
+ *
+ * When primitives move without changing much relative to each other, refit()
+ * recomputes every box bottom-up in linear time instead of rebuilding; query
+ * cost grows slowly as the tree drifts from the one build() would make.
+ *
+ * Primitives are referred to by their index in the bounds array given to
+ * build().
+ */
+class BoundingVolumeHierarchy
+{
+    BoundingVolumeHierarchy(const BoundingVolumeHierarchy&);
+    BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&);
+
+public:
+    /// A 32-byte tree node; two share a cache line.
+    struct Node
+    {
+        float min[3];
+        /// The first entry in getPrimitives() of a leaf, or the second child
+        uint32_t index;
+        float max[3];
+        /// The number of primitives of a leaf, 0 for an inner node
+        uint32_t count;
+
+        bool isLeaf() const { return count != 0; }
+    };
+
+    /// Trees are never deeper than this many levels
+    static const unsigned MAX_DEPTH = 64;
+
+    BoundingVolumeHierarchy() : nodes(0), nodeCount(0) {}
+
+    /**
+     * @brief Builds the tree over @a count primitives with the given bounds,
+     *  replacing any previous tree.
+     *
+     * @param maxLeafSize Leaves hold at most this many primitives unless the
+     *  primitives cannot be told apart by their centers.
+     */
+    void build(const math::BoundingBox* bounds, unsigned count, unsigned maxLeafSize = 4) {
+        primitives.resize(count);
+        references.resize(count);
+        subtrees.clear();
+        topNodes.clear();
+        this->maxLeafSize = std::max(maxLeafSize, 1u);
+
+        const unsigned chunks = chunkCount(count);
+        const unsigned chunkSize = (count + chunks - 1) / std::max(chunks, 1u);
+        util::parallelFor(chunks, [&](unsigned chunk) {
+            const unsigned end = std::min(count, (chunk + 1) * chunkSize);
+            for (unsigned i = chunk * chunkSize; i < end; ++i) {
+                references[i].box = Box(bounds[i]);
+                references[i].primitive = i;
+            }
+        });
+
+        if (count == 0) {
+            setNodeCount(0);
+            return;
+        }
+
+        // Split the top serially, with parallel binning, into subtree tasks
+        const unsigned workers = util::getWorkerCount();
+        taskSize = workers > 1 ? std::max(count / (workers * 8), 1024u) : count;
+        std::vector<TopNode> top;
+        std::vector<Task> tasks;
+        splitTop(0, count, 0, top, tasks);
+
+        std::vector<std::vector<Node> > built(tasks.size());
+        util::parallelFor(unsigned(tasks.size()), [&](unsigned i) {
+            built[i].reserve(2 * (tasks[i].end - tasks[i].begin) / this->maxLeafSize + 1);
+            buildSubtree(tasks[i].begin, tasks[i].end, tasks[i].depth, built[i]);
+        });
+
+        // Lay the top nodes and subtrees out depth-first
+        size_t total = top.size() - tasks.size();
+        for (size_t i = 0; i < built.size(); ++i)
+            total += built[i].size();
+        setNodeCount(total);
+        uint32_t next = 0;
+        flatten(top, 0, built, next);
+        flexiAssert(next == total);
+        std::sort(topNodes.begin(), topNodes.end());
+
+        for (unsigned i = 0; i < count; ++i)
+            primitives[i] = references[i].primitive;
+        std::vector<Reference>().swap(references);
+    }
+
+    /**
+     * @brief Recomputes every node's box from new primitive bounds without
+     *  changing the tree's shape.
+     *
+     * @param bounds New bounds for the same primitives build() was given.
+     */
+    void refit(const math::BoundingBox* bounds) {
+        if (nodeCount == 0)
+            return;
+        Node* nodes = this->nodes;
+        const uint32_t* primitives = primitives_();
+        const auto refitRange = [=](uint32_t first, uint32_t end) {
+            for (uint32_t i = end; i-- > first; )
+                refitNode(i, nodes, primitives, bounds);
+        };
+
+        // Subtrees are contiguous and independent; the top nodes above them
+        // are refit afterwards, deepest first.
+        if (subtrees.size() > 1 && nodeCount > PARALLEL_MIN) {
+            util::parallelFor(unsigned(subtrees.size()), [&](unsigned i) {
+                refitRange(subtrees[i].first, subtrees[i].end);
+            });
+        } else {
+            for (size_t i = 0; i < subtrees.size(); ++i)
+                refitRange(subtrees[i].first, subtrees[i].end);
+        }
+        for (size_t i = topNodes.size(); i-- > 0; )
+            refitNode(topNodes[i], nodes, primitives, bounds);
+    }
+
+    size_t getNodeCount() const { return nodeCount; }
+    const Node* getNodes() const { return nodes; }
+
+    size_t getPrimitiveCount() const { return primitives.size(); }
+    /// Primitive indices in leaf order; leaves refer to runs of these.
+    const uint32_t* getPrimitives() const { return primitives_(); }
+
+    math::BoundingBox getBounds() const {
+        if (nodeCount == 0)
+            return math::BoundingBox();
+        return math::BoundingBox(math::Vector3f(nodes[0].min[0], nodes[0].min[1], nodes[0].min[2]),
+                                 math::Vector3f(nodes[0].max[0], nodes[0].max[1], nodes[0].max[2]));
+    }
+
+    /**
+     * @brief Calls visitor.visit(uint32_t primitive) for each primitive whose
+     *  bounds the tree places in a leaf overlapping @a region.
+     *
+     * Primitives of overlapping leaves are all visited; the visitor should test
+     * their exact bounds if it needs to.
+     */
+    template <typename Visitor>
+    void traverseBox(const math::BoundingBox& region, Visitor& visitor) const {
+        if (nodeCount == 0)
+            return;
+        const Box box(region);
+        const uint32_t* primitives = primitives_();
+        uint32_t stack[MAX_DEPTH];
+        unsigned size = 0;
+        uint32_t current = 0;
+        for (;;) {
+            const Node& node = nodes[current];
+            if (box.overlaps(node)) {
+                if (node.isLeaf()) {
+                    for (uint32_t i = 0; i < node.count; ++i)
+                        visitor.visit(primitives[node.index + i]);
+                } else {
+                    stack[size++] = node.index;
+                    current = current + 1;
+                    continue;
+                }
+            }
+            if (size == 0)
+                return;
+            current = stack[--size];
+        }
+    }
+
+    /**
+     * @brief Walks the leaves hit by the segment origin + t * direction,
+     *  0 <= t <= @a maxDistance, roughly nearest first.
+     *
+     * Calls bool visitor.visit(uint32_t primitive, float& maxDistance) for each
+     * primitive of each leaf hit. The visitor shortens maxDistance when it
+     * finds a hit, which prunes the rest of the walk, and returns false to end
+     * the walk early, e.g. when any hit will do.
+     *
+     * @return The final maxDistance.
+     */
+    template <typename Visitor>
+    float traverseRay(const math::Vector3f& origin, const math::Vector3f& direction,
+                      float maxDistance, Visitor& visitor) const {
+        if (nodeCount == 0)
+            return maxDistance;
+        const Ray ray(origin, direction);
+        const uint32_t* primitives = primitives_();
+        uint32_t stack[MAX_DEPTH];
+        float stackEntry[MAX_DEPTH];
+        unsigned size = 0;
+        float entry;
+        if (!ray.hits(nodes[0], maxDistance, entry))
+            return maxDistance;
+        uint32_t current = 0;
+        for (;;) {
+            const Node& node = nodes[current];
+            if (node.isLeaf()) {
+                for (uint32_t i = 0; i < node.count; ++i)
+                    if (!visitor.visit(primitives[node.index + i], maxDistance))
+                        return maxDistance;
+            } else {
+                const uint32_t first = current + 1, second = node.index;
+                float firstEntry, secondEntry;
+                const bool hitsFirst = ray.hits(nodes[first], maxDistance, firstEntry);
+                const bool hitsSecond = ray.hits(nodes[second], maxDistance, secondEntry);
+                if (hitsFirst && hitsSecond) {
+                    // Visit the closer child first and come back for the other
+                    if (secondEntry < firstEntry) {
+                        stack[size] = first; stackEntry[size++] = firstEntry;
+                        current = second;
+                    } else {
+                        stack[size] = second; stackEntry[size++] = secondEntry;
+                        current = first;
+                    }
+                    continue;
+                } else if (hitsFirst || hitsSecond) {
+                    current = hitsFirst ? first : second;
+                    continue;
+                }
+            }
+            // Pop, skipping children the ray now ends before
+            do {
+                if (size == 0)
+                    return maxDistance;
+                --size;
+            } while (stackEntry[size] > maxDistance);
+            current = stack[size];
+        }
+    }
+
+    /// Appends the primitives traverseBox() would visit to @a results
+    void queryBox(const math::BoundingBox& region, std::vector<uint32_t>& results) const {
+        Collector collector(results);
+        traverseBox(region, collector);
+    }
+
+private: /**************************** Build ********************************/
+
+    /// Ranges longer than this are measured and binned across cores
+    static const unsigned PARALLEL_MIN = 1 << 16;
+    static const unsigned BIN_COUNT = 16;
+
+    struct Box
+    {
+        float min[3], max[3];
+
+        Box() {
+            min[0] = min[1] = min[2] = FLT_MAX;
+            max[0] = max[1] = max[2] = -FLT_MAX;
+        }
+        explicit Box(const math::BoundingBox& b) {
+            min[0] = b.min.x; min[1] = b.min.y; min[2] = b.min.z;
+            max[0] = b.max.x; max[1] = b.max.y; max[2] = b.max.z;
+        }
+        explicit Box(const Node& node) {
+            std::memcpy(min, node.min, sizeof min);
+            std::memcpy(max, node.max, sizeof max);
+        }
+
+        void extend(const Box& b) {
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                min[axis] = std::min(min[axis], b.min[axis]);
+                max[axis] = std::max(max[axis], b.max[axis]);
+            }
+        }
+        void extend(const float* point) {
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                min[axis] = std::min(min[axis], point[axis]);
+                max[axis] = std::max(max[axis], point[axis]);
+            }
+        }
+        /// Half the surface area, which is all the heuristic needs
+        float area() const {
+            const float x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+            return (x < 0) ? 0 : x * y + y * z + z * x;
+        }
+        bool overlaps(const Node& node) const {
+            return min[0] <= node.max[0] && max[0] >= node.min[0]
+                && min[1] <= node.max[1] && max[1] >= node.min[1]
+                && min[2] <= node.max[2] && max[2] >= node.min[2];
+        }
+        void store(Node& node) const {
+            std::memcpy(node.min, min, sizeof min);
+            std::memcpy(node.max, max, sizeof max);
+        }
+    };
+
+    /// A primitive's bounds, moved along with it as ranges are partitioned
+    struct Reference
+    {
+        Box box;
+        uint32_t primitive;
+
+        float center(unsigned axis) const { return (box.min[axis] + box.max[axis]) * 0.5f; }
+    };
+
+    /// The bounds of a range of primitives and of their centers
+    struct Extent
+    {
+        Box bounds, centers;
+
+        void merge(const Extent& e) {
+            bounds.extend(e.bounds);
+            centers.extend(e.centers);
+        }
+    };
+
+    struct Bins
+    {
+        Box bounds[3][BIN_COUNT];
+        unsigned counts[3][BIN_COUNT];
+
+        Bins() { std::memset(counts, 0, sizeof counts); }
+
+        void merge(const Bins& that) {
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                for (unsigned bin = 0; bin < BIN_COUNT; ++bin) {
+                    bounds[axis][bin].extend(that.bounds[axis][bin]);
+                    counts[axis][bin] += that.counts[axis][bin];
+                }
+            }
+        }
+    };
+
+    /**
+     * Maps centers to bins along each axis of a range's center bounds. Short
+     * ranges use fewer bins, since sweeping the bins would otherwise cost more
+     * than binning the primitives.
+     */
+    struct Binning
+    {
+        float origin[3], scale[3];
+        unsigned count;
+
+        Binning(const Box& centers, uint32_t primitiveCount)
+            : count(std::min(primitiveCount, uint32_t(BIN_COUNT)))
+        {
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                const float extent = centers.max[axis] - centers.min[axis];
+                origin[axis] = centers.min[axis];
+                scale[axis] = extent > 0 ? count * 0.99999f / extent : 0;
+            }
+        }
+        unsigned bin(const Reference& reference, unsigned axis) const {
+            const int bin = int((reference.center(axis) - origin[axis]) * scale[axis]);
+            return unsigned(std::min(std::max(bin, 0), int(count) - 1));
+        }
+    };
+
+    /// The best place to cut a range, if any
+    struct Split
+    {
+        unsigned axis, bin;
+        float cost;
+    };
+
+    struct TopNode
+    {
+        Box bounds;
+        /// The second child, or the subtree task if this is a task's root
+        int right, task;
+    };
+
+    struct Task
+    {
+        uint32_t begin, end;
+        unsigned depth;
+    };
+
+    /// A contiguous run of node indices holding one built subtree
+    struct NodeRange
+    {
+        uint32_t first, end;
+    };
+
+    unsigned chunkCount(unsigned count) const {
+        return count > PARALLEL_MIN ? util::getWorkerCount() * 4 : (count ? 1 : 0);
+    }
+
+    Extent measure(uint32_t begin, uint32_t end) const {
+        Extent extent;
+        for (uint32_t i = begin; i < end; ++i) {
+            const Reference& reference = references[i];
+            float center[3];
+            for (unsigned axis = 0; axis < 3; ++axis)
+                center[axis] = reference.center(axis);
+            extent.bounds.extend(reference.box);
+            extent.centers.extend(center);
+        }
+        return extent;
+    }
+
+    void bin(uint32_t begin, uint32_t end, const Binning& binning, Bins& bins) const {
+        for (uint32_t i = begin; i < end; ++i) {
+            const Reference& reference = references[i];
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                const unsigned b = binning.bin(reference, axis);
+                bins.bounds[axis][b].extend(reference.box);
+                ++bins.counts[axis][b];
+            }
+        }
+    }
+
+    /// Runs measure() or bin() over a long range in parallel chunks
+    template <typename Result, typename Function>
+    Result reduce(uint32_t begin, uint32_t end, Function function) const {
+        const unsigned chunks = chunkCount(end - begin);
+        const uint32_t chunkSize = (end - begin + chunks - 1) / chunks;
+        std::vector<Result> partial(chunks);
+        util::parallelFor(chunks, [&](unsigned chunk) {
+            const uint32_t first = begin + chunk * chunkSize;
+            function(first, std::min(end, first + chunkSize), partial[chunk]);
+        });
+        for (unsigned chunk = 1; chunk < chunks; ++chunk)
+            partial[0].merge(partial[chunk]);
+        return partial[0];
+    }
+
+    Extent measureRange(uint32_t begin, uint32_t end) const {
+        if (end - begin <= PARALLEL_MIN)
+            return measure(begin, end);
+        return reduce<Extent>(begin, end, [this](uint32_t first, uint32_t last, Extent& out) {
+            out = measure(first, last);
+        });
+    }
+
+    Bins binRange(uint32_t begin, uint32_t end, const Binning& binning, bool parallel) const {
+        if (!parallel || end - begin <= PARALLEL_MIN) {
+            Bins bins;
+            bin(begin, end, binning, bins);
+            return bins;
+        }
+        return reduce<Bins>(begin, end, [&](uint32_t first, uint32_t last, Bins& out) {
+            bin(first, last, binning, out);
+        });
+    }
+
+    /// Finds the cheapest split by sweeping the bins of each axis
+    static bool findSplit(const Bins& bins, const Binning& binning, const Box& centers,
+                          Split& best) {
+        const unsigned binCount = binning.count;
+        best.axis = best.bin = 0;
+        best.cost = FLT_MAX;
+        for (unsigned axis = 0; axis < 3; ++axis) {
+            if (!(centers.max[axis] > centers.min[axis]))
+                continue;
+            float rightCost[BIN_COUNT];
+            Box right;
+            unsigned count = 0;
+            for (unsigned bin = binCount - 1; bin > 0; --bin) {
+                right.extend(bins.bounds[axis][bin]);
+                count += bins.counts[axis][bin];
+                rightCost[bin] = right.area() * count;
+            }
+            Box left;
+            count = 0;
+            for (unsigned bin = 1; bin < binCount; ++bin) {
+                left.extend(bins.bounds[axis][bin - 1]);
+                count += bins.counts[axis][bin - 1];
+                const float cost = left.area() * count + rightCost[bin];
+                if (cost < best.cost) {
+                    best.axis = axis;
+                    best.bin = bin;
+                    best.cost = cost;
+                }
+            }
+        }
+        return best.cost < FLT_MAX;
+    }
+
+    /**
+     * Decides how to cut [begin, end) and reorders its primitives to match.
+     * Returns the cut position, or @a end to make a leaf. Subtree tasks pass
+     * @a parallel false so that they do not start threads of their own.
+     */
+    uint32_t partition(uint32_t begin, uint32_t end, unsigned depth, const Extent& extent,
+                       bool parallel) {
+        const uint32_t count = end - begin;
+        if (count <= 1 || depth + 1 >= MAX_DEPTH)
+            return end;
+
+        const Binning binning(extent.centers, count);
+        const Bins bins = binRange(begin, end, binning, parallel);
+        Split split;
+        if (!findSplit(bins, binning, extent.centers, split)) {
+            // All centers coincide: the heuristic cannot help, so halve
+            return count <= maxLeafSize ? end : begin + count / 2;
+        }
+        // Splitting costs one more box test than testing every primitive
+        if (count <= maxLeafSize && split.cost >= extent.bounds.area() * (count - 1))
+            return end;
+
+        const Reference* middle = std::partition(&references[0] + begin, &references[0] + end,
+            [&](const Reference& r) { return binning.bin(r, split.axis) < split.bin; });
+        return uint32_t(middle - &references[0]);
+    }
+
+    void splitTop(uint32_t begin, uint32_t end, unsigned depth,
+                  std::vector<TopNode>& top, std::vector<Task>& tasks) {
+        const size_t index = top.size();
+        top.push_back(TopNode());
+        if (end - begin <= taskSize) {
+            const Task task = { begin, end, depth };
+            top[index].task = int(tasks.size());
+            tasks.push_back(task);
+            return;
+        }
+        const Extent extent = measureRange(begin, end);
+        const uint32_t middle = partition(begin, end, depth, extent, true);
+        if (middle == end) {
+            const Task task = { begin, end, depth };
+            top[index].task = int(tasks.size());
+            tasks.push_back(task);
+            return;
+        }
+        top[index].bounds = extent.bounds;
+        top[index].task = -1;
+        splitTop(begin, middle, depth + 1, top, tasks);
+        top[index].right = int(top.size());
+        splitTop(middle, end, depth + 1, top, tasks);
+    }
+
+    void buildSubtree(uint32_t begin, uint32_t end, unsigned depth, std::vector<Node>& out) {
+        const uint32_t index = uint32_t(out.size());
+        out.push_back(Node());
+        const Extent extent = measure(begin, end);
+        extent.bounds.store(out[index]);
+
+        const uint32_t middle = partition(begin, end, depth, extent, false);
+        if (middle == end) {
+            out[index].index = begin;
+            out[index].count = end - begin;
+            return;
+        }
+        out[index].count = 0;
+        buildSubtree(begin, middle, depth + 1, out);
+        out[index].index = uint32_t(out.size());
+        buildSubtree(middle, end, depth + 1, out);
+    }
+
+    /// Writes top node @a t and everything under it starting at node @a next
+    void flatten(const std::vector<TopNode>& top, int t, std::vector<std::vector<Node> >& built,
+                 uint32_t& next) {
+        const TopNode& node = top[t];
+        if (node.task >= 0) {
+            const std::vector<Node>& subtree = built[node.task];
+            const uint32_t offset = next;
+            for (size_t i = 0; i < subtree.size(); ++i) {
+                nodes[offset + i] = subtree[i];
+                if (!subtree[i].isLeaf())
+                    nodes[offset + i].index += offset;
+            }
+            next += uint32_t(subtree.size());
+            const NodeRange range = { offset, next };
+            subtrees.push_back(range);
+            std::vector<Node>().swap(built[node.task]);
+            return;
+        }
+        const uint32_t index = next++;
+        topNodes.push_back(index);
+        node.bounds.store(nodes[index]);
+        nodes[index].count = 0;
+        flatten(top, t + 1, built, next);
+        nodes[index].index = next;
+        flatten(top, node.right, built, next);
+    }
+
+    static void refitNode(uint32_t index, Node* nodes, const uint32_t* primitives,
+                          const math::BoundingBox* bounds) {
+        Node& node = nodes[index];
+        Box box;
+        if (node.isLeaf()) {
+            for (uint32_t i = 0; i < node.count; ++i)
+                box.extend(Box(bounds[primitives[node.index + i]]));
+        } else {
+            box.extend(Box(nodes[index + 1]));
+            box.extend(Box(nodes[node.index]));
+        }
+        box.store(node);
+    }
+
+private: /**************************** Queries ******************************/
+
+    /// A ray prepared for slab tests against nodes
+    struct Ray
+    {
+        float origin[3], inverse[3];
+
+        Ray(const math::Vector3f& from, const math::Vector3f& direction) {
+            origin[0] = from.x; origin[1] = from.y; origin[2] = from.z;
+            inverse[0] = 1.0f / direction.x;
+            inverse[1] = 1.0f / direction.y;
+            inverse[2] = 1.0f / direction.z;
+        }
+
+        bool hits(const Node& node, float maxDistance, float& entry) const {
+            float enter = 0, exit = maxDistance;
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                const float t0 = (node.min[axis] - origin[axis]) * inverse[axis];
+                const float t1 = (node.max[axis] - origin[axis]) * inverse[axis];
+                // Written so that NaN (a parallel ray on a slab plane) is ignored
+                enter = t0 < t1 ? (t0 > enter ? t0 : enter) : (t1 > enter ? t1 : enter);
+                exit  = t0 < t1 ? (t1 < exit ? t1 : exit) : (t0 < exit ? t0 : exit);
+            }
+            entry = enter;
+            return enter <= exit;
+        }
+    };
+
+    struct Collector
+    {
+        std::vector<uint32_t>& results;
+
+        explicit Collector(std::vector<uint32_t>& results) : results(results) {}
+        void visit(uint32_t primitive) { results.push_back(primitive); }
+
+    private:
+        Collector& operator=(const Collector&);
+    };
+
+    const uint32_t* primitives_() const { return primitives.empty() ? 0 : &primitives[0]; }
+
+    void setNodeCount(size_t count) {
+        const size_t ALIGNMENT = 64;
+        nodeStorage.resize(count * sizeof(Node) + ALIGNMENT);
+        const uintptr_t address = reinterpret_cast<uintptr_t>(&nodeStorage[0]);
+        nodes = reinterpret_cast<Node*>((address + ALIGNMENT - 1) & ~uintptr_t(ALIGNMENT - 1));
+        nodeCount = count;
+    }
+
+private: /******************************* Fields ******************************/
+    std::vector<char> nodeStorage;
+    Node* nodes;
+    size_t nodeCount;
+    std::vector<uint32_t> primitives;
+
+    /// Where build() put each parallel subtree, and the nodes above them,
+    /// so refit() can work on the subtrees in parallel
+    std::vector<NodeRange> subtrees;
+    std::vector<uint32_t> topNodes;
+
+    // Used only during build()
+    std::vector<Reference> references;
+    unsigned maxLeafSize;
+    unsigned taskSize;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // BoundingVolumeHierarchy_H__
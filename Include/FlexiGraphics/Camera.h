@@ -9,9 +9,11 @@
 #ifndef Flexigin_Camera_h
 #define Flexigin_Camera_h
 
+#include <cmath>
 #include "OpenGLPlatform.h"
 #include "DebugDefs.h"
 #include "Util.h"
+#include "FlexiMath.h"
 
 OPEN_FLEXI_NAMESPACE1(graphics)
 
@@ -21,6 +23,14 @@ struct Camera {
 
     void handleDimensionChange(unsigned width, unsigned height);
 
+    /// Records the viewport size without touching GL state, for callers that
+    /// only need the camera's projection, such as level of detail selection
+    void setViewportSize(unsigned width, unsigned height) {
+        m_width = width;
+        m_height = height;
+        m_perspective_dirty = true;
+    }
+
     GLdouble verticalFieldOfView() const { return m_vertical_fov; }
     void setVerticalFieldOfView(GLdouble fovy) {
         if (fovy >= 180.0 || fovy <= 0) {
@@ -33,7 +43,7 @@ struct Camera {
     
     GLdouble nearClip() const { return m_near_clip; }
     void setNearClip(GLdouble near_clip) {
-        if (near_clip > 0) {
+        if (near_clip <= 0) {
             assert(!"Near clip must be positive");
         }
         
@@ -43,7 +53,7 @@ struct Camera {
     
     GLdouble farClip() const { return m_far_clip; }
     void setFarClip(GLdouble far_clip) {
-        if (far_clip > 0) {
+        if (far_clip <= 0) {
             assert(!"Far clip must be positive");
         }
         
@@ -51,6 +61,26 @@ struct Camera {
         m_perspective_dirty = true;
     }
 
+    /// Viewport width over height as of the last handleDimensionChange() or
+    /// setViewportSize()
+    GLdouble aspectRatio() const {
+        return m_height ? m_width / (GLdouble)m_height : 1.0;
+    }
+
+    /// Viewport height in pixels as of the last handleDimensionChange() or
+    /// setViewportSize()
+    unsigned viewportHeight() const { return m_height; }
+
+    /// Pixels spanned by one unit of length facing the camera one unit away.
+    /// Dividing by an object's distance gives its scale on screen, which turns
+    /// world-space errors into pixels (see LodSelector).
+    GLdouble pixelsPerUnit() const {
+        return m_height / (2 * tan(m_vertical_fov * math::PI / 360));
+    }
+
+    /// Builds this camera's view volume for the given camera-to-world transform
+    math::Frustum frustum(const math::Matrix4x3& view_to_world) const;
+
 private:
     GLdouble m_vertical_fov;
     GLdouble m_near_clip, m_far_clip;
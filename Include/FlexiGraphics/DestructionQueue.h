@@ -0,0 +1,124 @@
+#ifndef DestructionQueue_H__
+#define DestructionQueue_H__
+/**
+ * @file
+ * @brief Defines DestructionQueue, which deletes detached subtrees a little at
+ *        a time.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiGraphics\Visit.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Holds detached subtrees and deletes them node by node within a time
+ *  budget, so that dropping a large subtree does not stall a frame.
+ * 
+ * Deletion is iterative: an InnerNode's children are moved onto the queue
+ * before the InnerNode itself is deleted, so no destructor ever recurses.
+ * Pooled nodes are unlinked without being visited; their NodePool frees them
+ * when it is released.
+ * 
+ * Pushed subtrees wait until releaseWaiting() before they may be deleted, so
+ * that the owner can first drop any pointers it still holds into them.
+ * 
+ * Anything still queued when the queue is destroyed is deleted then.
+ */
+class DestructionQueue
+{
+    DestructionQueue(const DestructionQueue&);
+    DestructionQueue& operator=(const DestructionQueue&);
+
+public:
+    DestructionQueue() {}
+    ~DestructionQueue() { destroyAll(); }
+
+    /// Queues the detached subtree under @a node for deletion
+    void push(Node& node) {
+        flexiAssert(!node.parent && !node.sibling && !node.prevSibling);
+        if (!node.pooled)
+            waiting.push_back(&node);
+    }
+
+    /// Lets destroyFor() delete the subtrees pushed so far
+    void releaseWaiting() {
+        pending.insert(pending.end(), waiting.begin(), waiting.end());
+        waiting.clear();
+    }
+
+    bool isEmpty() const { return pending.empty() && waiting.empty(); }
+
+    /**
+     * @brief Deletes released nodes until none are left or roughly
+     *  @a budgetSeconds have passed.
+     * 
+     * @returns The number of nodes deleted.
+     */
+    unsigned destroyFor(float budgetSeconds);
+
+    /// Deletes every queued node, released or not
+    unsigned destroyAll() {
+        releaseWaiting();
+        unsigned destroyed = 0;
+        while (!pending.empty())
+            destroyed += destroyNext(~0u);
+        return destroyed;
+    }
+
+private:
+    /// Splits an InnerNode's children off onto the queue
+    struct ChildSplitter
+    {
+        std::vector<Node*>& pending;
+
+        ChildSplitter(std::vector<Node*>& pending) : pending(pending) {}
+
+        void visit(Node&) {}
+        void visit(InnerNode& innerNode) {
+            Node* child = innerNode.child;
+            innerNode.child = 0;
+            while (child) {
+                Node* next = child->sibling;
+                if (child->pooled) {
+                    child->parent = 0;
+                    child->sibling = child->prevSibling = 0;
+                } else {
+                    pending.push_back(child);
+                }
+                child = next;
+            }
+        }
+
+    private:
+        ChildSplitter& operator=(const ChildSplitter&);
+    };
+
+    /// Deletes up to @a count queued nodes
+    unsigned destroyNext(unsigned count) {
+        ChildSplitter splitter(pending);
+        unsigned destroyed = 0;
+
+        while (destroyed < count && !pending.empty()) {
+            Node* node = pending.back();
+            pending.pop_back();
+            Visit::node(*node, splitter);
+            delete node;
+            ++destroyed;
+        }
+        return destroyed;
+    }
+
+private: /******************************* Fields ******************************/
+    std::vector<Node*> waiting;
+    std::vector<Node*> pending;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // DestructionQueue_H__
@@ -0,0 +1,89 @@
+#ifndef DrawableNode_H__
+#define DrawableNode_H__
+/**
+ * @file
+ * @brief Defines DrawableNode, a leaf that draws a mesh, and DrawQueueBuilder,
+ *        which queues the visible ones for rendering.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cstdint>
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\RenderQueue.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief A leaf that draws one mesh with one program and material.
+ * 
+ * Programs, materials and meshes are named by the ids the renderer submitting
+ * the RenderQueue understands. Nodes in a blended layer are drawn back to
+ * front after sorting by layer; all others are grouped by state.
+ */
+class DrawableNode: public Node
+{
+public:
+    unsigned layer;
+    bool blended;
+    uint32_t program, material, mesh;
+    /// Passed through to DrawItem::userData
+    uint32_t userData;
+
+    DrawableNode(uint32_t program, uint32_t material, uint32_t mesh, unsigned layer = 0)
+        : layer(layer), blended(false), program(program), material(material), mesh(mesh),
+          userData(0) {}
+}; // class DrawableNode
+
+/**
+ * @brief Fills a RenderQueue with the drawables a culling traversal reaches.
+ * 
+ * Use with Scene::visitVisible(). Depth is the distance of each node's world
+ * bounds center along the view direction, quantized between the near and
+ * far clip distances.
+ */
+class DrawQueueBuilder
+{
+    RenderQueue& queue;
+    math::Vector3f eye, forward;
+    float nearClip, farClip;
+
+    DrawQueueBuilder& operator=(const DrawQueueBuilder&);
+
+public:
+    /// @param forward The unit view direction
+    DrawQueueBuilder(RenderQueue& queue, const math::Vector3f& eye, const math::Vector3f& forward,
+                     float nearClip, float farClip)
+        : queue(queue), eye(eye), forward(forward), nearClip(nearClip), farClip(farClip) {}
+
+    /// Queues @a node if it is a DrawableNode or derives from one
+    template <typename N>
+    void visit(N& node) { add(&node); }
+
+    /// Makes the item that queues @a node, referring to its world transform
+    DrawItem makeItem(const DrawableNode& node) const {
+        const float depth = forward.dot(node.getWorldBounds().getCenter() - eye);
+        const uint32_t quantized = DrawKey::quantizeDepth(depth, nearClip, farClip);
+
+        DrawItem item;
+        item.key = node.blended
+            ? DrawKey::blended(node.layer, quantized, node.program, node.material)
+            : DrawKey::opaque(node.layer, node.program, node.material, quantized);
+        item.program = node.program;
+        item.material = node.material;
+        item.mesh = node.mesh;
+        item.userData = node.userData;
+        item.transform = &node.getWorldTransform();
+        return item;
+    }
+
+private:
+    void add(Node*) {}
+    void add(DrawableNode* node) { queue.push(makeItem(*node)); }
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // DrawableNode_H__
@@ -0,0 +1,55 @@
+#ifndef EntityComponents_H__
+#define EntityComponents_H__
+/**
+ * @file
+ * @brief Defines the standard entity components and the passes that stream
+ *        through them.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <vector>
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiGraphics\EntityStore.h"
+
+namespace flexi {
+namespace graphics {
+
+/// Places an entity in the world
+struct EntityTransform
+{
+    math::Matrix4x3 world;
+};
+
+/// An entity's bounds in its own space, and in the world as of the last refresh
+struct EntityBounds
+{
+    math::BoundingBox local;
+    math::BoundingBox world;
+};
+
+/// Recomputes the world bounds of every entity with a transform and bounds
+inline void refreshEntityBounds(EntityStore& store) {
+    store.each<EntityTransform, EntityBounds>(
+        [](size_t count, const Entity*, EntityTransform* transforms, EntityBounds* bounds) {
+            for (size_t i = 0; i < count; ++i)
+                bounds[i].world = bounds[i].local.transformed(transforms[i].world);
+        });
+}
+
+/// Appends to @a visible every entity whose world bounds intersect @a frustum
+inline void cullEntities(EntityStore& store, const math::Frustum& frustum,
+                         std::vector<Entity>& visible)
+{
+    store.each<EntityBounds>(
+        [&](size_t count, const Entity* entities, EntityBounds* bounds) {
+            for (size_t i = 0; i < count; ++i)
+                if (frustum.intersects(bounds[i].world))
+                    visible.push_back(entities[i]);
+        });
+}
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // EntityComponents_H__
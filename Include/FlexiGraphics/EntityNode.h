@@ -0,0 +1,46 @@
+#ifndef EntityNode_H__
+#define EntityNode_H__
+/**
+ * @file
+ * @brief Defines EntityNode, which ties an entity to a place in the scene
+ *        graph.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\EntityComponents.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief A leaf standing for an entity in an EntityStore.
+ * 
+ * Most entities are flat and never need a node. An EntityNode is for the
+ * ones that hang off the hierarchy: whenever the Scene recomputes the node's
+ * world transform it also writes it to the entity's EntityTransform, if the
+ * entity has one, so the entity's own passes see it in place.
+ */
+class EntityNode: public Node
+{
+    EntityStore* store;
+    Entity entity;
+
+public:
+    EntityNode(EntityStore& store, Entity entity) : store(&store), entity(entity) {}
+
+    EntityStore& getStore() const { return *store; }
+    Entity getEntity() const { return entity; }
+
+    /// Copies this node's world transform to its entity
+    void syncEntity() const {
+        if (EntityTransform* transform = store->get<EntityTransform>(entity))
+            transform->world = worldTransform;
+    }
+}; // class EntityNode
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // EntityNode_H__
@@ -0,0 +1,381 @@
+#ifndef EntityStore_H__
+#define EntityStore_H__
+/**
+ * @file
+ * @brief Defines EntityStore, which keeps entities' components in
+ *        structure-of-arrays tables grouped by archetype.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cstring>
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiGraphics\NodeHandle.h"
+
+namespace flexi {
+namespace graphics {
+
+/// Entities are referred to with the same generational handles as NodeStore nodes
+typedef NodeHandle Entity;
+
+/// One bit per component type
+typedef unsigned long long ComponentMask;
+
+namespace internal {
+
+inline unsigned nextComponentId() {
+    static unsigned next = 0;
+    flexiAssertM(next < 64, "Too many component types for a ComponentMask");
+    return next++;
+}
+
+} // namespace internal
+
+/// Gets the small integer identifying component type @a T
+template <typename T>
+unsigned componentId() {
+    static const unsigned id = internal::nextComponentId();
+    return id;
+}
+
+template <typename T>
+ComponentMask componentMask() {
+    return ComponentMask(1) << componentId<T>();
+}
+
+/**
+ * @brief Stores entities as rows of archetype tables, where an archetype is
+ *  one exact set of component types.
+ * 
+ * Each archetype keeps one contiguous array per component type plus an array
+ * of the entities in its rows, so a query visits each matching archetype as a
+ * single contiguous chunk of every component it asks for:
+ * 
+ *     store.each<Transform, Bounds>([](size_t count, const Entity* entities,
+ *                                      Transform* transforms, Bounds* bounds) {
+ *         for (size_t i = 0; i < count; ++i) ...
+ *     });
+ * 
+ * Components are copied around with memcpy when entities change archetype or
+ * rows are compacted, so component types must be trivially copyable, and
+ * pointers into component arrays are only good until the next structural
+ * change (create, destroy, add, remove). Queries must not make structural
+ * changes.
+ * 
+ * Entity handles are generational: get() and isValid() detect handles to
+ * destroyed entities.
+ */
+class EntityStore
+{
+    EntityStore(const EntityStore&);
+    EntityStore& operator=(const EntityStore&);
+
+public:
+    EntityStore() : freeHead(NO_SLOT), freeCount(0), entityCount(0) {
+        archetypes.push_back(new Archetype(0));
+    }
+
+    ~EntityStore() {
+        for (std::vector<Archetype*>::iterator it = archetypes.begin(); it != archetypes.end(); ++it)
+            delete *it;
+    }
+
+    /// Creates an entity with no components
+    Entity create() {
+        uint32_t slot;
+        if (freeCount != 0) {
+            slot = freeHead;
+            freeHead = locations[slot].row;
+            --freeCount;
+        } else {
+            slot = uint32_t(locations.size());
+            flexiAssertM(slot < NodeHandle::INDEX_MASK, "EntityStore is full");
+            locations.push_back(Location());
+            locations.back().generation = 1;
+        }
+
+        Location& location = locations[slot];
+        const Entity entity(slot, location.generation);
+        location.archetype = 0;
+        location.row = archetypes[0]->append(entity);
+        ++entityCount;
+        return entity;
+    }
+
+    /// Destroys @a entity and its components; stale handles are ignored
+    void destroy(Entity entity) {
+        if (!isValid(entity))
+            return;
+
+        Location& location = locations[entity.getIndex()];
+        eraseRow(location.archetype, location.row);
+
+        location.generation = location.generation == NodeHandle::MAX_GENERATION
+                            ? 1 : location.generation + 1;
+        location.archetype = NO_ARCHETYPE;
+        location.row = freeHead;
+        freeHead = entity.getIndex();
+        ++freeCount;
+        --entityCount;
+    }
+
+    bool isValid(Entity entity) const {
+        const uint32_t slot = entity.getIndex();
+        return !entity.isNull()
+            && slot < locations.size()
+            && locations[slot].archetype != NO_ARCHETYPE
+            && locations[slot].generation == entity.getGeneration();
+    }
+
+    /// Number of live entities
+    size_t size() const { return entityCount; }
+
+    /// Number of archetypes created so far, including the empty one
+    size_t getArchetypeCount() const { return archetypes.size(); }
+
+    /// Gets @a entity's component mask, or 0 for a stale handle
+    ComponentMask getMask(Entity entity) const {
+        return isValid(entity) ? archetypes[locations[entity.getIndex()].archetype]->mask : 0;
+    }
+
+    template <typename T>
+    bool has(Entity entity) const {
+        return (getMask(entity) & componentMask<T>()) != 0;
+    }
+
+    /// Gets @a entity's @a T component, or null if it has none or is stale
+    template <typename T>
+    T* get(Entity entity) {
+        if (!isValid(entity))
+            return 0;
+        const Location& location = locations[entity.getIndex()];
+        Archetype& archetype = *archetypes[location.archetype];
+        const int column = archetype.findColumn(componentId<T>());
+        return column < 0 ? 0 : archetype.at<T>(column, location.row);
+    }
+
+    /// Gives @a entity a @a T component, or overwrites the one it has
+    template <typename T>
+    T& add(Entity entity, const T& value = T()) {
+        flexiAssert(isValid(entity));
+        Location& location = locations[entity.getIndex()];
+
+        if (!(archetypes[location.archetype]->mask & componentMask<T>())) {
+            const uint32_t target = findArchetypeAdding(location.archetype, componentId<T>(), sizeof(T));
+            moveRow(entity, target);
+        }
+
+        T& component = *get<T>(entity);
+        component = value;
+        return component;
+    }
+
+    /// Takes @a entity's @a T component away, if it has one
+    template <typename T>
+    void remove(Entity entity) {
+        if (!has<T>(entity))
+            return;
+        const Location& location = locations[entity.getIndex()];
+        moveRow(entity, findArchetypeRemoving(location.archetype, componentId<T>()));
+    }
+
+    /**
+     * @brief Calls @a fn(count, entities, a) once for each non-empty archetype
+     *  with an @a A component, with that archetype's contiguous arrays.
+     */
+    template <typename A, typename Fn>
+    void each(Fn fn) {
+        const ComponentMask mask = componentMask<A>();
+        for (std::vector<Archetype*>::iterator it = archetypes.begin(); it != archetypes.end(); ++it) {
+            Archetype& archetype = **it;
+            if ((archetype.mask & mask) == mask && !archetype.entities.empty()) {
+                fn(archetype.entities.size(), &archetype.entities[0],
+                   archetype.column<A>());
+            }
+        }
+    }
+
+    /// As each<A>(), for archetypes with both @a A and @a B components
+    template <typename A, typename B, typename Fn>
+    void each(Fn fn) {
+        const ComponentMask mask = componentMask<A>() | componentMask<B>();
+        for (std::vector<Archetype*>::iterator it = archetypes.begin(); it != archetypes.end(); ++it) {
+            Archetype& archetype = **it;
+            if ((archetype.mask & mask) == mask && !archetype.entities.empty()) {
+                fn(archetype.entities.size(), &archetype.entities[0],
+                   archetype.column<A>(), archetype.column<B>());
+            }
+        }
+    }
+
+    /// As each<A>(), for archetypes with @a A, @a B and @a C components
+    template <typename A, typename B, typename C, typename Fn>
+    void each(Fn fn) {
+        const ComponentMask mask = componentMask<A>() | componentMask<B>() | componentMask<C>();
+        for (std::vector<Archetype*>::iterator it = archetypes.begin(); it != archetypes.end(); ++it) {
+            Archetype& archetype = **it;
+            if ((archetype.mask & mask) == mask && !archetype.entities.empty()) {
+                fn(archetype.entities.size(), &archetype.entities[0],
+                   archetype.column<A>(), archetype.column<B>(),
+                   archetype.column<C>());
+            }
+        }
+    }
+
+private:
+    static const uint32_t NO_SLOT = NodeHandle::INDEX_MASK;
+    static const uint32_t NO_ARCHETYPE = ~0u;
+
+    /// Where an entity's row lives; for free slots, row links the free list
+    struct Location
+    {
+        uint32_t archetype;
+        uint32_t row;
+        uint32_t generation;
+
+        Location() : archetype(NO_ARCHETYPE), row(0), generation(0) {}
+    };
+
+    /// One table: a column per component type, sorted by component id
+    struct Archetype
+    {
+        ComponentMask mask;
+        std::vector<unsigned> ids;
+        std::vector<size_t> sizes;
+        std::vector<std::vector<char> > columns;
+        std::vector<Entity> entities;
+
+        explicit Archetype(ComponentMask mask) : mask(mask) {}
+
+        int findColumn(unsigned id) const {
+            for (size_t i = 0; i < ids.size(); ++i)
+                if (ids[i] == id)
+                    return int(i);
+            return -1;
+        }
+
+        template <typename T>
+        T* at(int column, uint32_t row) {
+            return reinterpret_cast<T*>(&columns[column][0] + row * sizeof(T));
+        }
+
+        template <typename T>
+        T* column() {
+            return reinterpret_cast<T*>(&columns[findColumn(componentId<T>())][0]);
+        }
+
+        /// Adds an uninitialized row for @a entity and returns its index
+        uint32_t append(Entity entity) {
+            for (size_t i = 0; i < columns.size(); ++i)
+                columns[i].resize(columns[i].size() + sizes[i]);
+            entities.push_back(entity);
+            return uint32_t(entities.size() - 1);
+        }
+    };
+
+    uint32_t findArchetype(ComponentMask mask) const {
+        for (size_t i = 0; i < archetypes.size(); ++i)
+            if (archetypes[i]->mask == mask)
+                return uint32_t(i);
+        return NO_ARCHETYPE;
+    }
+
+    uint32_t findArchetypeAdding(uint32_t from, unsigned id, size_t size) {
+        const Archetype& source = *archetypes[from];
+        const ComponentMask mask = source.mask | (ComponentMask(1) << id);
+        uint32_t found = findArchetype(mask);
+        if (found != NO_ARCHETYPE)
+            return found;
+
+        Archetype* archetype = new Archetype(mask);
+        size_t i = 0;
+        for (; i < source.ids.size() && source.ids[i] < id; ++i) {
+            archetype->ids.push_back(source.ids[i]);
+            archetype->sizes.push_back(source.sizes[i]);
+        }
+        archetype->ids.push_back(id);
+        archetype->sizes.push_back(size);
+        for (; i < source.ids.size(); ++i) {
+            archetype->ids.push_back(source.ids[i]);
+            archetype->sizes.push_back(source.sizes[i]);
+        }
+        archetype->columns.resize(archetype->ids.size());
+
+        archetypes.push_back(archetype);
+        return uint32_t(archetypes.size() - 1);
+    }
+
+    uint32_t findArchetypeRemoving(uint32_t from, unsigned id) {
+        const Archetype& source = *archetypes[from];
+        const ComponentMask mask = source.mask & ~(ComponentMask(1) << id);
+        uint32_t found = findArchetype(mask);
+        if (found != NO_ARCHETYPE)
+            return found;
+
+        Archetype* archetype = new Archetype(mask);
+        for (size_t i = 0; i < source.ids.size(); ++i) {
+            if (source.ids[i] != id) {
+                archetype->ids.push_back(source.ids[i]);
+                archetype->sizes.push_back(source.sizes[i]);
+            }
+        }
+        archetype->columns.resize(archetype->ids.size());
+
+        archetypes.push_back(archetype);
+        return uint32_t(archetypes.size() - 1);
+    }
+
+    /// Moves @a entity's row into archetype @a target, copying shared components
+    void moveRow(Entity entity, uint32_t target) {
+        Location& location = locations[entity.getIndex()];
+        Archetype& source = *archetypes[location.archetype];
+        Archetype& destination = *archetypes[target];
+
+        const uint32_t row = destination.append(entity);
+        for (size_t i = 0; i < destination.ids.size(); ++i) {
+            const int column = source.findColumn(destination.ids[i]);
+            if (column >= 0) {
+                std::memcpy(&destination.columns[i][0] + row * destination.sizes[i],
+                            &source.columns[column][0] + location.row * source.sizes[column],
+                            destination.sizes[i]);
+            }
+        }
+
+        eraseRow(location.archetype, location.row);
+        location.archetype = target;
+        location.row = row;
+    }
+
+    /// Removes a row by moving the archetype's last row into it
+    void eraseRow(uint32_t archetypeIndex, uint32_t row) {
+        Archetype& archetype = *archetypes[archetypeIndex];
+        const uint32_t last = uint32_t(archetype.entities.size() - 1);
+
+        if (row != last) {
+            for (size_t i = 0; i < archetype.columns.size(); ++i) {
+                std::memcpy(&archetype.columns[i][0] + row * archetype.sizes[i],
+                            &archetype.columns[i][0] + last * archetype.sizes[i],
+                            archetype.sizes[i]);
+            }
+            archetype.entities[row] = archetype.entities[last];
+            locations[archetype.entities[row].getIndex()].row = row;
+        }
+
+        for (size_t i = 0; i < archetype.columns.size(); ++i)
+            archetype.columns[i].resize(archetype.columns[i].size() - archetype.sizes[i]);
+        archetype.entities.pop_back();
+    }
+
+private: /******************************* Fields ******************************/
+    std::vector<Archetype*> archetypes;
+    std::vector<Location> locations;
+    uint32_t freeHead;
+    uint32_t freeCount;
+    size_t entityCount;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // EntityStore_H__
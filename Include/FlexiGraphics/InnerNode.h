@@ -5,7 +5,7 @@
  * @brief InnerNode template
  * @author   Steven Bloemer
  * @date     4/17/2011
- * @lastedit 4/17/2011
+ * @lastedit 10/19/2026
  */
 #include "FlexiUtil\DebugDefs.h"
 #include "FlexiGraphics\Node.h"
@@ -16,27 +16,61 @@ namespace graphics {
 class InnerNode: public Node
 {
     friend struct Visit;
+    friend class DestructionQueue;
+    friend class NodePool;
     Node* child;
 
 public:
     InnerNode() : child(0) {}
+
+    /// Deletes the subtree, except for pooled nodes, which are only unlinked;
+    /// their NodePool frees them
     virtual ~InnerNode() {
         Node* child = this->child;
         while (child) {
             Node* next = child->sibling;
-            delete child;
+            if (child->pooled) {
+                child->parent = 0;
+                child->sibling = child->prevSibling = 0;
+            } else {
+                delete child;
+            }
             child = next;
         }
     }
 
+    /// Links @a child under this node. A pooled node only takes pooled
+    /// children, since its NodePool frees it without deleting them.
     InnerNode& addChild(Node& child) {
-        flexiAssert(!child.sibling);
+        flexiAssert(!child.sibling && !child.prevSibling && !child.parent);
+        flexiAssertM(child.pooled || !pooled, "Unpooled node added under a pooled one");
 
         child.sibling = this->child;
+        child.parent = this;
+        if (this->child)
+            this->child->prevSibling = &child;
         this->child = &child;
 
         return *this;
     }
+
+    /// Unlinks @a child (and its subtree) from this node in constant time
+    InnerNode& removeChild(Node& child) {
+        flexiAssert(child.parent == this);
+
+        if (child.prevSibling)
+            child.prevSibling->sibling = child.sibling;
+        else
+            this->child = child.sibling;
+        if (child.sibling)
+            child.sibling->prevSibling = child.prevSibling;
+
+        child.sibling = 0;
+        child.prevSibling = 0;
+        child.parent = 0;
+
+        return *this;
+    }
 }; // class InnerNode
 
 } // namespace graphics
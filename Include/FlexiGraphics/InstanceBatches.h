@@ -0,0 +1,75 @@
+#ifndef InstanceBatches_H__
+#define InstanceBatches_H__
+/**
+ * @file
+ * @brief Defines InstanceBatches, a visitor that groups visible instances by
+ *        prototype for batched drawing.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <map>
+#include <vector>
+#include "FlexiGraphics\InstanceNode.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Collects the world transforms of the instances it visits, grouped by
+ *  prototype, so a renderer can set up each prototype's content once and draw
+ *  it for every transform in its batch.
+ * 
+ * Meant for Scene::visitVisible(), which does not descend into prototypes;
+ * instances nested inside a prototype are part of that prototype's content.
+ * Batches persist across clear() so their storage is reused from frame to
+ * frame; batches with no transforms should be skipped.
+ */
+class InstanceBatches
+{
+public:
+    struct Batch
+    {
+        const Scene* prototype;
+        std::vector<math::Matrix4x3> transforms;
+    };
+
+    InstanceBatches() : instanceCount(0) {}
+
+    void visit(Node&) {}
+    void visit(InstanceNode& instance) {
+        add(instance.getPrototype(), instance.getWorldTransform());
+    }
+
+    /// Adds an instance of @a prototype placed at @a transform
+    void add(const Scene& prototype, const math::Matrix4x3& transform) {
+        std::map<const Scene*, size_t>::const_iterator found = batchIndex.find(&prototype);
+        if (found == batchIndex.end()) {
+            found = batchIndex.insert(std::make_pair(&prototype, batches.size())).first;
+            batches.push_back(Batch());
+            batches.back().prototype = &prototype;
+        }
+        batches[found->second].transforms.push_back(transform);
+        ++instanceCount;
+    }
+
+    /// Empties every batch, keeping the batches themselves for reuse
+    void clear() {
+        for (std::vector<Batch>::iterator it = batches.begin(); it != batches.end(); ++it)
+            it->transforms.clear();
+        instanceCount = 0;
+    }
+
+    const std::vector<Batch>& getBatches() const { return batches; }
+    unsigned getInstanceCount() const { return instanceCount; }
+
+private:
+    std::vector<Batch> batches;
+    std::map<const Scene*, size_t> batchIndex;
+    unsigned instanceCount;
+}; // class InstanceBatches
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // InstanceBatches_H__
@@ -0,0 +1,70 @@
+#ifndef InstanceNode_H__
+#define InstanceNode_H__
+/**
+ * @file
+ * @brief Defines InstanceNode, which places a shared subtree in the scene
+ *        without copying it.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <memory>
+#include "FlexiGraphics\Node.h"
+
+namespace flexi {
+namespace graphics {
+
+class Scene;
+
+/**
+ * @brief A leaf that stands for a whole prototype Scene, placed with the
+ *  instance's own transform.
+ * 
+ * Any number of instances may share one prototype, so repeated content is
+ * stored once. The prototype's nodes have transforms and bounds in prototype
+ * space; the instance's world transform maps prototype space into the world,
+ * and its bounds are the prototype's bounds carried along.
+ * 
+ * Ordinary traversals treat an instance as a leaf. Scene::visitVisibleInstances()
+ * descends into prototypes, passing each visitor the InstanceContext it was
+ * reached through.
+ */
+class InstanceNode: public Node
+{
+    friend class Scene;
+    std::shared_ptr<Scene> prototype;
+
+public:
+    explicit InstanceNode(const std::shared_ptr<Scene>& prototype)
+        : prototype(prototype) {}
+
+    Scene& getPrototype() const { return *prototype; }
+}; // class InstanceNode
+
+/**
+ * @brief Describes the chain of instances a traversal went through to reach a
+ *  node inside a prototype.
+ */
+struct InstanceContext
+{
+    /// The context the instance itself was reached through, or null
+    const InstanceContext* outer;
+    const InstanceNode* instance;
+    /// Maps the prototype's world space into the scene's world space
+    math::Matrix4x3 transform;
+
+    /// Gets the world transform of @a node, a node of the prototype
+    math::Matrix4x3 getWorldTransform(const Node& node) const {
+        return node.getWorldTransform() * transform;
+    }
+
+    /// Gets the world bounds of @a node, a node of the prototype
+    math::BoundingBox getWorldBounds(const Node& node) const {
+        return node.getWorldBounds().transformed(transform);
+    }
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // InstanceNode_H__
@@ -0,0 +1,176 @@
+#ifndef LodNode_H__
+#define LodNode_H__
+/**
+ * @file
+ * @brief Defines LodNode, a drawable with several levels of detail, and
+ *        LodSelector, which picks their levels from screen-space error.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiGraphics\DrawableNode.h"
+
+namespace flexi {
+namespace graphics {
+
+/// One level of detail of a LodNode
+struct LodLevel
+{
+    uint32_t mesh;
+    /// How far, in object units, this level's surface may stray from the
+    /// full-detail surface
+    float geometricError;
+    unsigned triangleCount;
+};
+
+/**
+ * @brief A DrawableNode whose mesh is one of several levels of detail.
+ * 
+ * Levels run from finest (0) to coarsest, with non-decreasing geometric
+ * errors. The node draws the current level's mesh; LodSelector changes the
+ * level as the camera moves.
+ */
+class LodNode: public DrawableNode
+{
+    std::vector<LodLevel> levels;
+    unsigned level;
+
+public:
+    LodNode(uint32_t program, uint32_t material, const LodLevel* levels, unsigned levelCount,
+            unsigned layer = 0)
+        : DrawableNode(program, material, levels[0].mesh, layer),
+          levels(levels, levels + levelCount), level(0)
+    {
+        flexiAssert(levelCount > 0);
+    }
+
+    unsigned getLevelCount() const { return unsigned(levels.size()); }
+    const LodLevel& getLevel(unsigned index) const { return levels[index]; }
+
+    unsigned getCurrentLevel() const { return level; }
+    void setCurrentLevel(unsigned index) {
+        flexiAssert(index < levels.size());
+        level = index;
+        mesh = levels[index].mesh;
+    }
+}; // class LodNode
+
+/**
+ * @brief Picks the level of detail of every visible LodNode from how large
+ *  its geometric error would appear on screen.
+ * 
+ * Use as the visitor of Scene::visitVisible() to collect the visible nodes,
+ * then call select() to update them all in one pass. A level's error in
+ * pixels is its geometric error, scaled into world units by the node's world
+ * transform, times the camera's pixelsPerUnit() over the distance from the
+ * eye to the nearest point of the node's bounding sphere.
+ * Each node gets the coarsest level whose error is within maxPixelError.
+ * 
+ * To keep objects near the threshold from flickering between levels, a node
+ * only coarsens once the new level is under the threshold by the hysteresis
+ * fraction, and only refines once its current level is over it by the same
+ * fraction.
+ */
+class LodSelector
+{
+public:
+    struct Stats
+    {
+        unsigned nodes, levelChanges;
+        /// Triangles drawn at the selected levels, and at full detail
+        unsigned long long triangles, fullDetailTriangles;
+
+        Stats() : nodes(0), levelChanges(0), triangles(0), fullDetailTriangles(0) {}
+    };
+
+    /**
+     * @param eye The camera position in world space.
+     * @param pixelsPerUnit The camera's Camera::pixelsPerUnit().
+     */
+    LodSelector(const math::Vector3f& eye, float pixelsPerUnit, float maxPixelError = 1.0f,
+                float hysteresis = 0.25f)
+        : eye(eye), unitsPerPixel(maxPixelError / pixelsPerUnit), hysteresis(hysteresis) {}
+
+    /// Collects @a node if it is a LodNode
+    template <typename N>
+    void visit(N& node) { add(&node); }
+
+    /// Selects the levels of the nodes collected since the last select()
+    void select() {
+        stats = Stats();
+        for (size_t i = 0; i < nodes.size(); ++i)
+            selectLevel(*nodes[i]);
+        stats.nodes = unsigned(nodes.size());
+        nodes.clear();
+    }
+
+    /// Gets the results of the last select()
+    const Stats& getStats() const { return stats; }
+
+private:
+    void add(Node*) {}
+    void add(LodNode* node) { nodes.push_back(node); }
+
+    void selectLevel(LodNode& node) {
+        // Distance from the eye to the node's bounding sphere
+        const math::BoundingBox& bounds = node.getWorldBounds();
+        const float radius = std::sqrt(sqr(bounds.max.x - bounds.min.x) + sqr(bounds.max.y - bounds.min.y)
+                                       + sqr(bounds.max.z - bounds.min.z)) * 0.5f;
+        const float distance = std::sqrt(sqr((bounds.min.x + bounds.max.x) * 0.5f - eye.x)
+                                         + sqr((bounds.min.y + bounds.max.y) * 0.5f - eye.y)
+                                         + sqr((bounds.min.z + bounds.max.z) * 0.5f - eye.z)) - radius;
+
+        // The geometric error, in object units, that would project to exactly
+        // the threshold; inside the sphere everything must be full detail
+        const float scale = getWorldScale(node.getWorldTransform());
+        const float allowed = distance > 0 ? distance * unitsPerPixel / scale : 0;
+
+        const unsigned current = node.getCurrentLevel();
+        unsigned target = node.getLevelCount() - 1;
+        while (target > 0 && node.getLevel(target).geometricError > allowed)
+            --target;
+
+        if (target > current) {
+            while (target > current && node.getLevel(target).geometricError > allowed * (1 - hysteresis))
+                --target;
+        } else if (target < current && node.getLevel(current).geometricError <= allowed * (1 + hysteresis)) {
+            target = current;
+        }
+
+        if (target != current) {
+            node.setCurrentLevel(target);
+            ++stats.levelChanges;
+        }
+        stats.triangles += node.getLevel(target).triangleCount;
+        stats.fullDetailTriangles += node.getLevel(0).triangleCount;
+    }
+
+    static float sqr(float f) { return f * f; }
+
+    /// The largest factor by which @a transform stretches an object-space
+    /// length, so that errors are never underestimated
+    static float getWorldScale(const math::Matrix4x3& transform) {
+        const math::Vector3f origin = math::Vector3f::ZERO * transform;
+        const float x = (math::Vector3f(1, 0, 0) * transform - origin).lenSquared();
+        const float y = (math::Vector3f(0, 1, 0) * transform - origin).lenSquared();
+        const float z = (math::Vector3f(0, 0, 1) * transform - origin).lenSquared();
+        return std::sqrt(std::max(x, std::max(y, z)));
+    }
+
+private: /******************************* Fields ******************************/
+    math::Vector3f eye;
+    float unitsPerPixel;
+    float hysteresis;
+    std::vector<LodNode*> nodes;
+    Stats stats;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // LodNode_H__
@@ -0,0 +1,405 @@
+#ifndef LooseOctree_H__
+#define LooseOctree_H__
+/**
+ * @file
+ * @brief Defines LooseOctree, a spatial index for moving objects.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cstdint>
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiMath\FlexiMath.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Indexes object bounds in an octree whose cells overlap their
+ *  neighbours, for proximity, overlap, frustum and ray queries.
+ * 
+ * Each cell's loose bounds are twice the size of the cell. An object is
+ * stored in the deepest cell whose loose bounds are guaranteed to hold it,
+ * which is found from the object's size and the cell its center falls in
+ * alone, so inserting, moving and removing an object never need to look at
+ * other objects. The work is bounded by the maximum depth, and a move that
+ * stays in its cell only stores the new bounds.
+ * 
+ * Objects are identified by the ids insert() returns; ids of removed objects
+ * are reused. Objects whose center lies outside the world bounds given at
+ * construction are kept at the root and tested by every query.
+ * 
+ * Cells are created on demand and are not freed when they empty; rebuild()
+ * refits the world to the current objects and rebuilds the cells from scratch.
+ */
+class LooseOctree
+{
+public:
+    typedef unsigned ObjectId;
+
+    LooseOctree(const math::BoundingBox& world, unsigned maxDepth = 8)
+        : maxDepth(maxDepth), freeHead(NONE), objectCount(0)
+    {
+        reset(world);
+    }
+
+    size_t size() const { return objectCount; }
+    size_t getCellCount() const { return cells.size(); }
+
+    const math::BoundingBox& getBounds(ObjectId id) const { return objects[id].bounds; }
+
+    /// Adds an object with the given bounds and returns its id
+    ObjectId insert(const math::BoundingBox& bounds) {
+        ObjectId id;
+        if (freeHead != NONE) {
+            id = freeHead;
+            freeHead = objects[id].next;
+        } else {
+            id = ObjectId(objects.size());
+            objects.push_back(Object());
+        }
+        objects[id].bounds = bounds;
+        link(id, findCell(bounds));
+        ++objectCount;
+        return id;
+    }
+
+    /// Changes the bounds of object @a id
+    void move(ObjectId id, const math::BoundingBox& bounds) {
+        Object& object = objects[id];
+        const uint32_t cell = findCell(bounds);
+        object.bounds = bounds;
+        if (cell != object.cell) {
+            unlink(id);
+            link(id, cell);
+        }
+    }
+
+    /// Removes object @a id, freeing the id for a later insert. Removing an
+    /// id that is already free does nothing.
+    void remove(ObjectId id) {
+        flexiAssert(id < objects.size() && objects[id].cell != NONE);
+        if (objects[id].cell == NONE)
+            return;
+        unlink(id);
+        objects[id].cell = NONE;
+        objects[id].next = freeHead;
+        freeHead = id;
+        --objectCount;
+    }
+
+    /**
+     * @brief Rebuilds the tree over the current objects, with world bounds
+     *  fitted to their centers.
+     * 
+     * Drops empty cells and lays cells out in depth-first order. Object ids
+     * are unchanged.
+     */
+    void rebuild() {
+        math::BoundingBox world;
+        for (ObjectId id = 0; id < objects.size(); ++id)
+            if (objects[id].cell != NONE)
+                world.extend(objects[id].bounds.getCenter());
+        if (world.isEmpty())
+            world = math::BoundingBox(math::Vector3f(-1, -1, -1), math::Vector3f(1, 1, 1));
+
+        std::vector<ObjectId> live;
+        live.reserve(objectCount);
+        for (ObjectId id = 0; id < objects.size(); ++id)
+            if (objects[id].cell != NONE)
+                live.push_back(id);
+
+        reset(world);
+        for (size_t i = 0; i < live.size(); ++i)
+            link(live[i], findCell(objects[live[i]].bounds));
+        compactCells();
+    }
+
+    /// Appends the ids of objects whose bounds intersect @a box
+    void queryBox(const math::BoundingBox& box, std::vector<ObjectId>& results) const {
+        collect(0, BoxTest(box), results);
+    }
+
+    /// Appends the ids of objects whose bounds come within @a radius of @a center
+    void querySphere(const math::Vector3f& center, float radius,
+                     std::vector<ObjectId>& results) const
+    {
+        collect(0, SphereTest(center, radius), results);
+    }
+
+    /// Appends the ids of objects whose bounds intersect @a frustum
+    void queryFrustum(const math::Frustum& frustum, std::vector<ObjectId>& results) const {
+        collect(0, FrustumTest(frustum), results);
+    }
+
+    /**
+     * @brief Appends the ids of objects whose bounds are hit by the segment
+     *  from @a origin along the unit vector @a direction for @a maxDistance.
+     */
+    void queryRay(const math::Vector3f& origin, const math::Vector3f& direction,
+                  float maxDistance, std::vector<ObjectId>& results) const
+    {
+        collect(0, RayTest(origin, direction, maxDistance), results);
+    }
+
+private:
+    static const uint32_t NONE = ~0u;
+
+    struct Object
+    {
+        math::BoundingBox bounds;
+        uint32_t cell;
+        uint32_t prev;
+        uint32_t next;   ///< Or the next free id, for removed objects
+
+        Object() : cell(NONE), prev(NONE), next(NONE) {}
+    };
+
+    struct Cell
+    {
+        math::Vector3f center;
+        float halfSize;
+        math::BoundingBox loose;
+        uint32_t parent;
+        uint32_t children[8];
+        uint32_t firstObject;
+        uint32_t subtreeCount;
+
+        Cell(const math::Vector3f& center, float halfSize, uint32_t parent)
+            : center(center), halfSize(halfSize), parent(parent),
+              firstObject(NONE), subtreeCount(0)
+        {
+            const float looseHalf = 2 * halfSize;
+            loose = math::BoundingBox(
+                math::Vector3f(center.x - looseHalf, center.y - looseHalf, center.z - looseHalf),
+                math::Vector3f(center.x + looseHalf, center.y + looseHalf, center.z + looseHalf));
+            for (unsigned i = 0; i < 8; ++i)
+                children[i] = NONE;
+        }
+    };
+
+    void reset(const math::BoundingBox& world) {
+        const math::Vector3f extents = world.getExtents();
+        float halfSize = extents.x;
+        if (extents.y > halfSize) halfSize = extents.y;
+        if (extents.z > halfSize) halfSize = extents.z;
+
+        this->world = world;
+        cells.clear();
+        cells.push_back(Cell(world.getCenter(), halfSize > 0 ? halfSize : 1.0f, NONE));
+    }
+
+    /// Finds (creating as needed) the deepest cell that holds @a bounds
+    uint32_t findCell(const math::BoundingBox& bounds) {
+        const math::Vector3f center = bounds.getCenter();
+        if (!world.contains(center))
+            return 0;
+
+        const math::Vector3f extents = bounds.getExtents();
+        float extent = extents.x;
+        if (extents.y > extent) extent = extents.y;
+        if (extents.z > extent) extent = extents.z;
+
+        uint32_t cell = 0;
+        for (unsigned depth = 0; depth < maxDepth; ++depth) {
+            const float childHalf = cells[cell].halfSize * 0.5f;
+            // A child's loose bounds reach childHalf beyond the child cell, so
+            // they hold any object centered in it that is no larger than that
+            if (extent > childHalf)
+                break;
+
+            const math::Vector3f& c = cells[cell].center;
+            const unsigned octant = (center.x >= c.x ? 1 : 0)
+                                  | (center.y >= c.y ? 2 : 0)
+                                  | (center.z >= c.z ? 4 : 0);
+            uint32_t child = cells[cell].children[octant];
+            if (child == NONE) {
+                const math::Vector3f childCenter(c.x + (octant & 1 ? childHalf : -childHalf),
+                                                 c.y + (octant & 2 ? childHalf : -childHalf),
+                                                 c.z + (octant & 4 ? childHalf : -childHalf));
+                child = uint32_t(cells.size());
+                cells.push_back(Cell(childCenter, childHalf, cell));
+                cells[cell].children[octant] = child;
+            }
+            cell = child;
+        }
+        return cell;
+    }
+
+    void link(ObjectId id, uint32_t cell) {
+        Object& object = objects[id];
+        object.cell = cell;
+        object.prev = NONE;
+        object.next = cells[cell].firstObject;
+        if (object.next != NONE)
+            objects[object.next].prev = id;
+        cells[cell].firstObject = id;
+
+        for (uint32_t c = cell; c != NONE; c = cells[c].parent)
+            ++cells[c].subtreeCount;
+    }
+
+    void unlink(ObjectId id) {
+        Object& object = objects[id];
+        if (object.prev != NONE)
+            objects[object.prev].next = object.next;
+        else
+            cells[object.cell].firstObject = object.next;
+        if (object.next != NONE)
+            objects[object.next].prev = object.prev;
+
+        for (uint32_t c = object.cell; c != NONE; c = cells[c].parent)
+            --cells[c].subtreeCount;
+    }
+
+    /// Drops empty cells and renumbers the rest in depth-first order
+    void compactCells() {
+        std::vector<Cell> compacted;
+        compacted.reserve(cells.size());
+        std::vector<uint32_t> newIndex(cells.size(), uint32_t(NONE));
+
+        std::vector<uint32_t> pending(1, 0);
+        while (!pending.empty()) {
+            const uint32_t cell = pending.back();
+            pending.pop_back();
+            newIndex[cell] = uint32_t(compacted.size());
+            compacted.push_back(cells[cell]);
+            for (int i = 7; i >= 0; --i) {
+                const uint32_t child = cells[cell].children[i];
+                if (child != NONE && cells[child].subtreeCount)
+                    pending.push_back(child);
+            }
+        }
+
+        for (size_t i = 0; i < compacted.size(); ++i) {
+            Cell& cell = compacted[i];
+            if (cell.parent != NONE)
+                cell.parent = newIndex[cell.parent];
+            for (unsigned c = 0; c < 8; ++c)
+                if (cell.children[c] != NONE)
+                    cell.children[c] = newIndex[cell.children[c]];
+        }
+        for (ObjectId id = 0; id < objects.size(); ++id)
+            if (objects[id].cell != NONE)
+                objects[id].cell = newIndex[objects[id].cell];
+
+        cells.swap(compacted);
+    }
+
+    /// Tests cells and objects against a query volume; copied per level so
+    /// that tests can narrow themselves as they descend
+    struct BoxTest
+    {
+        math::BoundingBox box;
+
+        BoxTest(const math::BoundingBox& box) : box(box) {}
+
+        math::Frustum::Containment classify(const math::BoundingBox& bounds) {
+            if (!box.intersects(bounds)) return math::Frustum::OUTSIDE;
+            return box.contains(bounds) ? math::Frustum::INSIDE : math::Frustum::INTERSECTS;
+        }
+        bool test(const math::BoundingBox& bounds) const { return box.intersects(bounds); }
+    };
+
+    struct SphereTest
+    {
+        math::Vector3f center;
+        float radius;
+
+        SphereTest(const math::Vector3f& center, float radius) : center(center), radius(radius) {}
+
+        math::Frustum::Containment classify(const math::BoundingBox& bounds) {
+            if (!bounds.intersectsSphere(center, radius)) return math::Frustum::OUTSIDE;
+            return bounds.insideSphere(center, radius) ? math::Frustum::INSIDE : math::Frustum::INTERSECTS;
+        }
+        bool test(const math::BoundingBox& bounds) const { return bounds.intersectsSphere(center, radius); }
+    };
+
+    struct FrustumTest
+    {
+        const math::Frustum* frustum;
+        unsigned planeMask;
+
+        FrustumTest(const math::Frustum& frustum)
+            : frustum(&frustum), planeMask(math::Frustum::ALL_PLANES) {}
+
+        math::Frustum::Containment classify(const math::BoundingBox& bounds) {
+            return frustum->classify(bounds, planeMask);
+        }
+        bool test(const math::BoundingBox& bounds) const {
+            unsigned mask = planeMask;
+            return frustum->classify(bounds, mask) != math::Frustum::OUTSIDE;
+        }
+    };
+
+    struct RayTest
+    {
+        math::Vector3f origin, inverseDirection;
+        float maxDistance;
+
+        RayTest(const math::Vector3f& origin, const math::Vector3f& direction, float maxDistance)
+            : origin(origin),
+              inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z),
+              maxDistance(maxDistance) {}
+
+        math::Frustum::Containment classify(const math::BoundingBox& bounds) {
+            return test(bounds) ? math::Frustum::INTERSECTS : math::Frustum::OUTSIDE;
+        }
+        bool test(const math::BoundingBox& bounds) const {
+            float entry;
+            return bounds.intersectsRay(origin, inverseDirection, maxDistance, entry);
+        }
+    };
+
+    template <typename Test>
+    void collect(uint32_t index, Test test, std::vector<ObjectId>& results) const {
+        const Cell& cell = cells[index];
+        if (!cell.subtreeCount)
+            return;
+
+        // The root also holds objects outside the world, so it is never culled
+        if (index != 0) {
+            const math::Frustum::Containment containment = test.classify(cell.loose);
+            if (containment == math::Frustum::OUTSIDE)
+                return;
+            if (containment == math::Frustum::INSIDE) {
+                collectAll(index, results);
+                return;
+            }
+        }
+
+        for (uint32_t id = cell.firstObject; id != NONE; id = objects[id].next)
+            if (test.test(objects[id].bounds))
+                results.push_back(id);
+
+        for (unsigned i = 0; i < 8; ++i)
+            if (cell.children[i] != NONE)
+                collect(cell.children[i], test, results);
+    }
+
+    /// Appends every object under a cell known to be wholly inside the query
+    void collectAll(uint32_t index, std::vector<ObjectId>& results) const {
+        const Cell& cell = cells[index];
+        if (!cell.subtreeCount)
+            return;
+        for (uint32_t id = cell.firstObject; id != NONE; id = objects[id].next)
+            results.push_back(id);
+        for (unsigned i = 0; i < 8; ++i)
+            if (cell.children[i] != NONE)
+                collectAll(cell.children[i], results);
+    }
+
+private: /******************************* Fields ******************************/
+    math::BoundingBox world;
+    std::vector<Cell> cells;
+    std::vector<Object> objects;
+    unsigned maxDepth;
+    uint32_t freeHead;
+    size_t objectCount;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // LooseOctree_H__
@@ -5,25 +5,86 @@
  * @brief Node Template
  * @author   Steven Bloemer
  * @date     4/17/2011
- * @lastedit 4/17/2011
+ * @lastedit 10/19/2026
  */
+#include "FlexiMath\FlexiMath.h"
 
 namespace flexi {
 namespace graphics {
 
+class InnerNode;
+
 class Node
 {
 public:
-    Node() : sibling(0) {}
+    Node()
+        : sibling(0), prevSibling(0), parent(0),
+          transformDirty(false), boundsDirty(false), pooled(false),
+          journalGeneration(0), journalEntry(0)
+    {
+        localTransform.setIdentity();
+        worldTransform.setIdentity();
+    }
 
     virtual ~Node() {};
+
+    /// Gets the transform from this node's space into its parent's space.
+    const math::Matrix4x3& getLocalTransform() const { return localTransform; }
+
+    /**
+     * @brief Gets the transform from this node's space into world space.
+     * 
+     * Only valid as of the last call to Scene::updateTransforms(). A node
+     * whose own local transform has changed since then reports
+     * isTransformDirty() until the next update; its descendants are stale
+     * too but are not flagged, so check the ancestors as well.
+     */
+    const math::Matrix4x3& getWorldTransform() const { return worldTransform; }
+
+    /// @c true if this node's world transform is waiting on the next update.
+    bool isTransformDirty() const { return transformDirty; }
+
+    /// Gets the bounds of this node's own content, in its own space.
+    const math::BoundingBox& getLocalBounds() const { return localBounds; }
+
+    /**
+     * @brief Gets a conservative world-space box around this node's content
+     *  and that of its whole subtree.
+     * 
+     * Refitted lazily; only valid after Scene::refitBounds() (or a culling
+     * traversal through the Scene, which refits first).
+     */
+    const math::BoundingBox& getWorldBounds() const { return worldBounds; }
+
+    /// Gets the InnerNode this node was added to, or null for a root.
+    InnerNode* getParent() const { return parent; }
+
+    /// @c true if this node's memory belongs to a NodePool.
+    bool isPooled() const { return pooled; }
+
 protected:
     friend struct Visit;
     friend class InnerNode;
+    friend class Scene;
+    friend class NodePool;
+    friend class DestructionQueue;
+    friend class SceneJournal;
     Node* sibling;
+    Node* prevSibling;
+    InnerNode* parent;
+    math::Matrix4x3 localTransform;
+    math::Matrix4x3 worldTransform;
+    math::BoundingBox localBounds;
+    math::BoundingBox worldBounds;
+    bool transformDirty;
+    bool boundsDirty;
+    bool pooled;
+    /// Which SceneJournal entry holds this node's changes, if any
+    unsigned journalGeneration;
+    unsigned journalEntry;
 }; // class Node
 
 } // namespace graphics
 } // namespace flexi
 
-#endif // Node_H__
\ No newline at end of file
+#endif // Node_H__
@@ -10,6 +10,8 @@
 #include "FlexiUtil\DebugDefs.h"
 #include "FlexiGraphics\NodeTypes.h"
 
+class Leaf;
+
 class NodeBase
 {
     NodeBase& operator=(const NodeBase&);
@@ -0,0 +1,183 @@
+#ifndef NodeBuckets_H__
+#define NodeBuckets_H__
+/**
+ * @file
+ * @brief Defines NodeBuckets, which sorts nodes by type so that visitors can
+ *        process each type in one batch.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <typeinfo>
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiUtil\Span.h"
+#include "FlexiGraphics\Visit.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Gathers nodes into one bucket per node type, then hands each bucket
+ *  to a batch visitor in a single call.
+ * 
+ * Visit::node() dispatches on every node, so a traversal over mixed types keeps
+ * switching between the visitor's methods. Gathering first moves that cost
+ * into one cheap pass; dispatch() then calls, once per non-empty bucket,
+ * 
+ *     visitor.visit(util::Span<T*> nodes)
+ * 
+ * where T is the exact registered type of every node in the span, so the
+ * visitor can process each type with a tight loop. The visitor needs an
+ * overload (or a template) for every type it may receive.
+ * 
+ * Nodes can be gathered from a whole subtree with gather(), or a NodeBuckets
+ * can itself be passed as the visitor of Visit::visible() or
+ * Scene::visitVisible() to gather only visible nodes. Within a bucket, nodes
+ * keep the order in which they were gathered.
+ * 
+ * clear() keeps the buckets' storage, so one NodeBuckets can be reused every
+ * frame without reallocating.
+ */
+class NodeBuckets
+{
+    NodeBuckets(const NodeBuckets&);
+    NodeBuckets& operator=(const NodeBuckets&);
+
+public:
+    NodeBuckets() : lastBucket(0) {}
+
+    ~NodeBuckets() {
+        for (std::vector<Bucket*>::iterator it = buckets.begin(); it != buckets.end(); ++it)
+            delete *it;
+    }
+
+    /// Adds @a node to the bucket for its type, which must be its exact type,
+    /// as when called through Visit
+    template <typename N>
+    void visit(N& node) {
+        flexiAssert(typeid(node) == typeid(N));
+        bucketFor<N>().push_back(&node);
+    }
+
+    /// Adds every node of the subtree under @a root, parents before children
+    void gather(Node& root) {
+        Gatherer gatherer(*this);
+        Visit::node(root, gatherer);
+    }
+
+    /// Calls @a visitor once with the span of nodes of each gathered type
+    template <typename Visitor>
+    Visitor& dispatch(Visitor& visitor) {
+        for (std::vector<Bucket*>::iterator it = buckets.begin(); it != buckets.end(); ++it) {
+            if ((*it)->size()) {
+                BucketDispatcher<Visitor> dispatcher(visitor, **it);
+                Visit::node((*it)->front(), dispatcher);
+            }
+        }
+        return visitor;
+    }
+
+    /// Empties every bucket, keeping their storage
+    void clear() {
+        for (std::vector<Bucket*>::iterator it = buckets.begin(); it != buckets.end(); ++it)
+            (*it)->clear();
+    }
+
+    /// Gets the number of nodes gathered since the last clear()
+    size_t size() const {
+        size_t count = 0;
+        for (std::vector<Bucket*>::const_iterator it = buckets.begin(); it != buckets.end(); ++it)
+            count += (*it)->size();
+        return count;
+    }
+
+private:
+    /// The nodes of one exact type
+    struct Bucket
+    {
+        const std::type_info* type;
+
+        virtual ~Bucket() {}
+        virtual Node& front() = 0;
+        virtual size_t size() const = 0;
+        virtual void clear() = 0;
+    };
+
+    template <typename N>
+    struct TypedBucket: public Bucket
+    {
+        std::vector<N*> nodes;
+
+        virtual Node& front() { return *nodes.front(); }
+        virtual size_t size() const { return nodes.size(); }
+        virtual void clear() { nodes.clear(); }
+    };
+
+    /// Adds each node of a subtree, descending into anything that is an
+    /// InnerNode
+    struct Gatherer
+    {
+        NodeBuckets& buckets;
+
+        explicit Gatherer(NodeBuckets& buckets) : buckets(buckets) {}
+
+        template <typename N>
+        void visit(N& node) {
+            buckets.bucketFor<N>().push_back(&node);
+            descend(node);
+        }
+
+    private:
+        Gatherer& operator=(const Gatherer&);
+
+        void descend(Node&) {}
+        void descend(InnerNode& innerNode) { Visit::children(innerNode, *this); }
+    };
+
+    /// Recovers a bucket's static type from its first node
+    template <typename Visitor>
+    struct BucketDispatcher
+    {
+        Visitor& visitor;
+        Bucket& bucket;
+
+        BucketDispatcher(Visitor& visitor, Bucket& bucket)
+            : visitor(visitor), bucket(bucket) {}
+
+        template <typename N>
+        void visit(N&) {
+            flexiAssert(*bucket.type == typeid(N));
+            std::vector<N*>& nodes = static_cast<TypedBucket<N>&>(bucket).nodes;
+            visitor.visit(util::Span<N*>(&nodes[0], nodes.size()));
+        }
+
+    private:
+        BucketDispatcher& operator=(const BucketDispatcher&);
+    };
+
+    template <typename N>
+    std::vector<N*>& bucketFor() {
+        const std::type_info& type = typeid(N);
+        if (lastBucket < buckets.size() && buckets[lastBucket]->type == &type)
+            return static_cast<TypedBucket<N>*>(buckets[lastBucket])->nodes;
+
+        for (lastBucket = 0; lastBucket < buckets.size(); ++lastBucket)
+            if (buckets[lastBucket]->type == &type || *buckets[lastBucket]->type == type)
+                return static_cast<TypedBucket<N>*>(buckets[lastBucket])->nodes;
+
+        TypedBucket<N>* bucket = new TypedBucket<N>();
+        bucket->type = &type;
+        buckets.push_back(bucket);
+        return bucket->nodes;
+    }
+
+private: /******************************* Fields ******************************/
+    std::vector<Bucket*> buckets;
+    size_t lastBucket;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // NodeBuckets_H__
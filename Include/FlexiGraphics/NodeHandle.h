@@ -0,0 +1,48 @@
+#ifndef NodeHandle_H__
+#define NodeHandle_H__
+/**
+ * @file
+ * @brief Defines NodeHandle, a 32-bit generational reference to a node held
+ *        in a NodeStore.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cstdint>
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Refers to a node by slot index and the generation of that slot.
+ * 
+ * The low INDEX_BITS bits hold the slot index and the remaining bits hold the
+ * generation. A slot's generation changes every time its node is destroyed, so
+ * a handle to a destroyed node no longer matches and can be detected as stale
+ * instead of being followed. Generations are never zero, which leaves the
+ * all-zero handle free to mean "no node".
+ */
+struct NodeHandle
+{
+    static const unsigned INDEX_BITS = 24;
+    static const uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static const uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+    uint32_t id;
+
+    NodeHandle() : id(0) {}
+    NodeHandle(uint32_t index, uint32_t generation)
+        : id((generation << INDEX_BITS) | index) {}
+
+    uint32_t getIndex() const { return id & INDEX_MASK; }
+    uint32_t getGeneration() const { return id >> INDEX_BITS; }
+    bool isNull() const { return id == 0; }
+
+    bool operator==(const NodeHandle& that) const { return id == that.id; }
+    bool operator!=(const NodeHandle& that) const { return id != that.id; }
+}; // struct NodeHandle
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // NodeHandle_H__
@@ -0,0 +1,142 @@
+#ifndef NodePool_H__
+#define NodePool_H__
+/**
+ * @file
+ * @brief Defines NodePool, an arena for nodes that are freed all at once.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <new>
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\Visit.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Says whether nodes of type @a T may be created in a NodePool.
+ * 
+ * A pool frees its nodes' memory without running their destructors, so only
+ * types that own nothing beyond their links into the graph qualify. Specialize
+ * this for such a type to let pools create it.
+ */
+template <typename T>
+struct IsPoolable { enum { value = false }; };
+
+template <> struct IsPoolable<Node> { enum { value = true }; };
+template <> struct IsPoolable<InnerNode> { enum { value = true }; };
+
+/**
+ * @brief Allocates nodes out of large blocks so that a whole subtree can be
+ *  freed in one step, without a heap free per node.
+ * 
+ * Pooled nodes are never deleted individually: InnerNode and DestructionQueue
+ * unlink them instead of deleting them. release() frees the blocks without
+ * visiting any node, which is safe because pools only create IsPoolable types
+ * and pooled InnerNodes only accept pooled children, so no pooled node owns
+ * anything. destroyAll() runs each node's destructor first, for callers that
+ * want them run anyway.
+ * 
+ * Before release() or the pool's destruction, every node created from it must
+ * have been detached from any scene (e.g. with Scene::destroy()), and that
+ * scene must have been updated since, so that it no longer refers to them.
+ */
+class NodePool
+{
+    NodePool(const NodePool&);
+    NodePool& operator=(const NodePool&);
+
+public:
+    explicit NodePool(size_t blockSize = 1 << 20)
+        : blockSize(blockSize), blockUsed(blockSize), nodeCount(0) {}
+
+    ~NodePool() { release(); }
+
+    /// Creates a default-constructed node of type @a T in the pool
+    template <typename T>
+    T& create() {
+        static_assert(IsPoolable<T>::value, "Node type owns more than its links; see IsPoolable");
+        T* node = new (allocate(sizeof(T))) T();
+        node->pooled = true;
+        ++nodeCount;
+        return *node;
+    }
+
+    /// Frees every node created from this pool, without destroying them
+    void release() {
+        for (std::vector<char*>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+            delete[] *it;
+        blocks.clear();
+        blockUsed = blockSize;
+        nodeCount = 0;
+    }
+
+    /**
+     * @brief Runs the destructor of each node in the detached subtree under
+     *  @a root, then release()s the pool.
+     * 
+     * Visits every node, so it costs as much as deleting them; the subtree
+     * should hold all of the pool's nodes.
+     */
+    void destroyAll(Node& root) {
+        flexiAssert(root.pooled && !root.parent);
+        ChildSplitter splitter;
+        splitter.pending.push_back(&root);
+        while (!splitter.pending.empty()) {
+            Node* node = splitter.pending.back();
+            splitter.pending.pop_back();
+            Visit::node(*node, splitter);
+            node->~Node();
+        }
+        release();
+    }
+
+    unsigned getNodeCount() const { return nodeCount; }
+    size_t getReservedBytes() const { return blocks.size() * blockSize; }
+
+private:
+    static const size_t ALIGNMENT = 16;
+
+    /// Moves an InnerNode's children onto the stack before it is destroyed,
+    /// so that its destructor finds none
+    struct ChildSplitter
+    {
+        std::vector<Node*> pending;
+
+        void visit(Node&) {}
+        void visit(InnerNode& innerNode) {
+            for (Node* child = innerNode.child; child; child = child->sibling) {
+                flexiAssert(child->pooled);
+                pending.push_back(child);
+            }
+            innerNode.child = 0;
+        }
+    };
+
+    void* allocate(size_t size) {
+        size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        flexiAssert(size <= blockSize);
+
+        if (blockUsed + size > blockSize) {
+            blocks.push_back(new char[blockSize]);
+            blockUsed = 0;
+        }
+        void* memory = blocks.back() + blockUsed;
+        blockUsed += size;
+        return memory;
+    }
+
+private: /******************************* Fields ******************************/
+    std::vector<char*> blocks;
+    size_t blockSize;
+    size_t blockUsed;
+    unsigned nodeCount;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // NodePool_H__
@@ -0,0 +1,297 @@
+#ifndef NodeStore_H__
+#define NodeStore_H__
+/**
+ * @file
+ * @brief Defines NodeStore, a compact hierarchy of values addressed through
+ *        generational NodeHandles.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiGraphics\NodeHandle.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Stores a forest of nodes of type T in contiguous arrays and links them
+ *  with 32-bit handles rather than pointers.
+ * 
+ * Node values and their links live in parallel dense arrays. Each handle names
+ * a slot, and the slot records where in the dense arrays its node currently
+ * lives, so nodes can be moved around freely: destroy() fills the hole it
+ * leaves with the last node, and compact() reorders a tree into depth-first
+ * order so that traversing it walks memory front to back. Handles held by
+ * callers stay valid across both.
+ * 
+ * A handle to a destroyed node is stale: get() returns null for it and
+ * isValid() returns false, even if its slot has since been reused. (With 8
+ * generation bits this holds until a single slot has been reused 255 times.)
+ * 
+ * The per-node cost is three 4-byte links, a 4-byte slot and a 4-byte
+ * back-reference from the dense arrays to the slot, compared with three 8-byte
+ * pointers plus allocator overhead for a separately allocated 64-bit node.
+ */
+template <typename T>
+class NodeStore
+{
+    struct Links {
+        NodeHandle parent;
+        NodeHandle firstChild;
+        NodeHandle nextSibling;
+    };
+
+    /// Generation in the high bits, and the dense index of the node (or of the
+    /// next free slot, if this slot is free) in the low bits.
+    std::vector<uint32_t> slots;
+    std::vector<T> values;
+    std::vector<Links> links;
+    std::vector<uint32_t> slotOf;
+    uint32_t freeHead;
+    uint32_t freeCount;
+
+    static const uint32_t NO_SLOT = NodeHandle::INDEX_MASK;
+
+public:
+    NodeStore() : freeHead(NO_SLOT), freeCount(0) {}
+
+    /// Number of live nodes
+    size_t size() const { return values.size(); }
+
+    /// Bytes of bookkeeping (links, slot and back-reference) per node
+    static size_t getOverheadPerNode() {
+        return sizeof(Links) + sizeof(uint32_t) + sizeof(uint32_t);
+    }
+
+    /// Reserves room for @a count nodes
+    void reserve(size_t count) {
+        slots.reserve(count);
+        values.reserve(count);
+        links.reserve(count);
+        slotOf.reserve(count);
+    }
+
+    /// Creates an unattached node holding @a value
+    NodeHandle create(const T& value = T()) {
+        const uint32_t dense = static_cast<uint32_t>(values.size());
+        flexiAssertM(dense < NodeHandle::INDEX_MASK, "NodeStore is full");
+
+        uint32_t slot, generation;
+        if (freeCount != 0) {
+            slot = freeHead;
+            freeHead = slots[slot] & NodeHandle::INDEX_MASK;
+            --freeCount;
+            generation = slots[slot] >> NodeHandle::INDEX_BITS;
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back(0);
+            generation = 1;
+        }
+        slots[slot] = (generation << NodeHandle::INDEX_BITS) | dense;
+
+        values.push_back(value);
+        links.push_back(Links());
+        slotOf.push_back(slot);
+        return NodeHandle(slot, generation);
+    }
+
+    /// Whether @a handle refers to a node that has not been destroyed
+    bool isValid(NodeHandle handle) const {
+        const uint32_t slot = handle.getIndex();
+        return !handle.isNull()
+            && slot < slots.size()
+            && (slots[slot] >> NodeHandle::INDEX_BITS) == handle.getGeneration();
+    }
+
+    /// The value of the node @a handle refers to, or null if it is stale
+    T* get(NodeHandle handle) {
+        return isValid(handle) ? &values[denseIndex(handle)] : 0;
+    }
+
+    const T* get(NodeHandle handle) const {
+        return isValid(handle) ? &values[denseIndex(handle)] : 0;
+    }
+
+    NodeHandle getParent(NodeHandle handle) const {
+        return linksOf(handle).parent;
+    }
+
+    NodeHandle getFirstChild(NodeHandle handle) const {
+        return linksOf(handle).firstChild;
+    }
+
+    NodeHandle getNextSibling(NodeHandle handle) const {
+        return linksOf(handle).nextSibling;
+    }
+
+    /// Attaches the unattached node @a child as the first child of @a parent
+    void addChild(NodeHandle parent, NodeHandle child) {
+        flexiAssert(isValid(parent) && isValid(child));
+        Links& parentLinks = linksOf(parent);
+        Links& childLinks = linksOf(child);
+        flexiAssert(childLinks.parent.isNull() && childLinks.nextSibling.isNull());
+
+        childLinks.parent = parent;
+        childLinks.nextSibling = parentLinks.firstChild;
+        parentLinks.firstChild = child;
+    }
+
+    /// Detaches @a handle from its parent, leaving its subtree intact
+    void detach(NodeHandle handle) {
+        Links& nodeLinks = linksOf(handle);
+        if (nodeLinks.parent.isNull())
+            return;
+
+        NodeHandle* link = &linksOf(nodeLinks.parent).firstChild;
+        while (*link != handle)
+            link = &linksOf(*link).nextSibling;
+        *link = nodeLinks.nextSibling;
+
+        nodeLinks.parent = NodeHandle();
+        nodeLinks.nextSibling = NodeHandle();
+    }
+
+    /**
+     * @brief Destroys the node @a handle refers to and its whole subtree.
+     * 
+     * Every handle into the subtree becomes stale. Stale handles are ignored.
+     */
+    void destroy(NodeHandle handle) {
+        if (!isValid(handle))
+            return;
+        detach(handle);
+
+        std::vector<NodeHandle> pending(1, handle);
+        while (!pending.empty()) {
+            const NodeHandle node = pending.back();
+            pending.pop_back();
+            for (NodeHandle child = getFirstChild(node); !child.isNull();
+                 child = getNextSibling(child))
+            {
+                pending.push_back(child);
+            }
+            release(node);
+        }
+    }
+
+    /**
+     * @brief Calls @a visit(handle, value) for every node under and including
+     *  @a root, parents before children.
+     */
+    template <typename Visitor>
+    void visitDepthFirst(NodeHandle root, Visitor& visit) {
+        if (!isValid(root))
+            return;
+
+        std::vector<uint32_t> pending(1, denseIndex(root));
+        while (!pending.empty()) {
+            const uint32_t dense = pending.back();
+            pending.pop_back();
+            visit(NodeHandle(slotOf[dense], slots[slotOf[dense]] >> NodeHandle::INDEX_BITS),
+                  values[dense]);
+
+            for (NodeHandle child = links[dense].firstChild; !child.isNull();
+                 child = links[denseIndex(child)].nextSibling)
+            {
+                pending.push_back(denseIndex(child));
+            }
+        }
+    }
+
+    /**
+     * @brief Reorders the dense arrays so the tree under @a root is laid out in
+     *  the order visitDepthFirst() walks it, followed by all other nodes.
+     * 
+     * Handles are unaffected; only the nodes' positions in memory change.
+     */
+    void compact(NodeHandle root) {
+        if (!isValid(root))
+            return;
+
+        std::vector<uint32_t> order;
+        order.reserve(values.size());
+        std::vector<bool> placed(values.size(), false);
+
+        std::vector<uint32_t> pending(1, denseIndex(root));
+        while (!pending.empty()) {
+            const uint32_t dense = pending.back();
+            pending.pop_back();
+            order.push_back(dense);
+            placed[dense] = true;
+
+            for (NodeHandle child = links[dense].firstChild; !child.isNull();
+                 child = links[denseIndex(child)].nextSibling)
+            {
+                pending.push_back(denseIndex(child));
+            }
+        }
+        for (uint32_t dense = 0; dense < values.size(); ++dense) {
+            if (!placed[dense])
+                order.push_back(dense);
+        }
+
+        std::vector<T> sortedValues;
+        std::vector<Links> sortedLinks;
+        std::vector<uint32_t> sortedSlotOf;
+        sortedValues.reserve(values.size());
+        sortedLinks.reserve(values.size());
+        sortedSlotOf.reserve(values.size());
+
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            const uint32_t slot = slotOf[order[i]];
+            sortedValues.push_back(values[order[i]]);
+            sortedLinks.push_back(links[order[i]]);
+            sortedSlotOf.push_back(slot);
+            slots[slot] = (slots[slot] & ~NodeHandle::INDEX_MASK) | i;
+        }
+        values.swap(sortedValues);
+        links.swap(sortedLinks);
+        slotOf.swap(sortedSlotOf);
+    }
+
+private:
+    uint32_t denseIndex(NodeHandle handle) const {
+        return slots[handle.getIndex()] & NodeHandle::INDEX_MASK;
+    }
+
+    Links& linksOf(NodeHandle handle) {
+        flexiAssert(isValid(handle));
+        return links[denseIndex(handle)];
+    }
+
+    const Links& linksOf(NodeHandle handle) const {
+        flexiAssert(isValid(handle));
+        return links[denseIndex(handle)];
+    }
+
+    /// Frees @a handle's slot and moves the last node into its dense position
+    void release(NodeHandle handle) {
+        const uint32_t slot = handle.getIndex();
+        const uint32_t dense = denseIndex(handle);
+        const uint32_t last = static_cast<uint32_t>(values.size()) - 1;
+
+        if (dense != last) {
+            values[dense] = values[last];
+            links[dense] = links[last];
+            slotOf[dense] = slotOf[last];
+            slots[slotOf[dense]] = (slots[slotOf[dense]] & ~NodeHandle::INDEX_MASK) | dense;
+        }
+        values.pop_back();
+        links.pop_back();
+        slotOf.pop_back();
+
+        uint32_t generation = handle.getGeneration() + 1;
+        if (generation > NodeHandle::MAX_GENERATION)
+            generation = 1;
+        slots[slot] = (generation << NodeHandle::INDEX_BITS) | freeHead;
+        freeHead = slot;
+        ++freeCount;
+    }
+}; // class NodeStore
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // NodeStore_H__
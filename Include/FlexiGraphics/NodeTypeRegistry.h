@@ -13,11 +13,19 @@
 // Include the headers for your node types here
 #include "Node.h"
 #include "InnerNode.h"
+#include "InstanceNode.h"
+#include "EntityNode.h"
+#include "DrawableNode.h"
+#include "LodNode.h"
 //
 
 NODE_TYPE_REGISTRY_BEGIN
     REGISTER(Node)
     REGISTER(InnerNode)
+    REGISTER(InstanceNode)
+    REGISTER(EntityNode)
+    REGISTER(DrawableNode)
+    REGISTER(LodNode)
 NODE_TYPE_REGISTRY_END
 
 #endif // NodeTypeRegistry_H__
\ No newline at end of file
@@ -0,0 +1,616 @@
+#ifndef RayCaster_H__
+#define RayCaster_H__
+/**
+ * @file
+ * @brief Defines RayCaster, which answers batches of ray queries against a
+ *  triangle mesh.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cfloat>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiUtil\Parallel.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiGraphics\BoundingVolumeHierarchy.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FLEXI_RAY_LANES internal::Float8
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FLEXI_RAY_LANES internal::Float4
+#else
+#define FLEXI_RAY_LANES internal::Float1
+#endif
+
+namespace flexi {
+namespace graphics {
+
+/// The segment origin + t * direction for 0 <= t <= maxDistance
+struct Ray
+{
+    math::Vector3f origin, direction;
+    float maxDistance;
+
+    Ray() : maxDistance(0) {}
+    Ray(const math::Vector3f& origin, const math::Vector3f& direction, float maxDistance)
+        : origin(origin), direction(direction), maxDistance(maxDistance) {}
+};
+
+/// Where a ray met a triangle
+struct RayHit
+{
+    static const uint32_t NONE = ~0u;
+
+    /// The triangle hit, or NONE
+    uint32_t triangle;
+    /// The index of the ray in its batch
+    uint32_t ray;
+    /// The t of the hit point along the ray
+    float distance;
+    /// Barycentric coordinates of the hit point: weights of the second and
+    /// third vertices
+    float u, v;
+
+    RayHit() : triangle(NONE), ray(0), distance(0), u(0), v(0) {}
+
+    bool isHit() const { return triangle != uint32_t(NONE); }
+    bool operator<(const RayHit& that) const {
+        return ray != that.ray ? ray < that.ray : distance < that.distance;
+    }
+};
+
+namespace internal {
+
+// Each lane type wraps one SIMD register of floats. The ray traversal is
+// written once against this interface and instantiated with the widest one
+// the compiler targets.
+
+/// Plain floats, for targets without SSE
+struct Float1
+{
+    static const unsigned WIDTH = 1;
+    typedef bool Mask;
+
+    float v;
+
+    Float1() {}
+    Float1(float s) : v(s) {}
+
+    static Float1 load(const float* p) { return Float1(*p); }
+    void store(float* p) const { *p = v; }
+
+    friend Float1 operator+(Float1 a, Float1 b) { return a.v + b.v; }
+    friend Float1 operator-(Float1 a, Float1 b) { return a.v - b.v; }
+    friend Float1 operator*(Float1 a, Float1 b) { return a.v * b.v; }
+    friend Float1 operator/(Float1 a, Float1 b) { return a.v / b.v; }
+    friend Float1 min(Float1 a, Float1 b) { return a.v < b.v ? a.v : b.v; }
+    friend Float1 max(Float1 a, Float1 b) { return a.v > b.v ? a.v : b.v; }
+    friend Float1 abs(Float1 a) { return std::fabs(a.v); }
+
+    friend Mask operator<(Float1 a, Float1 b) { return a.v < b.v; }
+    friend Mask operator<=(Float1 a, Float1 b) { return a.v <= b.v; }
+    friend Mask operator>(Float1 a, Float1 b) { return a.v > b.v; }
+    friend Mask operator>=(Float1 a, Float1 b) { return a.v >= b.v; }
+
+    static Mask both(Mask a, Mask b) { return a && b; }
+    static Mask either(Mask a, Mask b) { return a || b; }
+    static Mask without(Mask a, Mask b) { return a && !b; }
+    static Mask none() { return false; }
+    static unsigned bits(Mask m) { return m ? 1 : 0; }
+    static Float1 select(Mask m, Float1 a, Float1 b) { return m ? a : b; }
+    static float smallest(Float1 a) { return a.v; }
+};
+
+#if defined(__AVX__) || defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+/// Four floats in an SSE register
+struct Float4
+{
+    static const unsigned WIDTH = 4;
+    typedef __m128 Mask;
+
+    __m128 v;
+
+    Float4() {}
+    Float4(__m128 v) : v(v) {}
+    Float4(float s) : v(_mm_set1_ps(s)) {}
+
+    static Float4 load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+
+    friend Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+    friend Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+    friend Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+    friend Float4 operator/(Float4 a, Float4 b) { return _mm_div_ps(a.v, b.v); }
+    friend Float4 min(Float4 a, Float4 b) { return _mm_min_ps(a.v, b.v); }
+    friend Float4 max(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+    friend Float4 abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+
+    friend Mask operator<(Float4 a, Float4 b) { return _mm_cmplt_ps(a.v, b.v); }
+    friend Mask operator<=(Float4 a, Float4 b) { return _mm_cmple_ps(a.v, b.v); }
+    friend Mask operator>(Float4 a, Float4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+    friend Mask operator>=(Float4 a, Float4 b) { return _mm_cmpge_ps(a.v, b.v); }
+
+    static Mask both(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    static Mask either(Mask a, Mask b) { return _mm_or_ps(a, b); }
+    static Mask without(Mask a, Mask b) { return _mm_andnot_ps(b, a); }
+    static Mask none() { return _mm_setzero_ps(); }
+    static unsigned bits(Mask m) { return unsigned(_mm_movemask_ps(m)); }
+    static Float4 select(Mask m, Float4 a, Float4 b) {
+        return _mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v));
+    }
+    static float smallest(Float4 a) {
+        const __m128 pairs = _mm_min_ps(a.v, _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(_mm_min_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+};
+#endif
+
+#if defined(__AVX__)
+/// Eight floats in an AVX register
+struct Float8
+{
+    static const unsigned WIDTH = 8;
+    typedef __m256 Mask;
+
+    __m256 v;
+
+    Float8() {}
+    Float8(__m256 v) : v(v) {}
+    Float8(float s) : v(_mm256_set1_ps(s)) {}
+
+    static Float8 load(const float* p) { return _mm256_loadu_ps(p); }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+
+    friend Float8 operator+(Float8 a, Float8 b) { return _mm256_add_ps(a.v, b.v); }
+    friend Float8 operator-(Float8 a, Float8 b) { return _mm256_sub_ps(a.v, b.v); }
+    friend Float8 operator*(Float8 a, Float8 b) { return _mm256_mul_ps(a.v, b.v); }
+    friend Float8 operator/(Float8 a, Float8 b) { return _mm256_div_ps(a.v, b.v); }
+    friend Float8 min(Float8 a, Float8 b) { return _mm256_min_ps(a.v, b.v); }
+    friend Float8 max(Float8 a, Float8 b) { return _mm256_max_ps(a.v, b.v); }
+    friend Float8 abs(Float8 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+
+    friend Mask operator<(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+    friend Mask operator<=(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+    friend Mask operator>(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+    friend Mask operator>=(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+
+    static Mask both(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+    static Mask either(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+    static Mask without(Mask a, Mask b) { return _mm256_andnot_ps(b, a); }
+    static Mask none() { return _mm256_setzero_ps(); }
+    static unsigned bits(Mask m) { return unsigned(_mm256_movemask_ps(m)); }
+    static Float8 select(Mask m, Float8 a, Float8 b) { return _mm256_blendv_ps(b.v, a.v, m); }
+    static float smallest(Float8 a) {
+        return Float4::smallest(_mm_min_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1)));
+    }
+};
+#endif
+
+} // namespace internal
+
+/**
+ * @brief Intersects batches of rays with a triangle mesh, traversing them in
+ *  packets as wide as @a L.
+ *
+ * Use RayCaster, which picks the widest lane type the target supports;
+ * other widths are for comparison.
+ *
+ * The mesh is indexed by a BoundingVolumeHierarchy and its triangles are
+ * copied in the tree's leaf order as one vertex and two edges each, ready for
+ * the Moller-Trumbore test. Rays are traversed in packets as wide as the
+ * target's SIMD registers (8 with AVX, 4 with SSE): the packet descends into
+ * a node if any of its rays hits the node's box, and each triangle is tested
+ * against every ray of the packet at once. Packets of rays that start near
+ * each other and point the same way, such as picking rays through
+ * neighbouring pixels, share most of their nodes; unrelated rays still work
+ * but gain less. Large batches are split across cores.
+ *
+ * Triangles are numbered in the order given to build(), and hits report
+ * distances in units of each ray's direction, which need not be unit length.
+ * Rays that graze an edge shared by two triangles may hit either.
+ */
+template <typename L>
+class BasicRayCaster
+{
+    BasicRayCaster(const BasicRayCaster&);
+    BasicRayCaster& operator=(const BasicRayCaster&);
+
+public:
+    typedef L Lanes;
+    typedef typename Lanes::Mask Mask;
+
+    /// The number of rays traversed together
+    static const unsigned PACKET_WIDTH = Lanes::WIDTH;
+
+    BasicRayCaster() {}
+
+    /**
+     * @brief Builds the query structures for a mesh.
+     *
+     * @param positions The x of the first vertex's position, with y and z
+     *  following it.
+     * @param stride The distance in bytes from one vertex to the next, so
+     *  that positions can be read from interleaved vertex arrays.
+     * @param indices Three vertex indices per triangle.
+     */
+    template <typename Index>
+    void build(const float* positions, size_t stride, const Index* indices, unsigned triangleCount) {
+        std::vector<math::BoundingBox> bounds(triangleCount);
+        std::vector<Triangle> source(triangleCount);
+        for (unsigned i = 0; i < triangleCount; ++i) {
+            source[i] = Triangle(vertex(positions, stride, indices[3 * i]),
+                                 vertex(positions, stride, indices[3 * i + 1]),
+                                 vertex(positions, stride, indices[3 * i + 2]));
+            bounds[i] = source[i].getBounds();
+        }
+        bvh.build(triangleCount ? &bounds[0] : 0, triangleCount);
+
+        // Store triangles in leaf order so leaves read them sequentially
+        triangles.resize(triangleCount);
+        const uint32_t* order = bvh.getPrimitives();
+        for (unsigned i = 0; i < triangleCount; ++i)
+            triangles[i] = source[order[i]];
+    }
+
+    /**
+     * @brief Updates vertex positions of the mesh given to build() and refits
+     *  the tree instead of rebuilding it.
+     *
+     * The indices must be those given to build().
+     */
+    template <typename Index>
+    void refit(const float* positions, size_t stride, const Index* indices) {
+        const size_t triangleCount = triangles.size();
+        std::vector<math::BoundingBox> bounds(triangleCount);
+        const uint32_t* order = bvh.getPrimitives();
+        for (size_t i = 0; i < triangleCount; ++i) {
+            const uint32_t t = order[i];
+            triangles[i] = Triangle(vertex(positions, stride, indices[3 * t]),
+                                    vertex(positions, stride, indices[3 * t + 1]),
+                                    vertex(positions, stride, indices[3 * t + 2]));
+            bounds[t] = triangles[i].getBounds();
+        }
+        bvh.refit(triangleCount ? &bounds[0] : 0);
+    }
+
+    size_t getTriangleCount() const { return triangles.size(); }
+    const BoundingVolumeHierarchy& getHierarchy() const { return bvh; }
+
+    /// Finds the nearest hit of each ray; misses get a RayHit with no triangle
+    void castNearest(const Ray* rays, RayHit* hits, size_t count) const {
+        forEachPacket(count, [&](size_t first, unsigned width) {
+            NearestHits nearest(hits + first, first);
+            traverse(rays + first, width, nearest);
+        });
+    }
+
+    /// Sets occluded[i] to whether ray i hits anything, stopping at the first hit
+    void castAny(const Ray* rays, bool* occluded, size_t count) const {
+        forEachPacket(count, [&](size_t first, unsigned width) {
+            AnyHits any(occluded + first);
+            traverse(rays + first, width, any);
+        });
+    }
+
+    /**
+     * @brief Appends every hit of every ray to @a hits, sorted by ray and
+     *  then by distance.
+     */
+    void castAll(const Ray* rays, size_t count, std::vector<RayHit>& hits) const {
+        // Hits are appended as found, so packets run one at a time
+        const size_t start = hits.size();
+        forEachPacket(count, [&](size_t first, unsigned width) {
+            AllHits all(hits, first);
+            traverse(rays + first, width, all);
+        }, false);
+        std::sort(hits.begin() + start, hits.end());
+    }
+
+private: /*************************** Triangles ******************************/
+
+    /// A triangle as its first vertex and the edges to the other two
+    struct Triangle
+    {
+        float v0[3], e1[3], e2[3];
+
+        Triangle() {}
+        Triangle(const math::Vector3f& a, const math::Vector3f& b, const math::Vector3f& c) {
+            v0[0] = a.x;       v0[1] = a.y;       v0[2] = a.z;
+            e1[0] = b.x - a.x; e1[1] = b.y - a.y; e1[2] = b.z - a.z;
+            e2[0] = c.x - a.x; e2[1] = c.y - a.y; e2[2] = c.z - a.z;
+        }
+
+        math::BoundingBox getBounds() const {
+            float lo[3], hi[3];
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                const float a = v0[axis], b = a + e1[axis], c = a + e2[axis];
+                lo[axis] = std::min(a, std::min(b, c));
+                hi[axis] = std::max(a, std::max(b, c));
+            }
+            return math::BoundingBox(math::Vector3f(lo[0], lo[1], lo[2]),
+                                     math::Vector3f(hi[0], hi[1], hi[2]));
+        }
+    };
+
+    template <typename Index>
+    static math::Vector3f vertex(const float* positions, size_t stride, Index index) {
+        const float* p = reinterpret_cast<const float*>(
+            reinterpret_cast<const char*>(positions) + stride * size_t(index));
+        return math::Vector3f(p[0], p[1], p[2]);
+    }
+
+private: /**************************** Packets *******************************/
+
+    /// A packet of rays spread across lanes
+    struct Packet
+    {
+        Lanes origin[3], direction[3], inverse[3];
+        /// Lanes whose rays run towards -axis, so meet a box's max plane first
+        Mask negative[3];
+        Lanes maxDistance;
+        Mask active;
+
+        Packet(const Ray* rays, unsigned width) {
+            float o[3][Lanes::WIDTH], d[3][Lanes::WIDTH], inv[3][Lanes::WIDTH], t[Lanes::WIDTH];
+            for (unsigned lane = 0; lane < Lanes::WIDTH; ++lane) {
+                // Unused lanes repeat the last ray with a negative length so
+                // they never hit anything
+                const Ray& ray = rays[std::min(lane, width - 1)];
+                for (unsigned axis = 0; axis < 3; ++axis) {
+                    o[axis][lane] = ray.origin.adr()[axis];
+                    d[axis][lane] = ray.direction.adr()[axis];
+                    inv[axis][lane] = 1.0f / ray.direction.adr()[axis];
+                }
+                t[lane] = lane < width ? ray.maxDistance : -1.0f;
+            }
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                origin[axis] = Lanes::load(o[axis]);
+                direction[axis] = Lanes::load(d[axis]);
+                inverse[axis] = Lanes::load(inv[axis]);
+                negative[axis] = inverse[axis] < Lanes(0.0f);
+            }
+            maxDistance = Lanes::load(t);
+            active = Lanes(0.0f) <= maxDistance;
+        }
+
+        /// The lanes whose rays hit @a node's box, and the least entry distance among them
+        Mask hits(const BoundingVolumeHierarchy::Node& node, float& entry) const {
+            Lanes enter(0.0f), exit = maxDistance;
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                const Lanes lo(node.min[axis]), hi(node.max[axis]);
+                const Lanes tNear = (Lanes::select(negative[axis], hi, lo) - origin[axis]) * inverse[axis];
+                const Lanes tFar = (Lanes::select(negative[axis], lo, hi) - origin[axis]) * inverse[axis];
+                // A ray parallel to this axis with its origin on one of the
+                // planes gives 0 * inf = NaN; min and max return their second
+                // operand for NaN, so such a plane does not limit the ray
+                enter = max(tNear, enter);
+                exit = min(tFar, exit);
+            }
+            const Mask mask = Lanes::both(active, enter <= exit);
+            entry = Lanes::smallest(Lanes::select(mask, enter, Lanes(FLT_MAX)));
+            return mask;
+        }
+
+        /**
+         * Moller-Trumbore against every lane at once. Returns the lanes hit
+         * closer than their maxDistance, with distances and barycentrics.
+         */
+        Mask intersect(const Triangle& tri, Lanes& t, Lanes& u, Lanes& v) const {
+            const Lanes e1x(tri.e1[0]), e1y(tri.e1[1]), e1z(tri.e1[2]);
+            const Lanes e2x(tri.e2[0]), e2y(tri.e2[1]), e2z(tri.e2[2]);
+
+            // p = direction x e2
+            const Lanes px = direction[1] * e2z - direction[2] * e2y;
+            const Lanes py = direction[2] * e2x - direction[0] * e2z;
+            const Lanes pz = direction[0] * e2y - direction[1] * e2x;
+            const Lanes det = e1x * px + e1y * py + e1z * pz;
+            const Lanes inverseDet = Lanes(1.0f) / det;
+
+            const Lanes sx = origin[0] - Lanes(tri.v0[0]);
+            const Lanes sy = origin[1] - Lanes(tri.v0[1]);
+            const Lanes sz = origin[2] - Lanes(tri.v0[2]);
+            u = (sx * px + sy * py + sz * pz) * inverseDet;
+
+            // q = s x e1
+            const Lanes qx = sy * e1z - sz * e1y;
+            const Lanes qy = sz * e1x - sx * e1z;
+            const Lanes qz = sx * e1y - sy * e1x;
+            v = (direction[0] * qx + direction[1] * qy + direction[2] * qz) * inverseDet;
+            t = (e2x * qx + e2y * qy + e2z * qz) * inverseDet;
+
+            Mask mask = Lanes::both(active, abs(det) > Lanes(1e-12f));
+            mask = Lanes::both(mask, u >= Lanes(0.0f));
+            mask = Lanes::both(mask, v >= Lanes(0.0f));
+            mask = Lanes::both(mask, u + v <= Lanes(1.0f));
+            mask = Lanes::both(mask, t >= Lanes(0.0f));
+            return Lanes::both(mask, t <= maxDistance);
+        }
+    };
+
+    /// Keeps each lane's nearest hit, shortening its ray as it goes
+    struct NearestHits
+    {
+        RayHit* hits;
+        size_t first;
+        Lanes distance, u, v;
+        uint32_t triangle[Lanes::WIDTH];
+
+        NearestHits(RayHit* hits, size_t first)
+            : hits(hits), first(first), distance(0.0f), u(0.0f), v(0.0f)
+        {
+            std::fill(triangle, triangle + Lanes::WIDTH, uint32_t(RayHit::NONE));
+        }
+
+        void hit(Packet& packet, Mask mask, uint32_t id, const Lanes& t, const Lanes& hu, const Lanes& hv) {
+            packet.maxDistance = Lanes::select(mask, t, packet.maxDistance);
+            distance = Lanes::select(mask, t, distance);
+            u = Lanes::select(mask, hu, u);
+            v = Lanes::select(mask, hv, v);
+            for (unsigned bits = Lanes::bits(mask), lane = 0; bits; bits >>= 1, ++lane)
+                if (bits & 1)
+                    triangle[lane] = id;
+        }
+
+        void finish(unsigned width) {
+            float d[Lanes::WIDTH], hu[Lanes::WIDTH], hv[Lanes::WIDTH];
+            distance.store(d);
+            u.store(hu);
+            v.store(hv);
+            for (unsigned lane = 0; lane < width; ++lane) {
+                RayHit& hit = hits[lane];
+                hit = RayHit();
+                hit.ray = uint32_t(first + lane);
+                hit.triangle = triangle[lane];
+                if (hit.isHit()) {
+                    hit.distance = d[lane];
+                    hit.u = hu[lane];
+                    hit.v = hv[lane];
+                }
+            }
+        }
+    };
+
+    /// Retires each lane at its first hit
+    struct AnyHits
+    {
+        bool* occluded;
+        Mask found;
+
+        explicit AnyHits(bool* occluded) : occluded(occluded), found(Lanes::none()) {}
+
+        void hit(Packet& packet, Mask mask, uint32_t, const Lanes&, const Lanes&, const Lanes&) {
+            found = Lanes::either(found, mask);
+            packet.active = Lanes::without(packet.active, mask);
+        }
+
+        void finish(unsigned width) {
+            const unsigned bits = Lanes::bits(found);
+            for (unsigned lane = 0; lane < width; ++lane)
+                occluded[lane] = (bits >> lane & 1) != 0;
+        }
+    };
+
+    /// Appends every hit to a vector
+    struct AllHits
+    {
+        std::vector<RayHit>& hits;
+        size_t first;
+
+        AllHits(std::vector<RayHit>& hits, size_t first) : hits(hits), first(first) {}
+
+        void hit(Packet&, Mask mask, uint32_t id, const Lanes& t, const Lanes& hu, const Lanes& hv) {
+            float d[Lanes::WIDTH], u[Lanes::WIDTH], v[Lanes::WIDTH];
+            t.store(d);
+            hu.store(u);
+            hv.store(v);
+            for (unsigned bits = Lanes::bits(mask), lane = 0; bits; bits >>= 1, ++lane) {
+                if (bits & 1) {
+                    RayHit hit;
+                    hit.triangle = id;
+                    hit.ray = uint32_t(first + lane);
+                    hit.distance = d[lane];
+                    hit.u = u[lane];
+                    hit.v = v[lane];
+                    hits.push_back(hit);
+                }
+            }
+        }
+
+        void finish(unsigned) {}
+
+    private:
+        AllHits& operator=(const AllHits&);
+    };
+
+    /**
+     * Walks the tree with up to PACKET_WIDTH rays, nearer child first, and
+     * reports triangle hits to @a hits.
+     */
+    template <typename Hits>
+    void traverse(const Ray* rays, unsigned width, Hits& hits) const {
+        if (bvh.getNodeCount() == 0) {
+            hits.finish(width);
+            return;
+        }
+        Packet packet(rays, width);
+        const BoundingVolumeHierarchy::Node* nodes = bvh.getNodes();
+        const uint32_t* order = bvh.getPrimitives();
+        uint32_t stack[BoundingVolumeHierarchy::MAX_DEPTH];
+        unsigned size = 0;
+        float entry;
+        uint32_t current = 0;
+        if (Lanes::bits(packet.hits(nodes[0], entry))) {
+            for (;;) {
+                const BoundingVolumeHierarchy::Node& node = nodes[current];
+                if (node.isLeaf()) {
+                    Lanes t, u, v;
+                    for (uint32_t i = node.index; i < node.index + node.count; ++i) {
+                        const Mask mask = packet.intersect(triangles[i], t, u, v);
+                        if (Lanes::bits(mask))
+                            hits.hit(packet, mask, order[i], t, u, v);
+                    }
+                    if (!Lanes::bits(packet.active))
+                        break;
+                } else {
+                    const uint32_t firstChild = current + 1, secondChild = node.index;
+                    float firstEntry, secondEntry;
+                    const bool hitsFirst = Lanes::bits(packet.hits(nodes[firstChild], firstEntry)) != 0;
+                    const bool hitsSecond = Lanes::bits(packet.hits(nodes[secondChild], secondEntry)) != 0;
+                    if (hitsFirst && hitsSecond) {
+                        const bool secondNearer = secondEntry < firstEntry;
+                        stack[size++] = secondNearer ? firstChild : secondChild;
+                        current = secondNearer ? secondChild : firstChild;
+                        continue;
+                    } else if (hitsFirst || hitsSecond) {
+                        current = hitsFirst ? firstChild : secondChild;
+                        continue;
+                    }
+                }
+                if (size == 0)
+                    break;
+                current = stack[--size];
+            }
+        }
+        hits.finish(width);
+    }
+
+    /**
+     * Calls @a cast(first, width) for each packet of the batch, spreading
+     * runs of packets across cores for large batches.
+     */
+    template <typename Function>
+    void forEachPacket(size_t count, Function cast, bool parallel = true) const {
+        const size_t RUN = 1024;
+        const auto castRun = [&](size_t begin, size_t end) {
+            for (size_t first = begin; first < end; first += Lanes::WIDTH)
+                cast(first, unsigned(std::min<size_t>(Lanes::WIDTH, end - first)));
+        };
+        if (!parallel || count < 4 * RUN) {
+            castRun(0, count);
+            return;
+        }
+        util::parallelFor(unsigned((count + RUN - 1) / RUN), [&](unsigned run) {
+            castRun(run * RUN, std::min(count, (run + 1) * RUN));
+        });
+    }
+
+private: /******************************* Fields ******************************/
+    BoundingVolumeHierarchy bvh;
+    /// In the tree's leaf order
+    std::vector<Triangle> triangles;
+};
+
+typedef BasicRayCaster<FLEXI_RAY_LANES> RayCaster;
+
+} // namespace graphics
+} // namespace flexi
+
+#undef FLEXI_RAY_LANES
+
+#endif // RayCaster_H__
@@ -0,0 +1,366 @@
+#ifndef RenderQueue_H__
+#define RenderQueue_H__
+/**
+ * @file
+ * @brief Defines RenderQueue, which orders a frame's draws to minimize state
+ *        changes.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiMath\FlexiMath.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Packs the properties draws are ordered by into 64-bit keys, most
+ *  significant first.
+ *
+ * Opaque keys hold, from the top: layer (8 bits), program (12), material (16)
+ * and depth (24), so that draws are grouped by program and then by material,
+ * and drawn front to back within those groups to help early depth rejection.
+ * Blended layers must be drawn back to front regardless of state, so their
+ * keys hold layer, inverted depth, program and material instead.
+ *
+ * Program and material ids are truncated to their fields; ids beyond the
+ * field sizes still draw correctly but may sort less well. The lowest bit
+ * marks blended keys, so that RenderQueue::submitInstanced() knows which
+ * draws it must keep in order.
+ */
+struct DrawKey
+{
+    static const unsigned LAYER_BITS    = 8;
+    static const unsigned PROGRAM_BITS  = 12;
+    static const unsigned MATERIAL_BITS = 16;
+    static const unsigned DEPTH_BITS    = 24;
+    static const uint64_t BLENDED_FLAG  = 1;
+
+    static uint64_t opaque(unsigned layer, uint32_t program, uint32_t material, uint32_t depth) {
+        return field(layer, LAYER_BITS, 56)
+             | field(program, PROGRAM_BITS, 44)
+             | field(material, MATERIAL_BITS, 28)
+             | field(depth, DEPTH_BITS, 4);
+    }
+
+    static uint64_t blended(unsigned layer, uint32_t depth, uint32_t program, uint32_t material) {
+        const uint32_t farFirst = ~depth & ((1u << DEPTH_BITS) - 1);
+        return field(layer, LAYER_BITS, 56)
+             | field(farFirst, DEPTH_BITS, 32)
+             | field(program, PROGRAM_BITS, 20)
+             | field(material, MATERIAL_BITS, 4)
+             | BLENDED_FLAG;
+    }
+
+    static unsigned getLayer(uint64_t key) { return unsigned(key >> 56); }
+    static bool isBlended(uint64_t key) { return (key & BLENDED_FLAG) != 0; }
+
+    /// Maps a view depth between the near and far planes to a depth field
+    static uint32_t quantizeDepth(float depth, float nearClip, float farClip) {
+        const float unit = (depth - nearClip) / (farClip - nearClip);
+        const float clamped = unit < 0 ? 0 : (unit > 1 ? 1 : unit);
+        return uint32_t(clamped * float((1u << DEPTH_BITS) - 1));
+    }
+
+private:
+    static uint64_t field(uint64_t value, unsigned bits, unsigned shift) {
+        return (value & ((uint64_t(1) << bits) - 1)) << shift;
+    }
+};
+
+/// One draw call and the state it needs
+struct DrawItem
+{
+    /// Orders the item in its queue; see DrawKey
+    uint64_t key;
+    uint32_t program, material, mesh;
+    /// For the submitter's use, such as an index into per-object data
+    uint32_t userData;
+    const math::Matrix4x3* transform;
+
+    DrawItem() : key(0), program(0), material(0), mesh(0), userData(0), transform(0) {}
+};
+
+/**
+ * @brief Collects a frame's draws, sorts them by key and hands them to a
+ *  submitter, skipping state the submitter already has.
+ *
+ * A frame is built by clear(), any number of push() calls (typically from a
+ * culling traversal, see DrawQueueBuilder), and submit(). Sorting is an LSD
+ * radix sort of (key, index) pairs, one byte per pass; passes over bytes
+ * that every key shares are skipped, so a frame with few distinct layers and
+ * programs sorts in fewer passes. Equal keys keep their push order.
+ *
+ * The submitter is called as:
+ * - @b bindProgram(uint32_t program)
+ * - @b bindMaterial(uint32_t material)
+ * - @b bindMesh(uint32_t mesh)
+ * - @b draw(const DrawItem&)
+ *
+ * A bind is only issued when the value differs from the one last bound during
+ * the same submit(); binding a program also re-binds the material, since
+ * materials are usually stored as program uniforms.
+ *
+ * submitInstanced() instead hands over groups of items that share program,
+ * material and mesh, for the submitter to draw with one instanced call:
+ * - @b drawInstances(const DrawItem* const* items, size_t count)
+ *
+ * Opaque items with the same program and material are grouped by mesh, each
+ * group keeping its front to back order; blended items are only grouped with
+ * identical neighbours, so they still draw back to front.
+ */
+class RenderQueue
+{
+public:
+    /// Counts of the state changes made and avoided by the last submit()
+    struct Stats
+    {
+        unsigned draws;
+        /// Calls to the submitter's draw method; less than draws when
+        /// submitInstanced() merged some
+        unsigned drawCalls;
+        unsigned programBinds, materialBinds, meshBinds;
+        unsigned programBindsSkipped, materialBindsSkipped, meshBindsSkipped;
+
+        Stats() { std::memset(this, 0, sizeof *this); }
+
+        unsigned getBinds() const { return programBinds + materialBinds + meshBinds; }
+        unsigned getBindsSkipped() const {
+            return programBindsSkipped + materialBindsSkipped + meshBindsSkipped;
+        }
+    };
+
+    RenderQueue() : keysInOrder(true), entriesReady(true) {}
+
+    void clear() {
+        items.clear();
+        entries.clear();
+        keysInOrder = entriesReady = true;
+    }
+
+    void push(const DrawItem& item) {
+        keysInOrder = keysInOrder && (items.empty() || items.back().key <= item.key);
+        entriesReady = false;
+        items.push_back(item);
+    }
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    /// Gets the @a index-th item in sorted order; sorts first if needed
+    const DrawItem& operator[](size_t index) {
+        sort();
+        return items[entries[index].index];
+    }
+
+    /// Orders the queued items by key; submit() does this itself
+    void sort() {
+        if (entriesReady)
+            return;
+        const size_t count = items.size();
+        entries.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            entries[i].key = items[i].key;
+            entries[i].index = uint32_t(i);
+        }
+        if (!keysInOrder)
+            radixSort();
+        entriesReady = true;
+    }
+
+    /// Sorts the queue and passes every item to @a submitter in order
+    template <typename Submitter>
+    void submit(Submitter& submitter) {
+        sort();
+        stats = Stats();
+        bool first = true;
+        uint32_t program = 0, material = 0, mesh = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const DrawItem& item = items[entries[i].index];
+            const bool programChanged = first || item.program != program;
+            if (programChanged) {
+                submitter.bindProgram(program = item.program);
+                ++stats.programBinds;
+            } else {
+                ++stats.programBindsSkipped;
+            }
+            if (programChanged || item.material != material) {
+                submitter.bindMaterial(material = item.material);
+                ++stats.materialBinds;
+            } else {
+                ++stats.materialBindsSkipped;
+            }
+            if (first || item.mesh != mesh) {
+                submitter.bindMesh(mesh = item.mesh);
+                ++stats.meshBinds;
+            } else {
+                ++stats.meshBindsSkipped;
+            }
+            submitter.draw(item);
+            first = false;
+        }
+        stats.draws = stats.drawCalls = unsigned(entries.size());
+    }
+
+    /// Sorts the queue and passes it to @a submitter in instanced groups
+    template <typename Submitter>
+    void submitInstanced(Submitter& submitter) {
+        sort();
+        stats = Stats();
+        bool first = true;
+        uint32_t program = 0, material = 0, mesh = 0;
+        for (size_t begin = 0, end; begin < entries.size(); begin = end) {
+            // Find the run of items sharing the first one's state
+            const DrawItem& lead = items[entries[begin].index];
+            const bool blended = DrawKey::isBlended(lead.key);
+            bool mixedMeshes = false;
+            group.clear();
+            for (end = begin; end < entries.size(); ++end) {
+                const DrawItem& item = items[entries[end].index];
+                if (item.program != lead.program || item.material != lead.material
+                    || DrawKey::getLayer(item.key) != DrawKey::getLayer(lead.key)
+                    || DrawKey::isBlended(item.key) != blended
+                    || (blended && item.mesh != lead.mesh))
+                    break;
+                mixedMeshes = mixedMeshes || item.mesh != lead.mesh;
+                group.push_back(&item);
+            }
+            if (mixedMeshes)
+                groupByMesh();
+
+            const bool programChanged = first || lead.program != program;
+            countBind(programChanged, stats.programBinds, stats.programBindsSkipped);
+            if (programChanged)
+                submitter.bindProgram(program = lead.program);
+            countBind(programChanged || lead.material != material,
+                      stats.materialBinds, stats.materialBindsSkipped);
+            if (programChanged || lead.material != material)
+                submitter.bindMaterial(material = lead.material);
+
+            for (size_t i = 0, j; i < group.size(); i = j) {
+                for (j = i + 1; j < group.size() && group[j]->mesh == group[i]->mesh; ++j) {}
+                const bool meshChanged = first || group[i]->mesh != mesh;
+                countBind(meshChanged, stats.meshBinds, stats.meshBindsSkipped);
+                if (meshChanged)
+                    submitter.bindMesh(mesh = group[i]->mesh);
+                submitter.drawInstances(&group[i], j - i);
+                ++stats.drawCalls;
+                first = false;
+            }
+        }
+        stats.draws = unsigned(entries.size());
+    }
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Entry
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    static bool meshLess(const DrawItem* a, const DrawItem* b) { return a->mesh < b->mesh; }
+
+    /// Stably reorders group so that items with the same mesh are adjacent.
+    /// A group usually holds only a few meshes, so they are counted in a
+    /// short list; groups with many fall back to a comparison sort.
+    void groupByMesh() {
+        const size_t MAX_MESHES = 32;
+        uint32_t meshes[MAX_MESHES];
+        uint32_t offsets[MAX_MESHES];
+        size_t meshCount = 0;
+        for (size_t i = 0; i < group.size(); ++i) {
+            size_t m = 0;
+            while (m < meshCount && meshes[m] != group[i]->mesh)
+                ++m;
+            if (m == meshCount) {
+                if (meshCount == MAX_MESHES) {
+                    std::stable_sort(group.begin(), group.end(), meshLess);
+                    return;
+                }
+                meshes[meshCount] = group[i]->mesh;
+                offsets[meshCount++] = 0;
+            }
+            ++offsets[m];
+        }
+
+        uint32_t offset = 0;
+        for (size_t m = 0; m < meshCount; ++m) {
+            const uint32_t count = offsets[m];
+            offsets[m] = offset;
+            offset += count;
+        }
+        groupScratch.resize(group.size());
+        size_t last = 0;
+        for (size_t i = 0; i < group.size(); ++i) {
+            if (meshes[last] != group[i]->mesh) {
+                last = 0;
+                while (meshes[last] != group[i]->mesh)
+                    ++last;
+            }
+            groupScratch[offsets[last]++] = group[i];
+        }
+        group.swap(groupScratch);
+    }
+
+    static void countBind(bool issued, unsigned& binds, unsigned& skipped) {
+        ++(issued ? binds : skipped);
+    }
+
+    void radixSort() {
+        const size_t count = entries.size();
+        scratch.resize(count);
+
+        // Count every byte of every key in one pass
+        uint32_t histograms[8][256];
+        std::memset(histograms, 0, sizeof histograms);
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t key = entries[i].key;
+            for (unsigned byte = 0; byte < 8; ++byte)
+                ++histograms[byte][(key >> (8 * byte)) & 0xFF];
+        }
+
+        Entry* from = &entries[0];
+        Entry* to = &scratch[0];
+        for (unsigned byte = 0; byte < 8; ++byte) {
+            uint32_t* histogram = histograms[byte];
+            if (histogram[(from[0].key >> (8 * byte)) & 0xFF] == count)
+                continue; // Every key has the same value here
+
+            uint32_t offset = 0;
+            for (unsigned digit = 0; digit < 256; ++digit) {
+                const uint32_t digitCount = histogram[digit];
+                histogram[digit] = offset;
+                offset += digitCount;
+            }
+            for (size_t i = 0; i < count; ++i)
+                to[histogram[(from[i].key >> (8 * byte)) & 0xFF]++] = from[i];
+            std::swap(from, to);
+        }
+        if (from != &entries[0])
+            entries.swap(scratch);
+    }
+
+private: /******************************* Fields ******************************/
+    std::vector<DrawItem> items;
+    std::vector<Entry> entries, scratch;
+    /// The items of the group submitInstanced() is working on
+    std::vector<const DrawItem*> group, groupScratch;
+    /// Whether items were pushed in key order, so need no sorting
+    bool keysInOrder;
+    /// Whether entries holds the current items in sorted order
+    bool entriesReady;
+    Stats stats;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // RenderQueue_H__
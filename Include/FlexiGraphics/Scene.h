@@ -0,0 +1,436 @@
+#ifndef Scene_H__
+#define Scene_H__
+/**
+ * @file
+ * @brief Defines the Scene class, which owns a scene graph and keeps its world
+ *        transforms up to date.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiGraphics\Visit.h"
+#include "FlexiGraphics\DestructionQueue.h"
+#include "FlexiGraphics\SceneJournal.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief Owns the root of a scene graph and tracks which parts of it need
+ *  their world transforms recomputed.
+ * 
+ * Changing a node's local transform through setLocalTransform() only flags that
+ * node and remembers it; its descendants are implicitly stale. The per-frame
+ * call to updateTransforms() then walks just the flagged subtrees, so the cost
+ * of an update is proportional to the number of nodes under moved nodes rather
+ * than to the size of the scene.
+ * 
+ * Nodes should be attached to a live scene with addChild() rather than
+ * InnerNode::addChild(), so that the new subtree gets its world transforms.
+ * 
+ * A Scene can also serve as the prototype of any number of InstanceNodes in
+ * other scenes. Prototypes are brought up to date when their instances are.
+ * 
+ * Nodes are removed with destroy(), which unlinks them immediately and leaves
+ * the deletion itself to destroyPending(), to be spread over frames.
+ * 
+ * Each node's world bounds enclose its whole subtree. Recomputing a subtree's
+ * transforms also recomputes its bounds, and only flags the ancestors above it
+ * as needing a refit; refitBounds() then revisits just those flagged paths.
+ * 
+ * With journaling on, every change made through the scene is also recorded
+ * in its SceneJournal, for systems that mirror the scene to update from.
+ */
+class Scene
+{
+    Scene(const Scene&);
+    Scene& operator=(const Scene&);
+
+public:
+    Scene() : lastUpdateCount(0), journaling(false) {}
+
+    InnerNode& getRoot() { return root; }
+
+    /// Adds @a child (and its subtree) under @a parent and queues it for update
+    Scene& addChild(InnerNode& parent, Node& child) {
+        parent.addChild(child);
+        markDirty(child);
+        recordChange(child, SceneChange::ADDED);
+        return *this;
+    }
+
+    /// Moves @a node (and its subtree) under @a parent, keeping its local transform
+    Scene& moveChild(InnerNode& parent, Node& node) {
+        InnerNode* const oldParent = node.parent;
+        flexiAssert(oldParent);
+        for (const Node* ancestor = &parent; ancestor; ancestor = ancestor->parent)
+            flexiAssertM(ancestor != &node, "Cannot move a node under itself");
+
+        oldParent->removeChild(node);
+        markBoundsDirty(oldParent);
+        parent.addChild(node);
+        markDirty(node);
+        recordChange(node, SceneChange::MOVED);
+        return *this;
+    }
+
+    /**
+     * @brief Detaches @a node (and its subtree) from the scene in constant time
+     *  and queues it for deletion by destroyPending().
+     * 
+     * Flagged nodes in the subtree stay queued for update; updateTransforms()
+     * drops them when it finds them detached. Until then the subtree is not
+     * deleted.
+     * 
+     * Pooled subtrees are only detached; their NodePool frees them.
+     */
+    void destroy(Node& node) {
+        InnerNode* const parent = node.parent;
+        flexiAssert(parent);
+
+        parent->removeChild(node);
+        markBoundsDirty(parent);
+        recordChange(node, SceneChange::REMOVED);
+        destructionQueue.push(node);
+    }
+
+    /**
+     * @brief Deletes nodes queued by destroy() for roughly @a budgetSeconds.
+     * 
+     * Nodes destroyed since the last updateTransforms() are left alone while
+     * other nodes are still flagged for update.
+     * 
+     * @returns The number of nodes deleted.
+     */
+    unsigned destroyPending(float budgetSeconds) {
+        if (dirtyNodes.empty())
+            destructionQueue.releaseWaiting();
+        return destructionQueue.destroyFor(budgetSeconds);
+    }
+
+    /// @c true if destroyed nodes are still waiting to be deleted
+    bool hasPendingDestruction() const { return !destructionQueue.isEmpty(); }
+
+    /// Sets the local transform of @a node, flagging its subtree as stale
+    void setLocalTransform(Node& node, const math::Matrix4x3& transform) {
+        node.localTransform = transform;
+        markDirty(node);
+    }
+
+    /// Sets the bounds of @a node's own content, in its own space
+    void setLocalBounds(Node& node, const math::BoundingBox& bounds) {
+        node.localBounds = bounds;
+        markBoundsDirty(&node);
+        recordChange(node, SceneChange::BOUNDS);
+    }
+
+    /// Records that @a node's own properties, such as a DrawableNode's mesh,
+    /// were changed directly
+    void markChanged(Node& node) {
+        recordChange(node, SceneChange::PROPERTIES);
+    }
+
+    /**
+     * @brief Starts or stops recording changes in the journal.
+     * 
+     * Off by default; when off, each change costs one extra branch.
+     */
+    void setJournaling(bool enabled) { journaling = enabled; }
+    bool isJournaling() const { return journaling; }
+
+    /// Gets the changes recorded since the journal was last cleared
+    SceneJournal& getJournal() { return changes; }
+
+    /**
+     * @brief Recomputes the world transform of every node under a node whose
+     *  local transform has changed since the last update.
+     * 
+     * Nodes that were flagged beneath another flagged node are skipped, since
+     * they are refreshed as part of their ancestor's subtree. Nodes that are no
+     * longer under the root are unflagged and skipped.
+     */
+    void updateTransforms() {
+        WorldTransformUpdater updater(journaling ? &changes : 0);
+
+        for (std::vector<Node*>::const_iterator it = dirtyNodes.begin();
+             it != dirtyNodes.end(); ++it)
+        {
+            Node& node = **it;
+            if (!node.transformDirty)
+                continue;
+
+            bool dirtyAncestor;
+            if (findTop(node, dirtyAncestor) != &root) {
+                node.transformDirty = false;
+                continue;
+            }
+            if (dirtyAncestor)
+                continue;
+
+            updater.parentWorld = node.parent ? &node.parent->worldTransform : 0;
+            Visit::node(node, updater);
+            markBoundsDirty(node.parent);
+        }
+
+        dirtyNodes.clear();
+        destructionQueue.releaseWaiting();
+        lastUpdateCount = updater.updateCount;
+    }
+
+    /// Gets the number of world transforms recomputed by the last update.
+    unsigned getLastUpdateCount() const { return lastUpdateCount; }
+
+    /**
+     * @brief Refits the world bounds of every node flagged since the last
+     *  refit, visiting only the paths that lead to flagged nodes.
+     */
+    void refitBounds() {
+        if (root.boundsDirty) {
+            BoundsRefitter refitter;
+            Visit::node(root, refitter);
+        }
+    }
+
+    /**
+     * @brief Calls @a visitor for each node whose subtree bounds intersect
+     *  @a frustum, after refitting any stale bounds.
+     * 
+     * @see Visit::visible()
+     */
+    template <typename Visitor>
+    Visitor& visitVisible(const math::Frustum& frustum, Visitor& visitor) {
+        refitBounds();
+        return Visit::visible(root, frustum, visitor);
+    }
+
+    /**
+     * @brief Like visitVisible(), but also descends into the prototypes of
+     *  visible instances, culling their nodes in world space.
+     * 
+     * @a visitor is called as visit(node, context), where @a context is the
+     * InstanceContext the node was reached through, or null for this scene's
+     * own nodes. The same prototype node is visited once per visible instance.
+     */
+    template <typename Visitor>
+    Visitor& visitVisibleInstances(const math::Frustum& frustum, Visitor& visitor) {
+        refitBounds();
+        InstancedCullingTraversal<Visitor> traversal(frustum, visitor);
+        Visit::node(root, traversal);
+        return visitor;
+    }
+
+    /**
+     * @brief Flags @a instance's bounds for refitting after its prototype has
+     *  been changed.
+     * 
+     * Instances pick up their prototype's bounds when their transform is
+     * updated or their bounds are refitted, but are not told when the
+     * prototype changes later.
+     */
+    void refreshInstance(InstanceNode& instance) {
+        markBoundsDirty(&instance);
+    }
+
+private:
+    /// Recomputes world transforms top-down and world bounds bottom-up
+    struct WorldTransformUpdater
+    {
+        const math::Matrix4x3* parentWorld;
+        math::BoundingBox* parentBounds;
+        SceneJournal* journal;
+        unsigned updateCount;
+
+        explicit WorldTransformUpdater(SceneJournal* journal)
+            : parentWorld(0), parentBounds(0), journal(journal), updateCount(0) {}
+
+        void visit(Node& node) {
+            refresh(node);
+            finish(node);
+        }
+
+        void visit(InstanceNode& instance) {
+            syncPrototypeBounds(instance);
+            visit(static_cast<Node&>(instance));
+        }
+
+        void visit(EntityNode& entityNode) {
+            visit(static_cast<Node&>(entityNode));
+            entityNode.syncEntity();
+        }
+
+        void visit(InnerNode& innerNode) {
+            refresh(innerNode);
+
+            const math::Matrix4x3* const grandparentWorld = parentWorld;
+            math::BoundingBox* const grandparentBounds = parentBounds;
+            parentWorld = &innerNode.worldTransform;
+            parentBounds = &innerNode.worldBounds;
+            Visit::children(innerNode, *this);
+            parentWorld = grandparentWorld;
+            parentBounds = grandparentBounds;
+
+            finish(innerNode);
+        }
+
+        void refresh(Node& node) {
+            if (parentWorld)
+                node.worldTransform = node.localTransform * *parentWorld;
+            else
+                node.worldTransform = node.localTransform;
+
+            node.worldBounds = node.localBounds.transformed(node.worldTransform);
+            node.transformDirty = false;
+            ++updateCount;
+            if (journal)
+                journal->record(node, SceneChange::TRANSFORMED);
+        }
+
+        void finish(Node& node) {
+            node.boundsDirty = false;
+            if (parentBounds)
+                parentBounds->extend(node.worldBounds);
+        }
+    };
+
+    /// Recomputes the world bounds of flagged nodes, skipping clean subtrees
+    struct BoundsRefitter
+    {
+        math::BoundingBox* parentBounds;
+
+        BoundsRefitter() : parentBounds(0) {}
+
+        void visit(Node& node) {
+            if (node.boundsDirty) {
+                node.worldBounds = node.localBounds.transformed(node.worldTransform);
+                node.boundsDirty = false;
+            }
+            if (parentBounds)
+                parentBounds->extend(node.worldBounds);
+        }
+
+        void visit(InstanceNode& instance) {
+            if (instance.boundsDirty)
+                syncPrototypeBounds(instance);
+            visit(static_cast<Node&>(instance));
+        }
+
+        void visit(InnerNode& innerNode) {
+            if (innerNode.boundsDirty) {
+                innerNode.worldBounds = innerNode.localBounds.transformed(innerNode.worldTransform);
+
+                math::BoundingBox* const grandparentBounds = parentBounds;
+                parentBounds = &innerNode.worldBounds;
+                Visit::children(innerNode, *this);
+                parentBounds = grandparentBounds;
+
+                innerNode.boundsDirty = false;
+            }
+            if (parentBounds)
+                parentBounds->extend(innerNode.worldBounds);
+        }
+    };
+
+    /// Culls like Visit::visible(), descending into instanced prototypes
+    template <typename Visitor>
+    class InstancedCullingTraversal
+    {
+        const math::Frustum& frustum;
+        Visitor& visitor;
+        unsigned planeMask;
+        const InstanceContext* context;
+
+        InstancedCullingTraversal& operator=(const InstancedCullingTraversal&);
+
+    public:
+        InstancedCullingTraversal(const math::Frustum& frustum, Visitor& visitor)
+            : frustum(frustum), visitor(visitor),
+              planeMask(math::Frustum::ALL_PLANES), context(0) {}
+
+        template <typename N>
+        void visit(N& node) {
+            const unsigned parentMask = planeMask;
+            if (planeMask) {
+                const math::Frustum::Containment containment = context
+                    ? frustum.classify(context->getWorldBounds(node), planeMask)
+                    : frustum.classify(node.getWorldBounds(), planeMask);
+                if (containment == math::Frustum::OUTSIDE) {
+                    planeMask = parentMask;
+                    return;
+                }
+            }
+
+            visitor.visit(node, context);
+            descend(node);
+            planeMask = parentMask;
+        }
+
+    private:
+        void descend(Node&) {}
+        void descend(InnerNode& innerNode) { Visit::children(innerNode, *this); }
+
+        void descend(InstanceNode& instance) {
+            InstanceContext inner;
+            inner.outer = context;
+            inner.instance = &instance;
+            inner.transform = context ? context->getWorldTransform(instance)
+                                      : instance.worldTransform;
+
+            const InstanceContext* const outer = context;
+            context = &inner;
+            Visit::node(instance.prototype->root, *this);
+            context = outer;
+        }
+    };
+
+    /// Brings @a instance's prototype up to date and copies its bounds
+    static void syncPrototypeBounds(InstanceNode& instance) {
+        Scene& prototype = *instance.prototype;
+        if (!prototype.dirtyNodes.empty())
+            prototype.updateTransforms();
+        prototype.refitBounds();
+        instance.localBounds = prototype.root.worldBounds;
+    }
+
+    void recordChange(Node& node, unsigned change) {
+        if (journaling)
+            changes.record(node, change);
+    }
+
+    void markDirty(Node& node) {
+        if (!node.transformDirty) {
+            node.transformDirty = true;
+            dirtyNodes.push_back(&node);
+        }
+    }
+
+    /// Flags @a node and its ancestors, stopping at one that is already flagged
+    static void markBoundsDirty(Node* node) {
+        for (; node && !node->boundsDirty; node = node->parent)
+            node->boundsDirty = true;
+    }
+
+    /// Gets the topmost ancestor of @a node, noting whether any ancestor is
+    /// itself flagged for update
+    static const Node* findTop(const Node& node, bool& dirtyAncestor) {
+        dirtyAncestor = false;
+        const Node* top = &node;
+        for (; top->parent; top = top->parent)
+            dirtyAncestor |= top->parent->transformDirty;
+        return top;
+    }
+
+private: /******************************* Fields ******************************/
+    InnerNode root;
+    std::vector<Node*> dirtyNodes;
+    DestructionQueue destructionQueue;
+    unsigned lastUpdateCount;
+    SceneJournal changes;
+    bool journaling;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // Scene_H__
@@ -0,0 +1,112 @@
+#ifndef SceneJournal_H__
+#define SceneJournal_H__
+/**
+ * @file
+ * @brief Defines SceneJournal, a record of the changes made to a Scene since
+ *        it was last cleared.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <vector>
+#include "FlexiUtil\DebugDefs.h"
+#include "FlexiGraphics\Node.h"
+
+namespace flexi {
+namespace graphics {
+
+/// One node's changes, as recorded by a SceneJournal
+struct SceneChange
+{
+    enum Kind
+    {
+        /// Attached to the scene along with its subtree
+        ADDED       = 1 << 0,
+        /// Detached from the scene along with its subtree; still alive until
+        /// Scene::destroyPending()
+        REMOVED     = 1 << 1,
+        /// Given a new parent, within the same scene
+        MOVED       = 1 << 2,
+        /// World transform and bounds recomputed by Scene::updateTransforms()
+        TRANSFORMED = 1 << 3,
+        /// Local bounds set by Scene::setLocalBounds()
+        BOUNDS      = 1 << 4,
+        /// Reported by Scene::markChanged(), e.g. after editing a drawable
+        PROPERTIES  = 1 << 5,
+
+        STRUCTURE   = ADDED | REMOVED | MOVED
+    };
+
+    Node* node;
+    /// Kinds of change, OR-ed together
+    unsigned changes;
+};
+
+/**
+ * @brief Collects the changes made to a Scene, one entry per changed node,
+ *  so that systems mirroring the scene can apply just those.
+ * 
+ * Changes to a node already in the journal are OR-ed into its entry, so a
+ * node moved many times between clears costs one entry. Structural changes
+ * (adding, removing and moving) always start a new entry, keeping their
+ * order. Subtrees are added and removed through their roots; the nodes under
+ * an added root show up as TRANSFORMED after the next update.
+ * 
+ * Each node remembers its entry by the journal's generation, so clear() is
+ * constant time and never touches nodes, which may have been deleted.
+ * Consumers should read the journal before Scene::destroyPending(), while
+ * REMOVED nodes are still alive.
+ */
+class SceneJournal
+{
+    SceneJournal(const SceneJournal&);
+    SceneJournal& operator=(const SceneJournal&);
+
+public:
+    SceneJournal() : generation(nextGeneration()), recordCount(0) {}
+
+    /// Notes that @a node changed in the ways given by @a changes
+    void record(Node& node, unsigned changes) {
+        ++recordCount;
+        if (node.journalGeneration == generation && !(changes & SceneChange::STRUCTURE)) {
+            entries[node.journalEntry].changes |= changes;
+            return;
+        }
+        node.journalGeneration = generation;
+        node.journalEntry = unsigned(entries.size());
+        const SceneChange entry = { &node, changes };
+        entries.push_back(entry);
+    }
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const SceneChange& operator[](size_t index) const { return entries[index]; }
+
+    /// Gets the number of record() calls since the last clear()
+    unsigned getRecordCount() const { return recordCount; }
+
+    /// Forgets all entries, typically once every consumer has applied them
+    void clear() {
+        entries.clear();
+        generation = nextGeneration();
+        recordCount = 0;
+    }
+
+private:
+    /// Generations are unique across journals, so a node moved between
+    /// scenes cannot match another journal's entry
+    static unsigned nextGeneration() {
+        static unsigned last = 0;
+        return ++last;
+    }
+
+private: /******************************* Fields ******************************/
+    std::vector<SceneChange> entries;
+    unsigned generation;
+    unsigned recordCount;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // SceneJournal_H__
@@ -0,0 +1,153 @@
+#ifndef SceneSnapshot_H__
+#define SceneSnapshot_H__
+/**
+ * @file
+ * @brief Defines SceneSnapshot, a copy of what the renderer needs from a
+ *        Scene, for drawing one frame while the next is simulated.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <vector>
+#include "FlexiGraphics\DrawableNode.h"
+#include "FlexiGraphics\RenderQueue.h"
+#include "FlexiGraphics\Scene.h"
+
+namespace flexi {
+namespace graphics {
+
+/**
+ * @brief The render-relevant state of a Scene as of one simulation step: its
+ *  visible drawables, their world transforms and the view.
+ * 
+ * Captured on the simulation thread and submitted on the render thread,
+ * usually through a util::TripleBuffer<SceneSnapshot>, so that the scene can
+ * be changed for the next frame while this one is drawn. A snapshot holds
+ * copies of the transforms its draws use and nothing in it points back into
+ * the Scene. Draws are sorted during capture, so the render thread only
+ * submits them.
+ * 
+ * Capturing reuses the snapshot's storage, so once a snapshot has held its
+ * largest frame it no longer allocates.
+ */
+class SceneSnapshot
+{
+public:
+    /// Where the snapshot was captured from; orders draws by depth
+    struct View
+    {
+        math::Vector3f eye;
+        /// The unit view direction
+        math::Vector3f forward;
+        float nearClip, farClip;
+
+        View() : eye(0, 0, 0), forward(0, 0, -1), nearClip(1), farClip(1000) {}
+    };
+
+    SceneSnapshot() : frame(0) {}
+
+    /// Captures the drawables of @a scene whose bounds intersect @a frustum
+    void capture(Scene& scene, const math::Frustum& frustum, const View& view, unsigned frame) {
+        begin(view, frame);
+        Capture capture(*this, false);
+        scene.visitVisible(frustum, capture);
+        finish();
+    }
+
+    /// Captures every drawable of @a scene
+    void capture(Scene& scene, const View& view, unsigned frame) {
+        begin(view, frame);
+        scene.refitBounds();
+        Capture capture(*this, true);
+        Visit::node(scene.getRoot(), capture);
+        finish();
+    }
+
+    /// Gets the frame number given to the last capture()
+    unsigned getFrame() const { return frame; }
+    const View& getView() const { return view; }
+
+    /// Gets the number of draws captured
+    size_t size() const { return queue.size(); }
+
+    /// Gets the @a index-th draw in key order
+    const DrawItem& operator[](size_t index) { return queue[index]; }
+
+    /// Passes the captured draws to @a submitter; see RenderQueue::submit()
+    template <typename Submitter>
+    void submit(Submitter& submitter) { queue.submit(submitter); }
+
+    /// Passes the captured draws to @a submitter in instanced groups; see
+    /// RenderQueue::submitInstanced()
+    template <typename Submitter>
+    void submitInstanced(Submitter& submitter) { queue.submitInstanced(submitter); }
+
+    /// Gets the state changes made and avoided by the last submit()
+    const RenderQueue::Stats& getStats() const { return queue.getStats(); }
+
+private:
+    /// Copies each drawable it reaches; descends itself unless a culling
+    /// traversal does so for it
+    class Capture
+    {
+        SceneSnapshot& snapshot;
+        DrawQueueBuilder builder;
+        bool descending;
+
+        Capture& operator=(const Capture&);
+
+    public:
+        Capture(SceneSnapshot& snapshot, bool descending)
+            : snapshot(snapshot),
+              builder(snapshot.queue, snapshot.view.eye, snapshot.view.forward,
+                      snapshot.view.nearClip, snapshot.view.farClip),
+              descending(descending) {}
+
+        template <typename N>
+        void visit(N& node) {
+            add(&node);
+            if (descending)
+                descend(node);
+        }
+
+    private:
+        void add(Node*) {}
+        void add(DrawableNode* node) {
+            snapshot.items.push_back(builder.makeItem(*node));
+            snapshot.transforms.push_back(node->getWorldTransform());
+        }
+
+        void descend(Node&) {}
+        void descend(InnerNode& innerNode) { Visit::children(innerNode, *this); }
+    };
+
+    void begin(const View& view, unsigned frame) {
+        this->view = view;
+        this->frame = frame;
+        queue.clear();
+        items.clear();
+        transforms.clear();
+    }
+
+    /// Points the draws at the copied transforms, now that they have stopped
+    /// moving, and sorts them
+    void finish() {
+        for (size_t i = 0; i < items.size(); ++i) {
+            items[i].transform = &transforms[i];
+            queue.push(items[i]);
+        }
+        queue.sort();
+    }
+
+private: /******************************* Fields ******************************/
+    RenderQueue queue;
+    std::vector<DrawItem> items;
+    std::vector<math::Matrix4x3> transforms;
+    View view;
+    unsigned frame;
+};
+
+} // namespace graphics
+} // namespace flexi
+
+#endif // SceneSnapshot_H__
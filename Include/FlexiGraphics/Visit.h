@@ -14,6 +14,10 @@
 namespace flexi {
 namespace graphics {
 
+namespace internal {
+template <typename Visitor> class CullingTraversal;
+}
+
 struct Visit {
     template <typename Visitor>
     static Visitor& node(Node& node, Visitor& visitor) {
@@ -29,8 +33,59 @@ struct Visit {
         }
         return visitor;
     }
+
+    /**
+     * @brief Calls @a visitor for @a node and each of its descendants whose
+     *  world bounds intersect @a frustum.
+     * 
+     * Unlike node(), the traversal itself recurses, so visitors used here
+     * should not call children(). Subtrees outside the frustum are rejected
+     * without visiting any of their nodes, and subtrees found entirely inside
+     * a plane are not tested against that plane again.
+     */
+    template <typename Visitor>
+    static Visitor& visible(Node& node, const math::Frustum& frustum, Visitor& visitor) {
+        internal::CullingTraversal<Visitor> traversal(frustum, visitor);
+        internal::applyVisitor(traversal, node);
+        return visitor;
+    }
+};
+
+namespace internal {
+
+template <typename Visitor>
+class CullingTraversal
+{
+    const math::Frustum& frustum;
+    Visitor& visitor;
+    unsigned planeMask;
+
+    CullingTraversal& operator=(const CullingTraversal&);
+
+public:
+    CullingTraversal(const math::Frustum& frustum, Visitor& visitor)
+        : frustum(frustum), visitor(visitor), planeMask(math::Frustum::ALL_PLANES) {}
+
+    template <typename N>
+    void visit(N& node) {
+        const unsigned parentMask = planeMask;
+        if (planeMask && frustum.classify(node.getWorldBounds(), planeMask) == math::Frustum::OUTSIDE) {
+            planeMask = parentMask;
+            return;
+        }
+
+        visitor.visit(node);
+        descend(node);
+        planeMask = parentMask;
+    }
+
+private:
+    void descend(Node&) {}
+    void descend(InnerNode& innerNode) { Visit::children(innerNode, *this); }
 };
 
+} // namespace internal
+
 } // namespace graphics
 } // namespace flexi
 
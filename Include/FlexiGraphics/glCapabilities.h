@@ -0,0 +1,82 @@
+//
+//  glCapabilities.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glCapabilities_h
+#define Flexigin_glCapabilities_h
+
+#include <string>
+#include "OpenGLPlatform.h"
+#include "Util.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+/// What the current context supports beyond GL 2.1, for choosing between
+/// fast paths and their fallbacks
+struct Capabilities {
+    /// Queries the context current on the first call; later calls return the
+    /// same answers
+    static const Capabilities& current();
+
+    bool hasExtension(const char* name) const;
+    bool hasVersion(unsigned major, unsigned minor) const {
+        return m_major_version > major || (m_major_version == major && m_minor_version >= minor);
+    }
+
+    unsigned majorVersion() const { return m_major_version; }
+    unsigned minorVersion() const { return m_minor_version; }
+
+    /// Vertex array objects, from GL 3.0, ARB_vertex_array_object or
+    /// APPLE_vertex_array_object
+    bool vertexArrayObjects() const { return m_vertex_array_objects; }
+
+    /// Immutable buffer storage, from GL 4.4 or ARB_buffer_storage
+    bool bufferStorage() const { return m_buffer_storage; }
+
+    /// Uniform buffer objects, from GL 3.1 or ARB_uniform_buffer_object
+    bool uniformBuffers() const { return m_uniform_buffers; }
+
+    /// Retrieving and reloading linked programs, from GL 4.1 or
+    /// ARB_get_program_binary, with at least one binary format
+    bool programBinaries() const { return m_program_binaries; }
+
+    /// Instanced draws with per-instance attributes, from GL 3.3 or
+    /// ARB_instanced_arrays with GL 3.1 or ARB_draw_instanced
+    bool instancedArrays() const { return m_instanced_arrays; }
+
+    /// Many indexed draws from one buffer of commands, each with its own base
+    /// vertex and base instance, from GL 4.3 or ARB_multi_draw_indirect with
+    /// ARB_base_instance
+    bool multiDrawIndirect() const { return m_multi_draw_indirect; }
+
+    /// GPU timestamps and elapsed-time queries, from GL 3.3 or ARB_timer_query
+    bool timerQueries() const { return m_timer_queries; }
+
+    /// Non-blocking compile and link status queries, from
+    /// KHR_parallel_shader_compile or ARB_parallel_shader_compile
+    bool parallelShaderCompile() const { return m_parallel_shader_compile; }
+
+private:
+    Capabilities();
+
+private:
+    unsigned m_major_version, m_minor_version;
+    /// Every extension name, each followed by a space
+    std::string m_extensions;
+    bool m_vertex_array_objects;
+    bool m_buffer_storage;
+    bool m_uniform_buffers;
+    bool m_program_binaries;
+    bool m_instanced_arrays;
+    bool m_multi_draw_indirect;
+    bool m_timer_queries;
+    bool m_parallel_shader_compile;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
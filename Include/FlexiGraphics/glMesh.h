@@ -0,0 +1,285 @@
+//
+//  glMesh.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glMesh_h
+#define Flexigin_glMesh_h
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include "OpenGLPlatform.h"
+#include "Util.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+/// What a vertex attribute feeds: a fixed-function array or a generic
+/// shader attribute
+enum class VertexSemantic {
+    POSITION,
+    NORMAL,
+    COLOR,
+    TEXCOORD,
+    GENERIC
+};
+
+struct VertexAttribute {
+    VertexSemantic semantic;
+    /// Components per vertex, 1 to 4
+    GLint size;
+    GLenum type;
+    /// Byte offset within a vertex
+    GLsizei offset;
+    /// Attribute index, for GENERIC attributes
+    GLuint index;
+    /// Whether integer GENERIC data is scaled to [0,1] or [-1,1]
+    GLboolean normalized;
+};
+
+/// How the attributes of one interleaved vertex are laid out
+struct VertexLayout {
+    GLsizei stride;
+    std::vector<VertexAttribute> attributes;
+
+    VertexLayout(GLsizei stride, std::initializer_list<VertexAttribute> attributes)
+        : stride(stride), attributes(attributes)
+    {}
+};
+
+enum class BufferUsage {
+    /// Uploaded once and never changed; the driver may keep it in video memory
+    IMMUTABLE,
+    /// Replaced wholesale, typically every frame
+    STREAMING
+};
+
+/// Indexed geometry kept in buffer objects, with its vertex layout captured
+/// in a vertex array object so that binding it is one call
+struct Mesh {
+    typedef std::unique_ptr<Mesh> Ptr;
+
+    /// Uploads the vertices and indices. Returns null if there is nothing to
+    /// draw.
+    static Ptr make(const VertexLayout& layout,
+                    const void* vertices, GLsizei vertex_count,
+                    const void* indices, GLenum index_type, GLsizei index_count,
+                    BufferUsage usage = BufferUsage::IMMUTABLE,
+                    GLenum primitive = GL_TRIANGLES);
+
+    /// Makes this mesh's buffers and layout current
+    void bind();
+    void unbind();
+
+    /// Draws the whole mesh; it must be bound
+    void draw() const {
+        glDrawElements(m_primitive, m_index_count, m_index_type, 0);
+    }
+
+    /// Draws @a count copies of the whole mesh, for per-instance attributes
+    /// such as an InstanceBuffer's to tell apart; it must be bound
+    void drawInstanced(GLsizei count) const {
+        glDrawElementsInstanced(m_primitive, m_index_count, m_index_type, 0, count);
+    }
+
+    /// Replaces the contents of a STREAMING mesh. The old buffers are orphaned
+    /// rather than overwritten, so draws still using them do not stall this
+    /// call.
+    void update(const void* vertices, GLsizei vertex_count,
+                const void* indices, GLsizei index_count);
+
+    GLsizei vertexCount() const { return m_vertex_count; }
+    GLsizei indexCount() const { return m_index_count; }
+    GLenum indexType() const { return m_index_type; }
+    BufferUsage usage() const { return m_usage; }
+
+    GLuint vertexBuffer() const { return m_vertex_buffer; }
+    GLuint indexBuffer() const { return m_index_buffer; }
+
+    ~Mesh();
+
+private:
+    Mesh(const VertexLayout& layout, GLenum index_type, BufferUsage usage, GLenum primitive);
+    Mesh(const Mesh&);
+    Mesh& operator=(const Mesh&);
+
+    void upload(GLenum target, GLuint buffer, const void* data, GLsizeiptr size);
+
+private:
+    VertexLayout m_layout;
+    GLenum m_index_type;
+    BufferUsage m_usage;
+    GLenum m_primitive;
+
+    GLuint m_vertex_array;
+    GLuint m_vertex_buffer;
+    GLuint m_index_buffer;
+    GLsizei m_vertex_count;
+    GLsizei m_index_count;
+};
+
+/// Per-instance vertex attributes, such as transforms, streamed into a
+/// buffer for instanced draws. Its attributes must all be GENERIC; each is
+/// read once per instance rather than once per vertex.
+struct InstanceBuffer {
+    typedef std::unique_ptr<InstanceBuffer> Ptr;
+
+    /// Returns null if the context cannot draw instanced arrays
+    static Ptr make(const VertexLayout& layout);
+
+    /// The layout of a math::Matrix4x3, as produced by the scene's transform
+    /// updates: its x, y and z axes and translation, as vec3 attributes at
+    /// @a first_index and the three indices after it
+    static VertexLayout transforms(GLuint first_index);
+
+    /// Replaces the instances, orphaning the old storage so that draws still
+    /// reading it do not stall this call
+    void update(const void* instances, GLsizei count);
+
+    /// Points the instance attributes at this buffer; call after binding the
+    /// mesh, since a vertex array object records them
+    void bind() { bind(m_buffer, 0); }
+    /// Points the instance attributes at @a offset in @a buffer instead, such
+    /// as a RingBuffer allocation holding this frame's instances
+    void bind(GLuint buffer, GLintptr offset);
+    void unbind();
+
+    GLsizei count() const { return m_count; }
+
+    ~InstanceBuffer();
+
+private:
+    explicit InstanceBuffer(const VertexLayout& layout);
+    InstanceBuffer(const InstanceBuffer&);
+    InstanceBuffer& operator=(const InstanceBuffer&);
+
+private:
+    VertexLayout m_layout;
+    GLuint m_buffer;
+    /// Bytes the buffer's storage holds
+    GLsizeiptr m_capacity;
+    GLsizei m_count;
+};
+
+/// Many meshes sharing one vertex buffer and one index buffer, so that
+/// drawing any of them needs no rebinding and a DrawIndirectBuffer can draw
+/// several at once. Every mesh has the pool's layout and index type.
+struct MeshPool {
+    typedef std::unique_ptr<MeshPool> Ptr;
+
+    /// Where a mesh's indices sit in the pool
+    struct Range {
+        GLuint first_index;
+        GLuint index_count;
+        /// Added to each index, since indices count from the mesh's first vertex
+        GLint base_vertex;
+    };
+
+    /// Allocates room for @a vertex_capacity vertices and @a index_capacity
+    /// indices; the pool does not grow
+    static Ptr make(const VertexLayout& layout, GLenum index_type,
+                    GLsizei vertex_capacity, GLsizei index_capacity,
+                    GLenum primitive = GL_TRIANGLES);
+
+    /// Copies a mesh into the pool. Returns false, leaving @a range alone, if
+    /// it does not fit.
+    bool add(const void* vertices, GLsizei vertex_count,
+             const void* indices, GLsizei index_count, Range* range);
+
+    /// Makes the pool's buffers and layout current
+    void bind();
+    void unbind();
+
+    GLenum indexType() const { return m_index_type; }
+    GLenum primitive() const { return m_primitive; }
+    GLsizei vertexCount() const { return m_vertex_count; }
+    GLsizei indexCount() const { return m_index_count; }
+
+    ~MeshPool();
+
+private:
+    MeshPool(const VertexLayout& layout, GLenum index_type, GLenum primitive);
+    MeshPool(const MeshPool&);
+    MeshPool& operator=(const MeshPool&);
+
+private:
+    VertexLayout m_layout;
+    GLenum m_index_type;
+    GLenum m_primitive;
+
+    GLuint m_vertex_array;
+    GLuint m_vertex_buffer;
+    GLuint m_index_buffer;
+    GLsizei m_vertex_count, m_vertex_capacity;
+    GLsizei m_index_count, m_index_capacity;
+};
+
+/// A frame's draws of MeshPool ranges, written into one indirect buffer and
+/// issued with one glMultiDrawElementsIndirect per bucket of draws that
+/// share state.
+///
+/// Each frame: clear(), then startBucket() whenever the program or material
+/// changes and add() each draw; then upload() once and draw() each bucket
+/// after binding its state. Draws read their per-instance attributes from
+/// @a base_instance onwards, so a single InstanceBuffer can hold every
+/// draw's instances.
+struct DrawIndirectBuffer {
+    typedef std::unique_ptr<DrawIndirectBuffer> Ptr;
+
+    /// The command layout glMultiDrawElementsIndirect reads
+    struct Command {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    struct Stats {
+        /// Commands drawn and the multi-draw calls that drew them
+        unsigned commands;
+        unsigned multi_draws;
+    };
+
+    /// Returns null if the context cannot draw multiple indirect commands;
+    /// callers then draw each range directly
+    static Ptr make();
+
+    void clear();
+    /// Starts a new bucket, unless the current one is still empty. Returns
+    /// the index of the bucket that add() now fills.
+    unsigned startBucket();
+    void add(const MeshPool::Range& range, GLuint instance_count, GLuint base_instance);
+
+    /// Replaces the buffer's contents with every command added since clear()
+    void upload();
+    /// Draws @a bucket's commands with one call; the pool must be bound
+    void draw(unsigned bucket, const MeshPool& pool);
+
+    unsigned bucketCount() const { return unsigned(m_buckets.size()); }
+    /// Counts since clear()
+    const Stats& stats() const { return m_stats; }
+
+    ~DrawIndirectBuffer();
+
+private:
+    DrawIndirectBuffer();
+    DrawIndirectBuffer(const DrawIndirectBuffer&);
+    DrawIndirectBuffer& operator=(const DrawIndirectBuffer&);
+
+private:
+    GLuint m_buffer;
+    /// Bytes the buffer's storage holds
+    GLsizeiptr m_capacity;
+    std::vector<Command> m_commands;
+    /// Index of each bucket's first command
+    std::vector<size_t> m_buckets;
+    Stats m_stats;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
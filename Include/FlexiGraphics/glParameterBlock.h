@@ -0,0 +1,96 @@
+//
+//  glParameterBlock.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glParameterBlock_h
+#define Flexigin_glParameterBlock_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "OpenGLPlatform.h"
+#include "Util.h"
+#include "glProgram.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+/// A member of a uniform block, resolved once by ParameterBlock::field()
+template <typename T>
+struct BlockField {
+    GLint offset;
+
+    BlockField() : offset(-1) {}
+    explicit BlockField(GLint offset) : offset(offset) {}
+
+    bool valid() const { return offset >= 0; }
+};
+
+/// The contents of one uniform block, kept in a uniform buffer object.
+/// Fields are set in a CPU-side copy, and upload() sends everything that
+/// changed in a single call, so that a program's per-frame or per-material
+/// parameters cost one upload and one bind rather than a glUniform call each.
+///
+/// The layout is taken from the program the block is made from. Programs
+/// that share a block should declare it layout(std140), so that they agree
+/// on it, and bind it to the same point; matrices must be column-major, the
+/// default.
+struct ParameterBlock {
+    typedef std::unique_ptr<ParameterBlock> Ptr;
+
+    /// Binding points by convention, shared by every program
+    enum Binding {
+        FRAME_BINDING    = 0,
+        MATERIAL_BINDING = 1
+    };
+
+    /// Makes a buffer for @a program's block called @a block_name, and has
+    /// the program read that block from @a binding. Returns null if the
+    /// program has no such block or the context lacks uniform buffers.
+    static Ptr make(Program& program, const char* block_name, GLuint binding);
+
+    template <typename T>
+    BlockField<T> field(const char* name) const {
+        return BlockField<T>(findOffset(name, UniformType<T>::value, sizeof(T)));
+    }
+
+    /// Sets a field in the CPU-side copy; invalid fields are ignored
+    template <typename T>
+    void set(BlockField<T> field, const T& value) {
+        if (field.valid()) {
+            write(field.offset, &value, sizeof value);
+        }
+    }
+
+    /// Sends the fields set since the last upload to the buffer
+    void upload();
+    /// Uploads any changes and binds the buffer to the block's binding point
+    void bind();
+
+    GLuint binding() const { return m_binding; }
+    GLsizeiptr size() const { return m_size; }
+
+    ~ParameterBlock();
+
+private:
+    ParameterBlock(const Program& program, const UniformBlockInfo& block, GLuint binding);
+
+    GLint findOffset(const char* name, GLenum type, size_t size) const;
+    void write(GLint offset, const void* value, size_t size);
+
+private:
+    GLuint m_buffer;
+    GLuint m_binding;
+    GLsizeiptr m_size;
+    std::unique_ptr<uint8_t[]> m_data;
+    /// The byte range changed since the last upload; empty if begin >= end
+    GLsizeiptr m_dirty_begin, m_dirty_end;
+    std::vector<UniformInfo> m_fields;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
@@ -0,0 +1,141 @@
+//
+//  glProfiler.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glProfiler_h
+#define Flexigin_glProfiler_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "OpenGLPlatform.h"
+#include "Util.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+/// Times named, nested scopes of each frame on both the CPU and the GPU, so
+/// that one timeline shows when the CPU issued a pass and when the GPU ran it.
+///
+/// Each scope puts a GL_TIMESTAMP query at its beginning and end; unlike
+/// GL_TIME_ELAPSED queries, timestamps may nest. Queries come from a pool per
+/// frame in flight, and a frame's results are read back when its pool comes
+/// round again, several frames later, by which time the GPU has long since
+/// finished it. Results that are still not ready are dropped rather than
+/// waited for, so profiling never stalls the pipeline.
+///
+/// GPU timestamps are moved onto the CPU clock by comparing the two when the
+/// profiler is made and at each report(), so the timeline is only as exact
+/// as that comparison; durations on each clock are exact.
+struct GpuProfiler {
+    typedef std::unique_ptr<GpuProfiler> Ptr;
+
+    /// Frames between issuing a frame's queries and reading them back
+    static const unsigned DEFAULT_LATENCY = 3;
+
+    /// One scope of a frame, in milliseconds since the frame began on the CPU
+    struct ScopeTiming {
+        const char* name;
+        /// Scopes open around this one
+        unsigned depth;
+        double cpu_begin, cpu_end;
+        double gpu_begin, gpu_end;
+    };
+
+    /// Begins and ends a scope with its own lifetime; a null profiler is
+    /// allowed, so that callers need not check whether profiling is on
+    struct Scope {
+        Scope(GpuProfiler* profiler, const char* name) : profiler(profiler) {
+            if (profiler) {
+                profiler->begin(name);
+            }
+        }
+        ~Scope() {
+            if (profiler) {
+                profiler->end();
+            }
+        }
+
+    private:
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+
+        GpuProfiler* profiler;
+    };
+
+    /// Returns null if the context lacks timer queries
+    static Ptr make(unsigned latency = DEFAULT_LATENCY);
+
+    void beginFrame();
+    void endFrame();
+
+    /// Opens a scope within the current frame. @a name is kept rather than
+    /// copied, so it must outlive the profiler; string literals are best.
+    void begin(const char* name);
+    void end();
+
+    /// The newest frame read back, in the order its scopes began
+    const std::vector<ScopeTiming>& lastFrame() const { return m_last_frame; }
+
+    /// Logs the average of each scope over the frames read back since the
+    /// last report, as a timeline of both clocks, and starts a new average
+    void report();
+
+    ~GpuProfiler();
+
+private:
+    explicit GpuProfiler(unsigned latency);
+    GpuProfiler(const GpuProfiler&);
+    GpuProfiler& operator=(const GpuProfiler&);
+
+    /// Matches the GPU clock to the CPU clock
+    void calibrate();
+    /// Reads back the frame that last used @a pool, if its results are in
+    void collect(unsigned pool);
+
+private:
+    /// A scope waiting for its queries' results
+    struct PendingScope {
+        const char* name;
+        unsigned depth;
+        int64_t cpu_begin, cpu_end;
+    };
+
+    /// The queries of one frame in flight; scope i uses queries 2i and 2i + 1
+    struct QueryPool {
+        std::vector<GLuint> queries;
+        std::vector<PendingScope> scopes;
+        int64_t cpu_start;
+        /// Queries finish in the order they were issued, so once this one
+        /// has a result they all do
+        GLuint last_query;
+    };
+
+    /// A scope's running sums, for report()
+    struct ScopeTotal {
+        const char* name;
+        unsigned depth;
+        unsigned count;
+        double cpu_begin, cpu_time;
+        double gpu_begin, gpu_time;
+    };
+
+    std::vector<QueryPool> m_pools;
+    unsigned m_frame;
+    bool m_in_frame;
+    std::vector<unsigned> m_open_scopes;
+    /// Added to GPU timestamps to put them on the CPU clock, in nanoseconds
+    int64_t m_gpu_to_cpu;
+
+    std::vector<ScopeTiming> m_last_frame;
+    std::vector<ScopeTotal> m_totals;
+    unsigned m_frames_collected;
+    unsigned m_frames_dropped;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
@@ -11,8 +11,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "OpenGLPlatform.h"
+#include "Timer.h"
 #include "Util.h"
+#include "FlexiMath.h"
 
 OPEN_FLEXI_NAMESPACE2(graphics, gl)
 
@@ -22,6 +27,44 @@ enum class ShaderStage {
     COUNT
 };
 
+/// The GL type a uniform must have to be set from a T
+template <typename T> struct UniformType;
+template <> struct UniformType<float>               { static const GLenum value = GL_FLOAT; };
+template <> struct UniformType<GLint>               { static const GLenum value = GL_INT; };
+template <> struct UniformType<math::Vector3f>      { static const GLenum value = GL_FLOAT_VEC3; };
+template <> struct UniformType<math::Vector4f>      { static const GLenum value = GL_FLOAT_VEC4; };
+template <> struct UniformType<math::Matrix4x4>     { static const GLenum value = GL_FLOAT_MAT4; };
+
+/// A uniform found when its program was linked. Uniforms in the default
+/// block have a location; those in a uniform block have a block index and
+/// an offset into it instead.
+struct UniformInfo {
+    std::string name;
+    GLenum type;
+    GLint size;
+    GLint location;
+    GLint block;
+    GLint offset;
+};
+
+struct UniformBlockInfo {
+    std::string name;
+    GLuint index;
+    GLint data_size;
+};
+
+/// A uniform in the default block, resolved once by Program::parameter() so
+/// that setting it needs no name lookup
+template <typename T>
+struct Parameter {
+    GLint location;
+
+    Parameter() : location(-1) {}
+    explicit Parameter(GLint location) : location(location) {}
+
+    bool valid() const { return location >= 0; }
+};
+
 struct Program {
     typedef std::unique_ptr<Program> Ptr;
 
@@ -39,34 +82,156 @@ struct Program {
         return program;
     }
 
+    /// Makes this the current program through the StateCache, so that
+    /// activating the current program again costs no GL calls
     bool activate();
     bool deactivate();
 
+    /// Resolves the uniform called @a name, or returns an invalid handle if
+    /// the program has none of that name and type, as when the compiler
+    /// optimized it away. Samplers are set as GLints.
+    template <typename T>
+    Parameter<T> parameter(const char* name) const {
+        return Parameter<T>(findLocation(name, UniformType<T>::value));
+    }
+
+    /// Sets a parameter of this program, which must be active. Invalid
+    /// handles are ignored.
+    void set(Parameter<float> parameter, float value);
+    void set(Parameter<GLint> parameter, GLint value);
+    void set(Parameter<math::Vector3f> parameter, const math::Vector3f& value);
+    void set(Parameter<math::Vector4f> parameter, const math::Vector4f& value);
+    void set(Parameter<math::Matrix4x4> parameter, const math::Matrix4x4& value);
+
+    /// The active uniforms and uniform blocks, as reflected at link time
+    const std::vector<UniformInfo>& uniforms() const { return m_uniforms; }
+    const std::vector<UniformBlockInfo>& uniformBlocks() const { return m_uniform_blocks; }
+    const UniformInfo* findUniform(const char* name) const;
+    const UniformBlockInfo* findUniformBlock(const char* name) const;
+
+    /// Has the block called @a name read from uniform buffer binding point
+    /// @a binding. Returns false if the program has no such block.
+    bool bindUniformBlock(const char* name, GLuint binding);
+
     ~Program();
 
 private:
     friend class ProgramBuilder;
+    friend class ProgramBatch;
     Program(GLuint program_handle);
     Program(const char* vertex_shader, const char* fragment_shader);
 
+    void reflect();
+    GLint findLocation(const char* name, GLenum type) const;
+
 private:
     GLuint m_program_handle;
+    std::vector<UniformInfo> m_uniforms;
+    std::vector<UniformBlockInfo> m_uniform_blocks;
 };
 
 
+struct ProgramBinaryCache;
+
+/// Vertex attribute indices to bind by name before linking
+typedef std::vector<std::pair<GLuint, std::string>> AttributeBindings;
+
 struct ProgramBuilder {
     typedef std::unique_ptr<GLchar[]> ErrorMessagePtr;
 
     ProgramBuilder();
 
+    /// Has Link() try @a cache before compiling, and store what it builds
+    /// there. Compilation is then put off until Link(), since a cached
+    /// program needs none, so SetShader() reports no errors.
+    void SetCache(ProgramBinaryCache* cache) { m_cache = cache; }
+
     ErrorMessagePtr SetShader(ShaderStage stage, const char* shader_text);
+    /// Has the vertex attribute called @a name read from @a index, rather
+    /// than from wherever the linker puts it; takes effect at Link()
+    void BindAttribute(GLuint index, const char* name);
     ErrorMessagePtr Link();
 
     Program::Ptr Build();
 
 private:
+    ErrorMessagePtr Compile(ShaderStage stage);
+
+private:
+    ProgramBinaryCache* m_cache;
     GLuint m_program_handle;
     GLuint m_shader_handle[static_cast<unsigned>(ShaderStage::COUNT)];
+    std::string m_shader_text[static_cast<unsigned>(ShaderStage::COUNT)];
+    AttributeBindings m_attributes;
+};
+
+/// Builds many programs at once without blocking on the driver.
+///
+/// Add() submits a program's compile and link and returns straight away,
+/// leaving the driver free to work on every program at once. Poll() then
+/// collects finished programs; with KHR_parallel_shader_compile it only
+/// asks whether each is done, so a loading screen or editor can call it
+/// every frame without stalling. Without the extension, status queries
+/// block until the driver finishes, so Poll() completes programs one at a
+/// time until its budget runs out.
+///
+/// Like ProgramBuilder, a batch must be used on the thread whose context
+/// it builds for.
+struct ProgramBatch {
+    typedef unsigned Handle;
+    typedef std::unique_ptr<GLchar[]> ErrorMessagePtr;
+
+    enum class Status {
+        PENDING,
+        READY,
+        FAILED,
+        TAKEN
+    };
+
+    /// Loads programs from @a cache, if given, when it has them, and
+    /// stores the ones built from source there
+    explicit ProgramBatch(ProgramBinaryCache* cache = 0);
+    ~ProgramBatch();
+
+    /// Submits a program; @a attributes are bound as by
+    /// ProgramBuilder::BindAttribute()
+    Handle Add(const char* vertex_shader, const char* fragment_shader,
+               const AttributeBindings& attributes = AttributeBindings());
+
+    /// Collects finished programs and returns how many are still pending.
+    /// When status queries would block, completes programs until about
+    /// @a budget_seconds have passed, and always at least one.
+    unsigned Poll(float budget_seconds = 0);
+    /// Blocks until every program is done
+    void Finish();
+
+    Status GetStatus(Handle handle) const { return m_entries[handle].status; }
+    unsigned PendingCount() const { return m_pending; }
+
+    /// Takes the built program, blocking first if it is still pending.
+    /// Returns null and fills in @a error if the program failed to build.
+    Program::Ptr Take(Handle handle, ErrorMessagePtr* error = 0);
+
+private:
+    struct Entry {
+        GLuint shader_handle[static_cast<unsigned>(ShaderStage::COUNT)];
+        GLuint program_handle;
+        uint64_t key;
+        Status status;
+        ErrorMessagePtr error;
+        /// Runs from Add() until the program is found complete, which is
+        /// the build time given to the cache
+        util::Timer build_timer;
+    };
+
+    bool isComplete(const Entry& entry) const;
+    void complete(Entry& entry);
+    void deleteShaders(Entry& entry);
+
+private:
+    ProgramBinaryCache* m_cache;
+    std::vector<Entry> m_entries;
+    unsigned m_pending;
 };
 
 CLOSE_FLEXI_NAMESPACE2()
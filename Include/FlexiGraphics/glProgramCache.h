@@ -0,0 +1,73 @@
+//
+//  glProgramCache.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glProgramCache_h
+#define Flexigin_glProgramCache_h
+
+#include <cstdint>
+#include <string>
+#include "OpenGLPlatform.h"
+#include "Util.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+/// Keeps linked programs on disk, one file per program, so that later runs
+/// can load them with glProgramBinary instead of compiling and linking from
+/// source. Programs are keyed by a hash of their sources and of the driver's
+/// vendor, renderer and version strings, so that changing either rebuilds
+/// them. Drivers may still reject a binary, such as after an update which
+/// kept its version string; load() then fails and the caller builds from
+/// source as usual.
+///
+/// Does nothing if the context cannot retrieve program binaries.
+struct ProgramBinaryCache {
+    /// Loads and build counts and times since the cache was made
+    struct Stats {
+        unsigned hits;
+        unsigned misses;
+        /// Binaries found on disk but rejected by the driver
+        unsigned rejected;
+        unsigned stores;
+        float load_seconds;
+        float build_seconds;
+    };
+
+    /// @a directory must exist; files are named by key within it. Make the
+    /// cache with the context current, to read the driver's identity.
+    explicit ProgramBinaryCache(const std::string& directory);
+
+    bool enabled() const;
+
+    /// Hashes @a count stage sources, null for unused stages, with the
+    /// driver's identity
+    uint64_t key(const char* const* sources, unsigned count) const;
+
+    /// Creates a program from the binary stored under @a key, or returns 0
+    GLuint load(uint64_t key);
+    /// Stores the binary of @a program, which must have been linked with
+    /// GL_PROGRAM_BINARY_RETRIEVABLE_HINT set, and records that it took
+    /// @a build_seconds to build from source
+    void store(uint64_t key, GLuint program, float build_seconds);
+
+    const Stats& stats() const { return m_stats; }
+    /// Logs the time spent loading and building programs
+    void report() const;
+
+private:
+    std::string path(uint64_t key) const;
+
+private:
+    std::string m_directory;
+    /// Hash of the driver's identity, which every key starts from
+    uint64_t m_driver_hash;
+    Stats m_stats;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
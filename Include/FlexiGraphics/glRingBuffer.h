@@ -0,0 +1,113 @@
+//
+//  glRingBuffer.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glRingBuffer_h
+#define Flexigin_glRingBuffer_h
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include "OpenGLPlatform.h"
+#include "Timer.h"
+#include "Util.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+/// Streams per-frame data, such as transforms, light parameters or particle
+/// vertices, through one buffer that stays mapped for its whole life.
+///
+/// allocate() hands out write pointers in order around the buffer; endFrame()
+/// puts a fence after the frame's draws. The CPU only waits on a fence when
+/// it is about to write over data that an unfinished frame may still read,
+/// so a buffer that holds a few frames' worth never stalls. Unlike
+/// glBufferData and glBufferSubData, writes are plain memory stores and never
+/// sync with the driver.
+///
+/// The mapping is coherent, so no flush is needed between writing and
+/// drawing.
+struct RingBuffer {
+    typedef std::unique_ptr<RingBuffer> Ptr;
+
+    struct Allocation {
+        /// Where to write; null if the request did not fit
+        void* data;
+        /// Where the data sits in buffer(), for attribute pointers or
+        /// glBindBufferRange
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    struct Stats {
+        /// Frames that allocated anything
+        unsigned frames;
+        /// Waits on a fence that had not yet signalled, and the time spent
+        unsigned stalls;
+        double stall_seconds;
+        /// Bytes used over every frame and by the busiest one, counting
+        /// alignment padding and space skipped at the end of the buffer
+        uint64_t bytes;
+        GLsizeiptr peak_frame_bytes;
+        /// Allocations larger than the buffer could hold
+        unsigned failures;
+    };
+
+    /// Maps @a capacity bytes for @a target. Returns null if the context
+    /// lacks persistent mapping; callers then keep orphaning their buffers.
+    static Ptr make(GLenum target, GLsizeiptr capacity);
+
+    /// Reserves @a size bytes for this frame, aligned for @a target's binding
+    /// rules. Fails, returning null data, only if a single frame needs more
+    /// than the whole buffer.
+    Allocation allocate(GLsizeiptr size);
+
+    /// Fences the frame's allocations; call after the draws that read them
+    void endFrame();
+
+    GLuint buffer() const { return m_buffer; }
+    GLsizeiptr capacity() const { return m_capacity; }
+
+    const Stats& stats() const { return m_stats; }
+    void report() const;
+
+    ~RingBuffer();
+
+private:
+    explicit RingBuffer(GLenum target);
+    RingBuffer(const RingBuffer&);
+    RingBuffer& operator=(const RingBuffer&);
+
+    /// Waits until the oldest frame in flight is done and forgets it
+    void retireOldest();
+
+private:
+    /// A frame the GPU may still be reading
+    struct Frame {
+        GLsync fence;
+        /// Where the frame's allocations began
+        uint64_t begin;
+    };
+
+    GLenum m_target;
+    GLuint m_buffer;
+    GLsizeiptr m_capacity;
+    GLsizeiptr m_alignment;
+    uint8_t* m_data;
+
+    /// Positions count bytes ever allocated, so that they only grow; the
+    /// offset in the buffer is the position modulo m_capacity
+    uint64_t m_head;
+    uint64_t m_frame_begin;
+    std::deque<Frame> m_frames;
+
+    util::Timer m_stall_timer;
+    Stats m_stats;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
@@ -0,0 +1,118 @@
+//
+//  glShaderVariants.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glShaderVariants_h
+#define Flexigin_glShaderVariants_h
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "OpenGLPlatform.h"
+#include "Util.h"
+#include "glProgram.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+struct ProgramBinaryCache;
+
+/// Resolves #include "name" lines in shader sources, which GLSL lacks.
+/// Names are looked up among the sources added with add(), then as files
+/// under the directory, if one was given. Each file is included once per
+/// shader, however many times it is named. #line directives restart the
+/// numbering at each included file and restore it after, so compiler
+/// messages give the line within whichever file it came from.
+struct ShaderIncludes {
+    explicit ShaderIncludes(const std::string& directory = std::string());
+
+    void add(const std::string& name, const std::string& source);
+
+    /// Expands every include in @a source into @a expanded. Returns false
+    /// and logs the name if an include cannot be found.
+    bool resolve(const std::string& source, std::string& expanded) const;
+
+private:
+    bool resolve(const std::string& source, std::string& expanded,
+                 std::set<std::string>& included, unsigned version, unsigned depth) const;
+    bool find(const std::string& name, std::string& source) const;
+
+private:
+    std::string m_directory;
+    std::map<std::string, std::string> m_sources;
+};
+
+/// The programs built from one pair of shader sources by turning features,
+/// such as skinning, fog or the number of lights, on and off with #defines.
+///
+/// Each feature takes some bits of a permutation key; a key names one
+/// variant. Variants are built through ProgramBuilder the first time get()
+/// asks for them, and kept, so that only the variants a run actually uses
+/// are compiled. Feature values are defined right after the #version line,
+/// wherever it is, or at the top of a source without one; features that
+/// are off or zero are left undefined, so shaders test them with #ifdef or
+/// #if.
+struct ShaderVariants {
+    typedef uint32_t Key;
+
+    /// Where a feature's value sits in a key
+    struct Feature {
+        unsigned shift;
+        unsigned bits;
+    };
+
+    struct Stats {
+        unsigned compiled;
+        unsigned hits;
+        unsigned failed;
+    };
+
+    /// Resolves the includes of both sources once, up front
+    ShaderVariants(const ShaderIncludes& includes,
+                   const char* vertex_shader,
+                   const char* fragment_shader);
+
+    /// Defines @a define to a value of up to @a bits bits, such as 1 for a
+    /// switch or 3 for a light count up to 7
+    Feature addFeature(const char* define, unsigned bits = 1);
+
+    /// Returns @a key with @a feature set to @a value
+    static Key set(Key key, Feature feature, unsigned value) {
+        const Key mask = ((Key(1) << feature.bits) - 1) << feature.shift;
+        return (key & ~mask) | ((Key(value) << feature.shift) & mask);
+    }
+
+    /// Has variants loaded from and stored to @a cache
+    void setCache(ProgramBinaryCache* cache) { m_cache = cache; }
+
+    /// Gets the variant for @a key, building it if it is new. Returns null
+    /// if it failed to build; it is not tried again, but each later request
+    /// counts as another failure.
+    Program* get(Key key);
+
+    const Stats& stats() const { return m_stats; }
+    /// Logs how many variants were compiled and how many were reused
+    void report() const;
+
+private:
+    /// Inserts the defines for @a key after the #version line of @a source
+    std::string specialize(const std::string& source, Key key) const;
+
+private:
+    std::string m_vertex_shader;
+    std::string m_fragment_shader;
+    std::vector<std::pair<std::string, Feature>> m_features;
+    unsigned m_key_bits;
+    ProgramBinaryCache* m_cache;
+    std::map<Key, Program::Ptr> m_variants;
+    Stats m_stats;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
@@ -0,0 +1,120 @@
+//
+//  glStateCache.h
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+
+#ifndef Flexigin_glStateCache_h
+#define Flexigin_glStateCache_h
+
+#include "OpenGLPlatform.h"
+#include "Util.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+/// Keeps a CPU-side copy of the GL state the engine changes, so that calls
+/// which would not change anything never reach the driver. Every setter
+/// returns whether it issued a GL call.
+///
+/// The copy starts out unknown, so the first call for each piece of state
+/// always goes through. Code that changes the same state without the cache
+/// must call invalidate() afterwards.
+struct StateCache {
+    /// Calls issued and avoided, over a frame
+    struct Stats {
+        unsigned calls;
+        unsigned calls_saved;
+    };
+
+    /// What program() returns before the first useProgram()
+    static const GLuint UNKNOWN = ~0u;
+
+    /// Gets the cache for the current context
+    static StateCache& current();
+
+    /// Forgets all cached state, so that the next call for each goes through
+    void invalidate();
+
+    bool useProgram(GLuint program);
+    GLuint program() const { return m_program; }
+
+    /// Array, element array, uniform, draw indirect and copy bindings are
+    /// cached, where the headers define them; others always go through
+    bool bindBuffer(GLenum target, GLuint buffer);
+    /// Binds @a buffer to an indexed binding point, which also binds it to
+    /// @a target; the first sixteen uniform buffer binding points are cached
+    bool bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    /// Also forgets the element buffer binding, which belongs to the VAO
+    bool bindVertexArray(GLuint vertex_array);
+
+    /// Call before deleting a buffer or vertex array, whose name GL may
+    /// hand out again
+    void forgetBuffer(GLuint buffer);
+    void forgetVertexArray(GLuint vertex_array);
+
+    bool enable(GLenum capability) { return setEnabled(capability, true); }
+    bool disable(GLenum capability) { return setEnabled(capability, false); }
+    bool setEnabled(GLenum capability, bool enabled);
+
+    bool blendFunc(GLenum source, GLenum destination);
+    bool depthFunc(GLenum func);
+    bool depthMask(GLboolean mask);
+    bool cullFace(GLenum mode);
+
+    /// Caches GL_AMBIENT, GL_DIFFUSE and GL_SPECULAR of the first eight
+    /// lights. Other parameters, notably GL_POSITION, which depends on the
+    /// modelview matrix at the time of the call, always go through.
+    bool lightfv(GLenum light, GLenum parameter, const GLfloat* values);
+
+    /// Ends the frame's counts; lastFrame() then returns them
+    void endFrame();
+    const Stats& lastFrame() const { return m_last_frame; }
+
+private:
+    StateCache();
+    StateCache(const StateCache&);
+    StateCache& operator=(const StateCache&);
+
+    bool issue(bool changed) {
+        ++(changed ? m_frame.calls : m_frame.calls_saved);
+        return changed;
+    }
+
+    /// Index of @a target in m_buffers, or MAX_BUFFER_TARGETS if not cached
+    static unsigned bufferSlot(GLenum target);
+
+    static const unsigned MAX_BUFFER_TARGETS = 8;
+    static const unsigned UNIFORM_BINDINGS = 16;
+    static const unsigned CAPABILITIES = 16;
+    static const unsigned LIGHTS = 8;
+    static const unsigned LIGHT_COLORS = 3;
+
+private:
+
+    GLuint m_program;
+    GLuint m_vertex_array;
+    GLuint m_buffers[MAX_BUFFER_TARGETS];
+    GLuint m_uniform_bindings[UNIFORM_BINDINGS];
+
+    /// Capabilities seen so far and whether each is enabled; GL_NONE ends
+    /// the list
+    GLenum m_capabilities[CAPABILITIES];
+    bool m_enabled[CAPABILITIES];
+
+    GLenum m_blend_source, m_blend_destination;
+    GLenum m_depth_func;
+    GLuint m_depth_mask;
+    GLenum m_cull_face;
+
+    bool m_light_known[LIGHTS][LIGHT_COLORS];
+    GLfloat m_light_colors[LIGHTS][LIGHT_COLORS][4];
+
+    Stats m_frame;
+    Stats m_last_frame;
+};
+
+CLOSE_FLEXI_NAMESPACE2()
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef BoundingBox_H__
+#define BoundingBox_H__
+/**
+ * @file
+ * @brief Header for BoundingBox class.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "Vector3f.h"
+
+namespace flexi {
+namespace math {
+namespace fpu_math {
+
+// Forward Declare
+class Matrix4x3;
+
+/**
+ * @brief An axis-aligned box given by its minimum and maximum corners.
+ * 
+ * A box whose minimum exceeds its maximum on any axis is empty; extending an
+ * empty box by a point or another box yields that point or box.
+ */
+class BoundingBox
+{
+public: /*********************** Fields and constants *************************/
+    Vector3f min, max;
+
+    /// A box containing nothing, equal to a default-constructed BoundingBox.
+    static const BoundingBox EMPTY;
+
+public: /*************************** Construction *****************************/
+
+    /// Constructs an empty box.
+    BoundingBox();
+    BoundingBox(const Vector3f& min, const Vector3f& max);
+
+public: /***************************** Methods ********************************/
+
+    bool isEmpty() const;
+
+    Vector3f getCenter() const;
+
+    /// Gets the half-size of this box along each axis.
+    Vector3f getExtents() const;
+
+    void setEmpty();
+    BoundingBox& extend(const Vector3f&);
+    BoundingBox& extend(const BoundingBox&);
+
+    bool contains(const Vector3f&) const;
+    bool contains(const BoundingBox&) const;
+    bool intersects(const BoundingBox&) const;
+
+    /// Whether some point of this box lies within @a radius of @a center.
+    bool intersectsSphere(const Vector3f& center, float radius) const;
+
+    /// Whether the whole box lies within @a radius of @a center.
+    bool insideSphere(const Vector3f& center, float radius) const;
+
+    /**
+     * @brief Slab test against the segment origin + t * direction for
+     *  0 <= t <= @a maxDistance.
+     * 
+     * @param inverseDirection The componentwise reciprocal of the direction;
+     *  infinite components are fine.
+     * @param entryDistance Receives the t at which the ray enters the box, or
+     *  0 if it starts inside.
+     */
+    bool intersectsRay(const Vector3f& origin, const Vector3f& inverseDirection,
+                       float maxDistance, float& entryDistance) const;
+
+    /**
+     * @brief Returns the smallest axis-aligned box containing this box after
+     *  it has been transformed by @a M.
+     * 
+     * The empty box transforms to the empty box.
+     */
+    BoundingBox transformed(const Matrix4x3& M) const;
+}; // class BoundingBox
+
+} // namespace fpu_math
+} // namespace math
+} // namespace flexi
+
+#endif // BoundingBox_H__
@@ -37,6 +37,8 @@ using namespace simd_math;
 #include "Quaternion.h"
 #include "Matrix4x3.h"
 #include "Matrix4x4.h"
+#include "BoundingBox.h"
+#include "Frustum.h"
 
 namespace flexi {
 namespace math {
@@ -0,0 +1,79 @@
+#ifndef Frustum_H__
+#define Frustum_H__
+/**
+ * @file
+ * @brief Header for Frustum class.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "Vector3f.h"
+
+namespace flexi {
+namespace math {
+namespace fpu_math {
+
+// Forward Declare
+class BoundingBox;
+class Matrix4x3;
+
+/**
+ * @brief A perspective view volume bounded by six inward-facing planes.
+ * 
+ * Box tests accept a plane mask so that hierarchical culling can skip the
+ * planes a parent volume was already found to be entirely inside of.
+ */
+class Frustum
+{
+public: /*********************** Fields and constants *************************/
+
+    enum PlaneIndex {
+        LEFT, RIGHT, BOTTOM, TOP, NEAR_PLANE, FAR_PLANE, PLANE_COUNT
+    };
+
+    /// A plane mask with a bit set for each of the six planes.
+    static const unsigned ALL_PLANES = (1u << PLANE_COUNT) - 1;
+
+    enum Containment {
+        OUTSIDE, INTERSECTS, INSIDE
+    };
+
+    /// Inward-facing unit plane normals; p is inside plane i if
+    /// <code>normal[i].dot(p) + distance[i] >= 0</code>.
+    Vector3f normal[PLANE_COUNT];
+    float distance[PLANE_COUNT];
+
+public: /*************************** Construction *****************************/
+
+    /**
+     * @brief Builds the view volume of a camera looking down its -z axis.
+     * 
+     * @param fovy The vertical field of view in degrees.
+     * @param aspect The viewport width divided by its height.
+     * @param viewToWorld The rigid transform from camera space to world space.
+     */
+    Frustum(const float fovy, const float aspect,
+            const float nearClip, const float farClip,
+            const Matrix4x3& viewToWorld);
+
+public: /***************************** Methods ********************************/
+
+    /**
+     * @brief Classifies @a box against the planes set in @a planeMask.
+     * 
+     * On return, @a planeMask has cleared the bits of every plane the box is
+     * entirely inside of, which is the mask to test the box's contents with.
+     */
+    Containment classify(const BoundingBox& box, unsigned& planeMask) const;
+
+    /// Classifies @a box against all six planes.
+    Containment classify(const BoundingBox& box) const;
+
+    bool intersects(const BoundingBox& box) const;
+}; // class Frustum
+
+} // namespace fpu_math
+} // namespace math
+} // namespace flexi
+
+#endif // Frustum_H__
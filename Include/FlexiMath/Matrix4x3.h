@@ -29,6 +29,8 @@ class Matrix4x3
     friend Vector3f  operator*(const Vector3f&, const Matrix4x3&);
     friend Vector3f& operator*=(Vector3f&, const Matrix4x3&);
     friend class Matrix4x4;
+    friend class BoundingBox;
+    friend class Frustum;
 
     Matrix4x3(const Vector3f& xAxis, const Vector3f& yAxis,
               const Vector3f& zAxis, const Vector3f& pos);
@@ -11,9 +11,29 @@
 
 #ifdef __APPLE__
 #include <OpenGL/gl.h>
+#include <OpenGL/glext.h>
 #include <OpenGL/glu.h>
+
+// The legacy context only offers vertex array objects through
+// APPLE_vertex_array_object, whose objects do not hold the element buffer
+#define FLEXI_GL_APPLE_VERTEX_ARRAYS 1
+#define glGenVertexArrays    glGenVertexArraysAPPLE
+#define glBindVertexArray    glBindVertexArrayAPPLE
+#define glDeleteVertexArrays glDeleteVertexArraysAPPLE
+
+// Instancing comes from ARB_draw_instanced and ARB_instanced_arrays
+#define glDrawElementsInstanced glDrawElementsInstancedARB
+#define glVertexAttribDivisor   glVertexAttribDivisorARB
 #else
-// TODO
+#ifdef _WIN32
+#include <windows.h>
+#endif
+// Entry points past GL 1.1 come straight from libGL on Linux; on Windows
+// they need an extension loader to resolve them
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/glu.h>
 #endif
 
 #endif
@@ -0,0 +1,35 @@
+#ifndef Parallel_H__
+#define Parallel_H__
+/**
+ * @file
+ * @brief Declares parallelFor, which spreads independent tasks across cores.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <functional>
+
+namespace flexi {
+namespace util {
+
+/// Gets the number of threads parallelFor runs tasks on, at least 1.
+unsigned getWorkerCount();
+
+/**
+ * @brief Calls @a task once for each index in [0, @a taskCount) and returns
+ *  when all calls have finished.
+ * 
+ * Tasks are handed out one at a time to up to getWorkerCount() threads, the
+ * calling thread included, so uneven tasks balance themselves. Tasks may run
+ * in any order and must not depend on one another. The threads are started
+ * by the first call and kept until the program exits.
+ * 
+ * Calls made while another call is running, whether from another thread or
+ * from within a task, run all their tasks on the calling thread.
+ */
+void parallelFor(unsigned taskCount, const std::function<void (unsigned)>& task);
+
+} // namespace util
+} // namespace flexi
+
+#endif // Parallel_H__
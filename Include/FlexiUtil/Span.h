@@ -0,0 +1,48 @@
+#ifndef Span_H__
+#define Span_H__
+/**
+ * @file
+ * @brief Defines Span, a non-owning view of a contiguous run of elements.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cstddef>
+
+namespace flexi {
+namespace util {
+
+/**
+ * @brief Refers to @a count elements of type T stored contiguously at @a data.
+ * 
+ * A Span does not own its elements; it is only valid as long as the storage
+ * it was made from is neither freed nor reallocated.
+ */
+template <typename T>
+class Span
+{
+public:
+    typedef T value_type;
+    typedef T* iterator;
+
+    Span() : first(0), count(0) {}
+    Span(T* data, size_t count) : first(data), count(count) {}
+
+    T* data() const { return first; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+
+    T& operator[](size_t index) const { return first[index]; }
+
+private:
+    T* first;
+    size_t count;
+};
+
+} // namespace util
+} // namespace flexi
+
+#endif // Span_H__
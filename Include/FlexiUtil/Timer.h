@@ -5,9 +5,14 @@
  * @brief Header for Timer class.
  * @author   Steven Bloemer
  * @date     12/9/2010
- * @lastedit 12/9/2010
+ * @lastedit 10/19/2026
  */
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include "windows.h"
+#endif
 
 namespace flexi {
 namespace util {
@@ -90,10 +95,25 @@ public:  /************************** Public Interface *************************/
 
     Timer();
 
+    /// Counter ticks; divide by getFrequency() to get seconds
+    typedef long long Ticks;
+
+    /**
+     * @brief Reads the high-resolution monotonic counter that Timers use.
+     *
+     * Lets other code take timestamps on the same clock as Timer intervals.
+     */
+    static Ticks readCounter();
+
+    /**
+     * @brief Gets the number of readCounter() ticks per second.
+     */
+    static Ticks getFrequency();
+
 private: /******************************* Fields ******************************/
-    LARGE_INTEGER lastDelta;
-    LARGE_INTEGER startTime;
-    LARGE_INTEGER totalTime;
+    Ticks lastDelta;
+    Ticks startTime;
+    Ticks totalTime;
     unsigned intervalCount;
 
     static float period; // Initialized in Timer ctor
@@ -0,0 +1,110 @@
+#ifndef TripleBuffer_H__
+#define TripleBuffer_H__
+/**
+ * @file
+ * @brief Defines TripleBuffer, which hands whole values from one thread to
+ *        another without locking.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+
+namespace flexi {
+namespace util {
+
+/**
+ * @brief Tracks which of three slots a writer thread, a reader thread and the
+ *  hand-off between them each own.
+ * 
+ * The writer fills its back slot and publishes it, trading it for the shared
+ * slot. The reader acquires by trading its front slot for the shared slot,
+ * but only if something was published since its last acquire. Each trade is a
+ * single atomic exchange, so neither side ever waits for the other, and a
+ * slot is never owned by both at once.
+ * 
+ * Exactly one thread may call publish() and exactly one may call acquire().
+ */
+class TripleBufferSlots
+{
+    TripleBufferSlots(const TripleBufferSlots&);
+    TripleBufferSlots& operator=(const TripleBufferSlots&);
+
+public:
+    TripleBufferSlots();
+
+    /// Gets the slot the writer is filling
+    unsigned getBack() const { return back; }
+
+    /// Gets the slot the reader last acquired
+    unsigned getFront() const { return front; }
+
+    /**
+     * @brief Hands the back slot to the reader and takes a new back slot.
+     * @returns @c true if the slot published before was never acquired, and
+     *  so was dropped.
+     */
+    bool publish();
+
+    /**
+     * @brief Takes the most recently published slot as the front slot.
+     * @returns @c false, leaving the front slot as it was, if nothing was
+     *  published since the last acquire.
+     */
+    bool acquire();
+
+private: /******************************* Fields ******************************/
+    /// The shared slot, plus FRESH if it was published and not yet acquired
+    volatile long shared;
+    unsigned back;
+    unsigned front;
+};
+
+/**
+ * @brief Three values of type @a T, passed from a writer thread to a reader
+ *  thread as whole snapshots.
+ * 
+ * The writer fills getBack() and calls publish(); the reader calls acquire()
+ * and reads getFront(), which stays untouched until its next acquire(). The
+ * writer may publish faster than the reader acquires, in which case the
+ * reader skips to the newest value; neither blocks the other.
+ * 
+ * The back slot is handed out as the writer left it two or more publishes
+ * ago, not as last published, so writers should refill it completely. Types
+ * that keep their capacity when cleared, such as vectors, stop allocating
+ * once all three slots have grown.
+ */
+template <typename T>
+class TripleBuffer
+{
+    TripleBuffer(const TripleBuffer&);
+    TripleBuffer& operator=(const TripleBuffer&);
+
+public:
+    TripleBuffer() : dropped(0) {}
+
+    /// Writer: gets the value to fill before the next publish()
+    T& getBack() { return slots[index.getBack()]; }
+
+    /// Writer: makes the back value the newest one the reader can acquire
+    void publish() { dropped += index.publish(); }
+
+    /// Reader: moves to the newest published value, if any is new
+    bool acquire() { return index.acquire(); }
+
+    /// Reader: gets the value taken by the last acquire()
+    const T& getFront() const { return slots[index.getFront()]; }
+    T& getFront() { return slots[index.getFront()]; }
+
+    /// Writer: gets the number of published values the reader never acquired
+    unsigned getDroppedCount() const { return dropped; }
+
+private: /******************************* Fields ******************************/
+    T slots[3];
+    TripleBufferSlots index;
+    unsigned dropped;
+};
+
+} // namespace util
+} // namespace flexi
+
+#endif // TripleBuffer_H__
@@ -33,16 +33,15 @@ Camera::Camera(GLdouble fovy, GLdouble near_clip, GLdouble far_clip)
 
 void Camera::handleDimensionChange(unsigned width, unsigned height)
 {
-    if (!m_perspective_dirty) {
-        if (width == m_width && height == m_height) {
-            return;
-        } else {
-            m_width = width;
-            m_height = height;
-        }
+    if (!m_perspective_dirty && width == m_width && height == m_height) {
+        return;
     }
 
-    const GLdouble aspect_ratio = width / (GLdouble)height;
+    m_width = width;
+    m_height = height;
+    m_perspective_dirty = false;
+
+    const GLdouble aspect_ratio = aspectRatio();
 
     cout << __FUNCTION__ << '(' << width << ", " << height << ')' << endl
          << "  vertical fov " << m_vertical_fov << " near clip " << m_near_clip
@@ -57,4 +56,11 @@ void Camera::handleDimensionChange(unsigned width, unsigned height)
     glLoadIdentity();
 }
 
+math::Frustum Camera::frustum(const math::Matrix4x3& view_to_world) const
+{
+    return math::Frustum((float)m_vertical_fov, (float)aspectRatio(),
+                         (float)m_near_clip, (float)m_far_clip,
+                         view_to_world);
+}
+
 CLOSE_FLEXI_NAMESPACE1()
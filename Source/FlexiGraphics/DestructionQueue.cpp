@@ -0,0 +1,37 @@
+/**
+ * @file
+ * @brief Definitions for DestructionQueue.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\DestructionQueue.h"
+#include "FlexiUtil\Timer.h"
+
+namespace flexi {
+namespace graphics {
+
+unsigned DestructionQueue::destroyFor(float budgetSeconds)
+{
+    // Nodes deleted between looks at the clock
+    const unsigned CHECK_INTERVAL = 256;
+
+    util::Timer timer;
+    float elapsed = 0;
+    unsigned destroyed = 0;
+
+    timer.start();
+    while (!pending.empty()) {
+        destroyed += destroyNext(CHECK_INTERVAL);
+
+        timer.stop();
+        elapsed += timer.getLastSeconds();
+        if (elapsed >= budgetSeconds)
+            break;
+        timer.start();
+    }
+    return destroyed;
+} // DestructionQueue::destroyFor()
+
+} // namespace graphics
+} // namespace flexi
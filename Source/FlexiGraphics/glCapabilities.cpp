@@ -0,0 +1,128 @@
+//
+//  glCapabilities.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include "glCapabilities.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+const Capabilities&
+Capabilities::current()
+{
+    static const Capabilities capabilities;
+    return capabilities;
+}
+
+Capabilities::Capabilities()
+    : m_major_version(1)
+    , m_minor_version(0)
+    , m_vertex_array_objects(false)
+    , m_buffer_storage(false)
+    , m_uniform_buffers(false)
+    , m_program_binaries(false)
+    , m_instanced_arrays(false)
+    , m_multi_draw_indirect(false)
+    , m_timer_queries(false)
+    , m_parallel_shader_compile(false)
+{
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!version || sscanf(version, "%u.%u", &m_major_version, &m_minor_version) != 2) {
+        assert(!"Capabilities queried without a current context");
+        return;
+    }
+
+    // Core profiles only list extensions one at a time
+#ifdef GL_NUM_EXTENSIONS
+    if (hasVersion(3, 0)) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            m_extensions += reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            m_extensions += ' ';
+        }
+    } else
+#endif
+    {
+        const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+        if (extensions) {
+            m_extensions = extensions;
+            m_extensions += ' ';
+        }
+    }
+
+#ifdef FLEXI_GL_APPLE_VERTEX_ARRAYS
+    m_vertex_array_objects = hasExtension("GL_APPLE_vertex_array_object");
+#else
+    m_vertex_array_objects = hasVersion(3, 0) || hasExtension("GL_ARB_vertex_array_object");
+#endif
+#ifdef GL_MAP_PERSISTENT_BIT
+    m_buffer_storage = hasVersion(4, 4) || hasExtension("GL_ARB_buffer_storage");
+#endif
+#ifdef GL_UNIFORM_BUFFER
+    m_uniform_buffers = hasVersion(3, 1) || hasExtension("GL_ARB_uniform_buffer_object");
+#endif
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    if (hasVersion(4, 1) || hasExtension("GL_ARB_get_program_binary")) {
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        m_program_binaries = formats > 0;
+    }
+#endif
+#if defined(GL_VERTEX_ATTRIB_ARRAY_DIVISOR) || defined(GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB)
+    m_instanced_arrays = hasVersion(3, 3)
+        || (hasExtension("GL_ARB_instanced_arrays")
+            && (hasVersion(3, 1) || hasExtension("GL_ARB_draw_instanced")));
+#endif
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    m_multi_draw_indirect = hasVersion(4, 3)
+        || (hasExtension("GL_ARB_multi_draw_indirect") && hasExtension("GL_ARB_base_instance"));
+#endif
+#ifdef GL_TIMESTAMP
+    m_timer_queries = hasVersion(3, 3) || hasExtension("GL_ARB_timer_query");
+#endif
+#ifdef GL_COMPLETION_STATUS_KHR
+    // Let the driver use as many threads as it likes
+    if (hasExtension("GL_KHR_parallel_shader_compile")) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        m_parallel_shader_compile = true;
+    } else if (hasExtension("GL_ARB_parallel_shader_compile")) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        m_parallel_shader_compile = true;
+    }
+#endif
+
+    cout << "GL " << version << " on " << glGetString(GL_RENDERER) << endl
+         << "  vertex array objects " << m_vertex_array_objects
+         << " buffer storage " << m_buffer_storage
+         << " uniform buffers " << m_uniform_buffers
+         << " program binaries " << m_program_binaries
+         << " instanced arrays " << m_instanced_arrays
+         << " multi-draw indirect " << m_multi_draw_indirect
+         << " timer queries " << m_timer_queries
+         << " parallel shader compile " << m_parallel_shader_compile << endl;
+}
+
+bool
+Capabilities::hasExtension(const char* name) const
+{
+    // Match whole names only, so that a name is not found inside a longer one
+    const string needle = string(name) + ' ';
+    for (size_t at = m_extensions.find(needle); at != string::npos;
+         at = m_extensions.find(needle, at + 1))
+    {
+        if (at == 0 || m_extensions[at - 1] == ' ') {
+            return true;
+        }
+    }
+    return false;
+}
+
+CLOSE_FLEXI_NAMESPACE2()
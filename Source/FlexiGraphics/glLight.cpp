@@ -6,6 +6,7 @@
 //  Copyright (c) 2012 Steven Bloemer. All rights reserved.
 //
 #include "glLight.h"
+#include "glStateCache.h"
 
 OPEN_FLEXI_NAMESPACE2(graphics, gl)
 
@@ -26,18 +27,21 @@ Light::Light
 void
 Light::turnOn()
 {
-    glLightfv(GL_LIGHT0, GL_POSITION, m_position.adr());
-    glLightfv(GL_LIGHT0, GL_AMBIENT, m_ambient_color.adr());
-    glLightfv(GL_LIGHT0, GL_DIFFUSE, m_diffuse_color.adr());
-    glLightfv(GL_LIGHT0, GL_SPECULAR, m_specular_color.adr());
+    // The position is transformed by the current modelview matrix, so it
+    // has to be sent every time; the colors only when they change
+    StateCache& cache = StateCache::current();
+    cache.lightfv(GL_LIGHT0, GL_POSITION, m_position.adr());
+    cache.lightfv(GL_LIGHT0, GL_AMBIENT, m_ambient_color.adr());
+    cache.lightfv(GL_LIGHT0, GL_DIFFUSE, m_diffuse_color.adr());
+    cache.lightfv(GL_LIGHT0, GL_SPECULAR, m_specular_color.adr());
 
-    glEnable(GL_LIGHT0);
+    cache.enable(GL_LIGHT0);
 }
 
 void
 Light::turnOff()
 {
-    glDisable(GL_LIGHT0);
+    StateCache::current().disable(GL_LIGHT0);
 }
 
 CLOSE_FLEXI_NAMESPACE2()
@@ -0,0 +1,560 @@
+//
+//  glMesh.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <cassert>
+#include <cstdint>
+#include "glCapabilities.h"
+#include "glMesh.h"
+#include "glStateCache.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+static GLsizeiptr indexSize(GLenum index_type);
+static const GLvoid* bufferOffset(GLsizei offset);
+/// Points and enables every attribute of @a layout at the bound vertex buffer
+static void enableAttributes(const VertexLayout& layout);
+static void disableAttributes(const VertexLayout& layout);
+
+Mesh::Ptr
+Mesh::make
+(
+    const VertexLayout& layout,
+    const void* vertices,
+    GLsizei vertex_count,
+    const void* indices,
+    GLenum index_type,
+    GLsizei index_count,
+    BufferUsage usage,
+    GLenum primitive
+)
+{
+    if (!vertices || !indices || vertex_count <= 0 || index_count <= 0) {
+        assert(!"Cannot make a mesh without vertices and indices");
+        return Ptr();
+    }
+
+    Ptr mesh(new Mesh(layout, index_type, usage, primitive));
+    mesh->m_vertex_count = vertex_count;
+    mesh->m_index_count = index_count;
+
+    glGenBuffers(1, &mesh->m_vertex_buffer);
+    glGenBuffers(1, &mesh->m_index_buffer);
+    if (Capabilities::current().vertexArrayObjects()) {
+        glGenVertexArrays(1, &mesh->m_vertex_array);
+    }
+
+    // Record the layout and index buffer in the vertex array object, if any
+    mesh->bind();
+    if (mesh->m_vertex_array) {
+        StateCache::current().bindBuffer(GL_ARRAY_BUFFER, mesh->m_vertex_buffer);
+        enableAttributes(layout);
+    }
+    mesh->upload(GL_ARRAY_BUFFER, mesh->m_vertex_buffer, vertices,
+                 GLsizeiptr(vertex_count) * layout.stride);
+    mesh->upload(GL_ELEMENT_ARRAY_BUFFER, mesh->m_index_buffer, indices,
+                 GLsizeiptr(index_count) * indexSize(index_type));
+    mesh->unbind();
+
+    assert(glGetError() == GL_NO_ERROR);
+    return mesh;
+}
+
+Mesh::Mesh(const VertexLayout& layout, GLenum index_type, BufferUsage usage, GLenum primitive)
+    : m_layout(layout)
+    , m_index_type(index_type)
+    , m_usage(usage)
+    , m_primitive(primitive)
+    , m_vertex_array(0)
+    , m_vertex_buffer(0)
+    , m_index_buffer(0)
+    , m_vertex_count(0)
+    , m_index_count(0)
+{
+    assert(indexSize(index_type) && "Indices must be unsigned bytes, shorts or ints");
+}
+
+Mesh::~Mesh()
+{
+    StateCache& cache = StateCache::current();
+    cache.forgetBuffer(m_vertex_buffer);
+    cache.forgetBuffer(m_index_buffer);
+    if (m_vertex_array) {
+        cache.forgetVertexArray(m_vertex_array);
+        glDeleteVertexArrays(1, &m_vertex_array);
+    }
+    glDeleteBuffers(1, &m_vertex_buffer);
+    glDeleteBuffers(1, &m_index_buffer);
+}
+
+void
+Mesh::bind()
+{
+    StateCache& cache = StateCache::current();
+    if (m_vertex_array) {
+        cache.bindVertexArray(m_vertex_array);
+#ifdef FLEXI_GL_APPLE_VERTEX_ARRAYS
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+#endif
+    } else {
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+        enableAttributes(m_layout);
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+    }
+}
+
+void
+Mesh::unbind()
+{
+    StateCache& cache = StateCache::current();
+    if (m_vertex_array) {
+        cache.bindVertexArray(0);
+#ifdef FLEXI_GL_APPLE_VERTEX_ARRAYS
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#endif
+    } else {
+        disableAttributes(m_layout);
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+    cache.bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void
+Mesh::update
+(
+    const void* vertices,
+    GLsizei vertex_count,
+    const void* indices,
+    GLsizei index_count
+)
+{
+    if (m_usage != BufferUsage::STREAMING) {
+        assert(!"Only streaming meshes can be updated");
+        return;
+    }
+
+    // Binding the index buffer outside of this mesh's vertex array object
+    // would replace the element buffer of whichever one is bound
+    bind();
+    if (vertices) {
+        upload(GL_ARRAY_BUFFER, m_vertex_buffer, vertices, GLsizeiptr(vertex_count) * m_layout.stride);
+        m_vertex_count = vertex_count;
+    }
+    if (indices) {
+        upload(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer, indices,
+               GLsizeiptr(index_count) * indexSize(m_index_type));
+        m_index_count = index_count;
+    }
+    unbind();
+}
+
+void
+Mesh::upload(GLenum target, GLuint buffer, const void* data, GLsizeiptr size)
+{
+    StateCache::current().bindBuffer(target, buffer);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+    if (m_usage == BufferUsage::IMMUTABLE && Capabilities::current().bufferStorage()) {
+        glBufferStorage(target, size, data, 0);
+        return;
+    }
+#endif
+
+    // Respecifying a streaming buffer gives it new storage, leaving the old
+    // storage to any draws still reading it
+    glBufferData(target, size, data,
+                 m_usage == BufferUsage::IMMUTABLE ? GL_STATIC_DRAW : GL_STREAM_DRAW);
+}
+
+#pragma mark InstanceBuffer Methods
+
+InstanceBuffer::Ptr
+InstanceBuffer::make(const VertexLayout& layout)
+{
+    if (!Capabilities::current().instancedArrays()) {
+        return Ptr();
+    }
+
+    for (const VertexAttribute& attribute : layout.attributes) {
+        if (attribute.semantic != VertexSemantic::GENERIC) {
+            assert(!"Instance attributes must be generic");
+            return Ptr();
+        }
+    }
+
+    return Ptr(new InstanceBuffer(layout));
+}
+
+VertexLayout
+InstanceBuffer::transforms(GLuint first_index)
+{
+    const GLsizei AXIS = 3 * sizeof(GLfloat);
+    return VertexLayout(4 * AXIS, {
+        { VertexSemantic::GENERIC, 3, GL_FLOAT, 0 * AXIS, first_index + 0, GL_FALSE },
+        { VertexSemantic::GENERIC, 3, GL_FLOAT, 1 * AXIS, first_index + 1, GL_FALSE },
+        { VertexSemantic::GENERIC, 3, GL_FLOAT, 2 * AXIS, first_index + 2, GL_FALSE },
+        { VertexSemantic::GENERIC, 3, GL_FLOAT, 3 * AXIS, first_index + 3, GL_FALSE },
+    });
+}
+
+InstanceBuffer::InstanceBuffer(const VertexLayout& layout)
+    : m_layout(layout)
+    , m_buffer(0)
+    , m_capacity(0)
+    , m_count(0)
+{
+    glGenBuffers(1, &m_buffer);
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+    StateCache::current().forgetBuffer(m_buffer);
+    glDeleteBuffers(1, &m_buffer);
+}
+
+void
+InstanceBuffer::update(const void* instances, GLsizei count)
+{
+    const GLsizeiptr size = GLsizeiptr(count) * m_layout.stride;
+    StateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    // Grow by half again, so that slowly growing counts settle quickly
+    if (size > m_capacity) {
+        m_capacity = size + size / 2;
+    }
+    glBufferData(GL_ARRAY_BUFFER, m_capacity, 0, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances);
+    m_count = count;
+}
+
+void
+InstanceBuffer::bind(GLuint buffer, GLintptr offset)
+{
+    StateCache::current().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (const VertexAttribute& attribute : m_layout.attributes) {
+        glEnableVertexAttribArray(attribute.index);
+        glVertexAttribPointer(attribute.index, attribute.size, attribute.type, attribute.normalized,
+                              m_layout.stride, bufferOffset(GLsizei(offset + attribute.offset)));
+        glVertexAttribDivisor(attribute.index, 1);
+    }
+}
+
+void
+InstanceBuffer::unbind()
+{
+    for (const VertexAttribute& attribute : m_layout.attributes) {
+        glVertexAttribDivisor(attribute.index, 0);
+        glDisableVertexAttribArray(attribute.index);
+    }
+}
+
+#pragma mark MeshPool Methods
+
+MeshPool::Ptr
+MeshPool::make
+(
+    const VertexLayout& layout,
+    GLenum index_type,
+    GLsizei vertex_capacity,
+    GLsizei index_capacity,
+    GLenum primitive
+)
+{
+    if (vertex_capacity <= 0 || index_capacity <= 0) {
+        assert(!"Cannot make a mesh pool without room for vertices and indices");
+        return Ptr();
+    }
+
+    Ptr pool(new MeshPool(layout, index_type, primitive));
+    pool->m_vertex_capacity = vertex_capacity;
+    pool->m_index_capacity = index_capacity;
+
+    glGenBuffers(1, &pool->m_vertex_buffer);
+    glGenBuffers(1, &pool->m_index_buffer);
+    if (Capabilities::current().vertexArrayObjects()) {
+        glGenVertexArrays(1, &pool->m_vertex_array);
+    }
+
+    // Record the layout and index buffer in the vertex array object, if any
+    StateCache& cache = StateCache::current();
+    pool->bind();
+    cache.bindBuffer(GL_ARRAY_BUFFER, pool->m_vertex_buffer);
+    if (pool->m_vertex_array) {
+        enableAttributes(layout);
+    }
+    glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(vertex_capacity) * layout.stride, 0, GL_STATIC_DRAW);
+    cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool->m_index_buffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(index_capacity) * indexSize(index_type), 0,
+                 GL_STATIC_DRAW);
+    pool->unbind();
+
+    assert(glGetError() == GL_NO_ERROR);
+    return pool;
+}
+
+MeshPool::MeshPool(const VertexLayout& layout, GLenum index_type, GLenum primitive)
+    : m_layout(layout)
+    , m_index_type(index_type)
+    , m_primitive(primitive)
+    , m_vertex_array(0)
+    , m_vertex_buffer(0)
+    , m_index_buffer(0)
+    , m_vertex_count(0)
+    , m_vertex_capacity(0)
+    , m_index_count(0)
+    , m_index_capacity(0)
+{
+    assert(indexSize(index_type) && "Indices must be unsigned bytes, shorts or ints");
+}
+
+MeshPool::~MeshPool()
+{
+    StateCache& cache = StateCache::current();
+    cache.forgetBuffer(m_vertex_buffer);
+    cache.forgetBuffer(m_index_buffer);
+    if (m_vertex_array) {
+        cache.forgetVertexArray(m_vertex_array);
+        glDeleteVertexArrays(1, &m_vertex_array);
+    }
+    glDeleteBuffers(1, &m_vertex_buffer);
+    glDeleteBuffers(1, &m_index_buffer);
+}
+
+bool
+MeshPool::add
+(
+    const void* vertices,
+    GLsizei vertex_count,
+    const void* indices,
+    GLsizei index_count,
+    Range* range
+)
+{
+    if (!vertices || !indices || vertex_count <= 0 || index_count <= 0) {
+        assert(!"Cannot pool a mesh without vertices and indices");
+        return false;
+    }
+    if (vertex_count > m_vertex_capacity - m_vertex_count
+        || index_count > m_index_capacity - m_index_count)
+    {
+        return false;
+    }
+
+    // As in Mesh::update(), the index buffer must be bound inside this
+    // pool's vertex array object
+    bind();
+    StateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, GLintptr(m_vertex_count) * m_layout.stride,
+                    GLsizeiptr(vertex_count) * m_layout.stride, vertices);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, GLintptr(m_index_count) * indexSize(m_index_type),
+                    GLsizeiptr(index_count) * indexSize(m_index_type), indices);
+    unbind();
+
+    range->first_index = GLuint(m_index_count);
+    range->index_count = GLuint(index_count);
+    range->base_vertex = GLint(m_vertex_count);
+    m_vertex_count += vertex_count;
+    m_index_count += index_count;
+    return true;
+}
+
+void
+MeshPool::bind()
+{
+    StateCache& cache = StateCache::current();
+    if (m_vertex_array) {
+        cache.bindVertexArray(m_vertex_array);
+#ifdef FLEXI_GL_APPLE_VERTEX_ARRAYS
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+#endif
+    } else {
+        cache.bindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+        enableAttributes(m_layout);
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+    }
+}
+
+void
+MeshPool::unbind()
+{
+    StateCache& cache = StateCache::current();
+    if (m_vertex_array) {
+        cache.bindVertexArray(0);
+#ifdef FLEXI_GL_APPLE_VERTEX_ARRAYS
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#endif
+    } else {
+        disableAttributes(m_layout);
+        cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+    cache.bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+#pragma mark DrawIndirectBuffer Methods
+
+DrawIndirectBuffer::Ptr
+DrawIndirectBuffer::make()
+{
+    if (!Capabilities::current().multiDrawIndirect()) {
+        return Ptr();
+    }
+    return Ptr(new DrawIndirectBuffer());
+}
+
+DrawIndirectBuffer::DrawIndirectBuffer()
+    : m_buffer(0)
+    , m_capacity(0)
+{
+    glGenBuffers(1, &m_buffer);
+    clear();
+}
+
+DrawIndirectBuffer::~DrawIndirectBuffer()
+{
+    StateCache::current().forgetBuffer(m_buffer);
+    glDeleteBuffers(1, &m_buffer);
+}
+
+void
+DrawIndirectBuffer::clear()
+{
+    m_commands.clear();
+    m_buckets.clear();
+    m_stats.commands = 0;
+    m_stats.multi_draws = 0;
+}
+
+unsigned
+DrawIndirectBuffer::startBucket()
+{
+    if (m_buckets.empty() || m_buckets.back() != m_commands.size()) {
+        m_buckets.push_back(m_commands.size());
+    }
+    return unsigned(m_buckets.size() - 1);
+}
+
+void
+DrawIndirectBuffer::add(const MeshPool::Range& range, GLuint instance_count, GLuint base_instance)
+{
+    if (m_buckets.empty()) {
+        startBucket();
+    }
+
+    const Command command = {
+        range.index_count, instance_count, range.first_index, range.base_vertex, base_instance
+    };
+    m_commands.push_back(command);
+}
+
+void
+DrawIndirectBuffer::upload()
+{
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    if (m_commands.empty()) {
+        return;
+    }
+
+    const GLsizeiptr size = GLsizeiptr(m_commands.size() * sizeof(Command));
+    StateCache::current().bindBuffer(GL_DRAW_INDIRECT_BUFFER, m_buffer);
+
+    // Grow by half again, as InstanceBuffer does
+    if (size > m_capacity) {
+        m_capacity = size + size / 2;
+    }
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, m_capacity, 0, GL_STREAM_DRAW);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, &m_commands[0]);
+#endif
+}
+
+void
+DrawIndirectBuffer::draw(unsigned bucket, const MeshPool& pool)
+{
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    assert(bucket < m_buckets.size());
+    const size_t first = m_buckets[bucket];
+    const size_t end = bucket + 1 < m_buckets.size() ? m_buckets[bucket + 1] : m_commands.size();
+    if (first == end) {
+        return;
+    }
+
+    StateCache::current().bindBuffer(GL_DRAW_INDIRECT_BUFFER, m_buffer);
+    glMultiDrawElementsIndirect(pool.primitive(), pool.indexType(),
+                                bufferOffset(GLsizei(first * sizeof(Command))),
+                                GLsizei(end - first), sizeof(Command));
+    m_stats.commands += unsigned(end - first);
+    ++m_stats.multi_draws;
+#endif
+}
+
+#pragma mark Static Routines
+
+static GLsizeiptr
+indexSize(GLenum index_type)
+{
+    switch (index_type) {
+    case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+    case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+    case GL_UNSIGNED_INT:   return sizeof(GLuint);
+    default:                return 0;
+    }
+}
+
+static const GLvoid*
+bufferOffset(GLsizei offset)
+{
+    return reinterpret_cast<const GLvoid*>(static_cast<uintptr_t>(offset));
+}
+
+static void
+enableAttributes(const VertexLayout& layout)
+{
+    const GLsizei stride = layout.stride;
+    for (const VertexAttribute& attribute : layout.attributes) {
+        const GLvoid* offset = bufferOffset(attribute.offset);
+        switch (attribute.semantic) {
+        case VertexSemantic::POSITION:
+            glEnableClientState(GL_VERTEX_ARRAY);
+            glVertexPointer(attribute.size, attribute.type, stride, offset);
+            break;
+        case VertexSemantic::NORMAL:
+            assert(attribute.size == 3);
+            glEnableClientState(GL_NORMAL_ARRAY);
+            glNormalPointer(attribute.type, stride, offset);
+            break;
+        case VertexSemantic::COLOR:
+            glEnableClientState(GL_COLOR_ARRAY);
+            glColorPointer(attribute.size, attribute.type, stride, offset);
+            break;
+        case VertexSemantic::TEXCOORD:
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(attribute.size, attribute.type, stride, offset);
+            break;
+        case VertexSemantic::GENERIC:
+            glEnableVertexAttribArray(attribute.index);
+            glVertexAttribPointer(attribute.index, attribute.size, attribute.type,
+                                  attribute.normalized, stride, offset);
+            break;
+        }
+    }
+}
+
+static void
+disableAttributes(const VertexLayout& layout)
+{
+    for (const VertexAttribute& attribute : layout.attributes) {
+        switch (attribute.semantic) {
+        case VertexSemantic::POSITION: glDisableClientState(GL_VERTEX_ARRAY);        break;
+        case VertexSemantic::NORMAL:   glDisableClientState(GL_NORMAL_ARRAY);        break;
+        case VertexSemantic::COLOR:    glDisableClientState(GL_COLOR_ARRAY);         break;
+        case VertexSemantic::TEXCOORD: glDisableClientState(GL_TEXTURE_COORD_ARRAY); break;
+        case VertexSemantic::GENERIC:  glDisableVertexAttribArray(attribute.index);  break;
+        }
+    }
+}
+
+CLOSE_FLEXI_NAMESPACE2()
@@ -0,0 +1,125 @@
+//
+//  glParameterBlock.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include "glCapabilities.h"
+#include "glParameterBlock.h"
+#include "glStateCache.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+ParameterBlock::Ptr
+ParameterBlock::make(Program& program, const char* block_name, GLuint binding)
+{
+#ifdef GL_UNIFORM_BUFFER
+    if (!Capabilities::current().uniformBuffers()) {
+        return Ptr();
+    }
+
+    const UniformBlockInfo* block = program.findUniformBlock(block_name);
+    if (!block) {
+        cout << "Program has no uniform block " << block_name << endl;
+        return Ptr();
+    }
+
+    program.bindUniformBlock(block_name, binding);
+    return Ptr(new ParameterBlock(program, *block, binding));
+#else
+    return Ptr();
+#endif
+}
+
+ParameterBlock::ParameterBlock(const Program& program, const UniformBlockInfo& block, GLuint binding)
+    : m_buffer(0)
+    , m_binding(binding)
+    , m_size(block.data_size)
+    , m_data(new uint8_t[block.data_size])
+    , m_dirty_begin(0)
+    , m_dirty_end(0)
+{
+    memset(m_data.get(), 0, m_size);
+    for (const UniformInfo& uniform : program.uniforms()) {
+        if (uniform.block == GLint(block.index)) {
+            m_fields.push_back(uniform);
+        }
+    }
+
+#ifdef GL_UNIFORM_BUFFER
+    glGenBuffers(1, &m_buffer);
+    StateCache::current().bindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, m_size, m_data.get(), GL_DYNAMIC_DRAW);
+#endif
+}
+
+ParameterBlock::~ParameterBlock()
+{
+    StateCache::current().forgetBuffer(m_buffer);
+    glDeleteBuffers(1, &m_buffer);
+}
+
+void
+ParameterBlock::upload()
+{
+    if (m_dirty_begin >= m_dirty_end) {
+        return;
+    }
+
+#ifdef GL_UNIFORM_BUFFER
+    StateCache::current().bindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, m_dirty_begin, m_dirty_end - m_dirty_begin,
+                    m_data.get() + m_dirty_begin);
+#endif
+    m_dirty_begin = m_dirty_end = 0;
+}
+
+void
+ParameterBlock::bind()
+{
+    upload();
+#ifdef GL_UNIFORM_BUFFER
+    StateCache::current().bindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_buffer);
+#endif
+}
+
+GLint
+ParameterBlock::findOffset(const char* name, GLenum type, size_t size) const
+{
+    for (const UniformInfo& field : m_fields) {
+        if (field.name != name) {
+            continue;
+        }
+        if (field.type != type || field.offset + GLsizeiptr(size) > m_size) {
+            cout << "Block field " << name << " has type 0x" << hex << field.type
+                 << ", not 0x" << type << dec << endl;
+            return -1;
+        }
+        return field.offset;
+    }
+    return -1;
+}
+
+void
+ParameterBlock::write(GLint offset, const void* value, size_t size)
+{
+    memcpy(m_data.get() + offset, value, size);
+
+    const GLsizeiptr end = offset + GLsizeiptr(size);
+    if (m_dirty_begin >= m_dirty_end) {
+        m_dirty_begin = offset;
+        m_dirty_end = end;
+    } else {
+        m_dirty_begin = min<GLsizeiptr>(m_dirty_begin, offset);
+        m_dirty_end = max(m_dirty_end, end);
+    }
+}
+
+CLOSE_FLEXI_NAMESPACE2()
@@ -0,0 +1,239 @@
+//
+//  glProfiler.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "glCapabilities.h"
+#include "glProfiler.h"
+#include "Timer.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+static int64_t cpuNow();
+static double milliseconds(int64_t nanoseconds);
+
+GpuProfiler::Ptr
+GpuProfiler::make(unsigned latency)
+{
+#ifdef GL_TIMESTAMP
+    if (!Capabilities::current().timerQueries()) {
+        return Ptr();
+    }
+
+    // With fewer than two pools, every frame would read its own queries
+    return Ptr(new GpuProfiler(max(latency, 2u)));
+#else
+    return Ptr();
+#endif
+}
+
+GpuProfiler::GpuProfiler(unsigned latency)
+    : m_pools(latency)
+    , m_frame(0)
+    , m_in_frame(false)
+    , m_gpu_to_cpu(0)
+    , m_frames_collected(0)
+    , m_frames_dropped(0)
+{
+    for (QueryPool& pool : m_pools) {
+        pool.cpu_start = 0;
+        pool.last_query = 0;
+    }
+    calibrate();
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    for (QueryPool& pool : m_pools) {
+        if (!pool.queries.empty()) {
+            glDeleteQueries(GLsizei(pool.queries.size()), &pool.queries[0]);
+        }
+    }
+}
+
+void
+GpuProfiler::beginFrame()
+{
+    assert(!m_in_frame && "GPU profiler frames cannot overlap");
+
+    const unsigned index = m_frame % m_pools.size();
+    collect(index);
+
+    QueryPool& pool = m_pools[index];
+    pool.scopes.clear();
+    pool.cpu_start = cpuNow();
+    m_in_frame = true;
+}
+
+void
+GpuProfiler::endFrame()
+{
+    assert(m_open_scopes.empty() && "Every GPU profiler scope must end within its frame");
+    while (!m_open_scopes.empty()) {
+        end();
+    }
+
+    m_in_frame = false;
+    ++m_frame;
+}
+
+void
+GpuProfiler::begin(const char* name)
+{
+#ifdef GL_TIMESTAMP
+    if (!m_in_frame) {
+        assert(!"GPU profiler scopes must be within a frame");
+        return;
+    }
+
+    QueryPool& pool = m_pools[m_frame % m_pools.size()];
+    const size_t scope = pool.scopes.size();
+    if (pool.queries.size() < 2 * scope + 2) {
+        const size_t old_size = pool.queries.size();
+        pool.queries.resize(max(2 * scope + 2, 2 * old_size));
+        glGenQueries(GLsizei(pool.queries.size() - old_size), &pool.queries[old_size]);
+    }
+
+    glQueryCounter(pool.queries[2 * scope], GL_TIMESTAMP);
+    pool.last_query = pool.queries[2 * scope];
+
+    const PendingScope pending = { name, unsigned(m_open_scopes.size()), cpuNow(), 0 };
+    pool.scopes.push_back(pending);
+    m_open_scopes.push_back(unsigned(scope));
+#endif
+}
+
+void
+GpuProfiler::end()
+{
+#ifdef GL_TIMESTAMP
+    if (m_open_scopes.empty()) {
+        assert(!"GPU profiler scope ended without beginning");
+        return;
+    }
+
+    QueryPool& pool = m_pools[m_frame % m_pools.size()];
+    const unsigned scope = m_open_scopes.back();
+    m_open_scopes.pop_back();
+
+    glQueryCounter(pool.queries[2 * scope + 1], GL_TIMESTAMP);
+    pool.last_query = pool.queries[2 * scope + 1];
+    pool.scopes[scope].cpu_end = cpuNow();
+#endif
+}
+
+void
+GpuProfiler::collect(unsigned index)
+{
+#ifdef GL_TIMESTAMP
+    const QueryPool& pool = m_pools[index];
+    if (pool.scopes.empty()) {
+        return;
+    }
+
+    // Never wait for the GPU; a frame it has not finished is lost instead
+    GLint available = 0;
+    glGetQueryObjectiv(pool.last_query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        ++m_frames_dropped;
+        return;
+    }
+
+    m_last_frame.clear();
+    for (size_t i = 0; i < pool.scopes.size(); ++i) {
+        const PendingScope& pending = pool.scopes[i];
+        GLuint64 gpu_begin = 0, gpu_end = 0;
+        glGetQueryObjectui64v(pool.queries[2 * i], GL_QUERY_RESULT, &gpu_begin);
+        glGetQueryObjectui64v(pool.queries[2 * i + 1], GL_QUERY_RESULT, &gpu_end);
+
+        const int64_t gpu_start = pool.cpu_start - m_gpu_to_cpu;
+        const ScopeTiming timing = {
+            pending.name, pending.depth,
+            milliseconds(pending.cpu_begin - pool.cpu_start),
+            milliseconds(pending.cpu_end - pool.cpu_start),
+            milliseconds(int64_t(gpu_begin) - gpu_start),
+            milliseconds(int64_t(gpu_end) - gpu_start)
+        };
+        m_last_frame.push_back(timing);
+
+        // Scopes are told apart by name and depth, so that a pass that only
+        // runs in some frames still lines up with itself
+        vector<ScopeTotal>::iterator total = m_totals.begin();
+        while (total != m_totals.end()
+               && (total->depth != timing.depth || strcmp(total->name, timing.name) != 0))
+        {
+            ++total;
+        }
+        if (total == m_totals.end()) {
+            const ScopeTotal zero = { timing.name, timing.depth, 0, 0, 0, 0, 0 };
+            total = m_totals.insert(m_totals.end(), zero);
+        }
+        ++total->count;
+        total->cpu_begin += timing.cpu_begin;
+        total->cpu_time += timing.cpu_end - timing.cpu_begin;
+        total->gpu_begin += timing.gpu_begin;
+        total->gpu_time += timing.gpu_end - timing.gpu_begin;
+    }
+    ++m_frames_collected;
+#endif
+}
+
+void
+GpuProfiler::report()
+{
+    cout << "Profile of " << m_frames_collected << " frames (" << m_frames_dropped
+         << " dropped), in ms from each frame's start as CPU then GPU start + duration:" << endl;
+    for (const ScopeTotal& total : m_totals) {
+        cout << string(2 * (total.depth + 1), ' ') << total.name
+             << ": cpu " << total.cpu_begin / total.count << " + " << total.cpu_time / total.count
+             << ", gpu " << total.gpu_begin / total.count << " + " << total.gpu_time / total.count
+             << " (" << total.count << " calls)" << endl;
+    }
+
+    m_totals.clear();
+    m_frames_collected = 0;
+    m_frames_dropped = 0;
+
+    // The clocks drift apart over time
+    calibrate();
+}
+
+void
+GpuProfiler::calibrate()
+{
+#ifdef GL_TIMESTAMP
+    GLint64 gpu_now = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+    m_gpu_to_cpu = cpuNow() - gpu_now;
+#endif
+}
+
+#pragma mark Static Routines
+
+/// Nanoseconds on util::Timer's counter, so that profiles line up with
+/// times taken by Timers elsewhere in the engine
+static int64_t
+cpuNow()
+{
+    static const int64_t frequency = util::Timer::getFrequency();
+    const int64_t ticks = util::Timer::readCounter();
+    // Split the conversion so that large tick counts do not overflow
+    return ticks / frequency * 1000000000 + ticks % frequency * 1000000000 / frequency;
+}
+
+static double
+milliseconds(int64_t nanoseconds)
+{
+    return nanoseconds / 1e6;
+}
+
+CLOSE_FLEXI_NAMESPACE2()
@@ -8,14 +8,29 @@
 #include <iostream>
 #include <utility>
 #include <cassert>
+#include <cstring>
+#include "Timer.h"
+#include "glCapabilities.h"
 #include "glProgram.h"
+#include "glProgramCache.h"
+#include "glStateCache.h"
 
 OPEN_FLEXI_NAMESPACE2(graphics, gl)
 
 using namespace std;
+using namespace flexi::math;
 
+static GLuint startCompile(GLenum type, const char* shader);
 static GLuint compile(GLenum type, const char* shader);
-static GLuint link(GLuint* shader_handles, unsigned count);
+static uint64_t cacheKey(const ProgramBinaryCache& cache, const char* const* sources,
+                         const AttributeBindings& attributes);
+static GLuint startLink(GLuint* shader_handles, unsigned count, bool retrievable,
+                        const AttributeBindings& attributes);
+static GLuint link(GLuint* shader_handles, unsigned count, bool retrievable = false,
+                   const AttributeBindings& attributes = AttributeBindings());
+static void validate(GLuint program);
+static bool isIntegerType(GLenum type);
+static unique_ptr<GLchar[]> dumpShaderInfo(GLuint shader);
 static unique_ptr<GLchar[]> dumpProgramInfo(GLuint program);
 
 #pragma mark Program Methods
@@ -53,6 +68,7 @@ Program::Program
         // Assemble the program
         GLuint shader_handles[] = {vertex_shader_handle, fragment_shader_handle};
         m_program_handle = link(shader_handles, 2);
+        reflect();
 
     } catch (unique_ptr<GLchar>& msg) {
         glDeleteShader(vertex_shader_handle);
@@ -70,6 +86,7 @@ Program::Program(GLuint program_handle)
     : m_program_handle(program_handle)
 {
     assert(m_program_handle);
+    reflect();
 }
 
 
@@ -81,31 +98,21 @@ Program::activate()
         return false;
     }
 
-    glValidateProgram(m_program_handle);
-
-    GLint success;
-    glGetProgramiv(m_program_handle, GL_VALIDATE_STATUS, &success);
-    if (!success) {
-        cout << __FUNCTION__ << " failed with error message:\n"
-             << dumpProgramInfo(m_program_handle).get() << endl;
-
-        return false;
+    // The program was validated when it was linked; asking the driver again
+    // every frame would stall on the query
+    StateCache& cache = StateCache::current();
+    const GLuint program_to_replace = cache.program();
+    if (!cache.useProgram(m_program_handle)) {
+        return true;
     }
 
-    // Log the action and elide redundant calls
-    GLint program_to_replace;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &program_to_replace);
-    if (program_to_replace == m_program_handle) {
-        cout << "Program " << this << " (#" << m_program_handle << ") is already activated" << endl;
-        return true;
-    } else if (program_to_replace == 0) {
-        cout << "Activating Program " << this << " (#" << m_program_handle << endl;
+    if (program_to_replace == 0 || program_to_replace == StateCache::UNKNOWN) {
+        cout << "Activating Program " << this << " (#" << m_program_handle << ")" << endl;
     } else {
         cout << "Replacing program #" << program_to_replace
              << " with #" << m_program_handle << endl;
     }
 
-    glUseProgram(m_program_handle);
     assert(glGetError() == GL_NO_ERROR);
     return true;
 }
@@ -117,11 +124,9 @@ bool Program::deactivate()
         return false;
     }
 
-    GLint current_program;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &current_program);
-
-    if (current_program == m_program_handle) {
-        glUseProgram(0);
+    StateCache& cache = StateCache::current();
+    if (cache.program() == m_program_handle) {
+        cache.useProgram(0);
     } else {
         cout << "Cannot deactivate " << this << " already inactive Program " << this << endl;
         return false;
@@ -131,8 +136,165 @@ bool Program::deactivate()
 }
 
 
+void
+Program::set(Parameter<float> parameter, float value)
+{
+    assert(StateCache::current().program() == m_program_handle);
+    if (parameter.valid()) {
+        glUniform1f(parameter.location, value);
+    }
+}
+
+void
+Program::set(Parameter<GLint> parameter, GLint value)
+{
+    assert(StateCache::current().program() == m_program_handle);
+    if (parameter.valid()) {
+        glUniform1i(parameter.location, value);
+    }
+}
+
+void
+Program::set(Parameter<Vector3f> parameter, const Vector3f& value)
+{
+    assert(StateCache::current().program() == m_program_handle);
+    if (parameter.valid()) {
+        glUniform3fv(parameter.location, 1, &value.x);
+    }
+}
+
+void
+Program::set(Parameter<Vector4f> parameter, const Vector4f& value)
+{
+    assert(StateCache::current().program() == m_program_handle);
+    if (parameter.valid()) {
+        glUniform4fv(parameter.location, 1, value.adr());
+    }
+}
+
+void
+Program::set(Parameter<Matrix4x4> parameter, const Matrix4x4& value)
+{
+    assert(StateCache::current().program() == m_program_handle);
+    if (parameter.valid()) {
+        glUniformMatrix4fv(parameter.location, 1, GL_FALSE, value.adr());
+    }
+}
+
+const UniformInfo*
+Program::findUniform(const char* name) const
+{
+    for (const UniformInfo& uniform : m_uniforms) {
+        if (uniform.name == name) {
+            return &uniform;
+        }
+    }
+    return 0;
+}
+
+const UniformBlockInfo*
+Program::findUniformBlock(const char* name) const
+{
+    for (const UniformBlockInfo& block : m_uniform_blocks) {
+        if (block.name == name) {
+            return &block;
+        }
+    }
+    return 0;
+}
+
+bool
+Program::bindUniformBlock(const char* name, GLuint binding)
+{
+    const UniformBlockInfo* block = findUniformBlock(name);
+    if (!block) {
+        return false;
+    }
+
+#ifdef GL_UNIFORM_BUFFER
+    glUniformBlockBinding(m_program_handle, block->index, binding);
+#endif
+    return true;
+}
+
+void
+Program::reflect()
+{
+    if (!m_program_handle) {
+        return;
+    }
+
+    GLint count = 0, max_length = 0;
+    glGetProgramiv(m_program_handle, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_program_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+    unique_ptr<GLchar[]> name(new GLchar[max_length + 1]);
+
+    m_uniforms.resize(count);
+    for (GLint i = 0; i < count; ++i) {
+        UniformInfo& uniform = m_uniforms[i];
+        glGetActiveUniform(m_program_handle, GLuint(i), max_length + 1, 0,
+                           &uniform.size, &uniform.type, name.get());
+
+        // Arrays are reported by their first element
+        if (char* subscript = strstr(name.get(), "[0]")) {
+            *subscript = '\0';
+        }
+        uniform.name = name.get();
+        uniform.location = glGetUniformLocation(m_program_handle, name.get());
+        uniform.block = -1;
+        uniform.offset = -1;
+    }
+
+#ifdef GL_UNIFORM_BUFFER
+    if (!Capabilities::current().uniformBuffers()) {
+        return;
+    }
+
+    for (GLint i = 0; i < count; ++i) {
+        const GLuint index = GLuint(i);
+        glGetActiveUniformsiv(m_program_handle, 1, &index, GL_UNIFORM_BLOCK_INDEX, &m_uniforms[i].block);
+        glGetActiveUniformsiv(m_program_handle, 1, &index, GL_UNIFORM_OFFSET, &m_uniforms[i].offset);
+    }
+
+    GLint block_count = 0;
+    glGetProgramiv(m_program_handle, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+    glGetProgramiv(m_program_handle, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length);
+    name.reset(new GLchar[max_length + 1]);
+
+    m_uniform_blocks.resize(block_count);
+    for (GLint i = 0; i < block_count; ++i) {
+        UniformBlockInfo& block = m_uniform_blocks[i];
+        block.index = GLuint(i);
+        glGetActiveUniformBlockName(m_program_handle, block.index, max_length + 1, 0, name.get());
+        glGetActiveUniformBlockiv(m_program_handle, block.index, GL_UNIFORM_BLOCK_DATA_SIZE,
+                                  &block.data_size);
+        block.name = name.get();
+    }
+#endif
+}
+
+GLint
+Program::findLocation(const char* name, GLenum type) const
+{
+    const UniformInfo* uniform = findUniform(name);
+    if (!uniform || uniform->location < 0) {
+        return -1;
+    }
+
+    if (uniform->type != type && !(type == GL_INT && isIntegerType(uniform->type))) {
+        cout << "Uniform " << name << " of program #" << m_program_handle
+             << " has type 0x" << hex << uniform->type << ", not 0x" << type << dec << endl;
+        return -1;
+    }
+    return uniform->location;
+}
+
+
 Program::~Program()
 {
+    if (m_program_handle && StateCache::current().program() == m_program_handle) {
+        StateCache::current().useProgram(0);
+    }
     glDeleteProgram(m_program_handle);
 }
 
@@ -140,7 +302,8 @@ Program::~Program()
 #pragma mark ProgramBuilder Methods
 
 ProgramBuilder::ProgramBuilder()
-    : m_program_handle(0)
+    : m_cache(0)
+    , m_program_handle(0)
     , m_shader_handle{0,}
 {}
 
@@ -149,22 +312,20 @@ ProgramBuilder::SetShader(ShaderStage stage, const char* shader_text)
 {
     if (m_shader_handle[(unsigned)stage]) {
         glDeleteShader(m_shader_handle[(unsigned)stage]);
+        m_shader_handle[(unsigned)stage] = 0;
     }
+    m_shader_text[(unsigned)stage] = shader_text;
 
-    GLuint gl_stage;
-    switch (stage) {
-    case ShaderStage::VERTEX: gl_stage = GL_VERTEX_SHADER;      break;
-    case ShaderStage::FRAGMENT: gl_stage = GL_FRAGMENT_SHADER;  break;
-    case ShaderStage::COUNT: assert(0);                         break;
-    }
-
-    try {
-        m_shader_handle[(unsigned)stage] = compile(gl_stage, shader_text);
-    } catch (unique_ptr<GLchar[]>& msg) {
-        return move(msg);
+    if (m_cache && m_cache->enabled()) {
+        return unique_ptr<GLchar[]>();
     }
+    return Compile(stage);
+}
 
-    return unique_ptr<char[]>();
+void
+ProgramBuilder::BindAttribute(GLuint index, const char* name)
+{
+    m_attributes.push_back(make_pair(index, string(name)));
 }
 
 unique_ptr<GLchar[]>
@@ -172,14 +333,47 @@ ProgramBuilder::Link()
 {
     if (m_program_handle) {
         glDeleteProgram(m_program_handle);
+        m_program_handle = 0;
+    }
+
+    uint64_t key = 0;
+    if (m_cache) {
+        const char* sources[(unsigned)ShaderStage::COUNT];
+        for (unsigned i = 0; i < (unsigned)ShaderStage::COUNT; ++i) {
+            sources[i] = m_shader_text[i].empty() ? 0 : m_shader_text[i].c_str();
+        }
+        key = cacheKey(*m_cache, sources, m_attributes);
+
+        m_program_handle = m_cache->load(key);
+        if (m_program_handle) {
+            return unique_ptr<GLchar[]>();
+        }
+    }
+
+    util::Timer build_timer;
+    build_timer.start();
+
+    // Stages put off by the cache are compiled now that it has missed
+    for (unsigned i = 0; i < (unsigned)ShaderStage::COUNT; ++i) {
+        if (!m_shader_handle[i] && !m_shader_text[i].empty()) {
+            if (auto error_msg = Compile(ShaderStage(i))) {
+                return error_msg;
+            }
+        }
     }
 
     try {
-        m_program_handle = link(m_shader_handle, (unsigned)ShaderStage::COUNT);
+        m_program_handle = link(m_shader_handle, (unsigned)ShaderStage::COUNT,
+                                m_cache && m_cache->enabled(), m_attributes);
     } catch (unique_ptr<GLchar[]>& msg) {
         return move(msg);
     }
 
+    build_timer.stop();
+    if (m_cache) {
+        m_cache->store(key, m_program_handle, build_timer.getLastSeconds());
+    }
+
     return unique_ptr<GLchar[]>();
 }
 
@@ -200,39 +394,274 @@ ProgramBuilder::Build()
 }
 
 
+unique_ptr<GLchar[]>
+ProgramBuilder::Compile(ShaderStage stage)
+{
+    GLuint gl_stage;
+    switch (stage) {
+    case ShaderStage::VERTEX: gl_stage = GL_VERTEX_SHADER;      break;
+    case ShaderStage::FRAGMENT: gl_stage = GL_FRAGMENT_SHADER;  break;
+    case ShaderStage::COUNT: assert(0);                         break;
+    }
+
+    try {
+        m_shader_handle[(unsigned)stage] = compile(gl_stage, m_shader_text[(unsigned)stage].c_str());
+    } catch (unique_ptr<GLchar[]>& msg) {
+        return move(msg);
+    }
+
+    return unique_ptr<char[]>();
+}
+
+
+#pragma mark ProgramBatch Methods
+
+ProgramBatch::ProgramBatch(ProgramBinaryCache* cache)
+    : m_cache(cache)
+    , m_pending(0)
+{}
+
+ProgramBatch::~ProgramBatch()
+{
+    for (Entry& entry : m_entries) {
+        deleteShaders(entry);
+        glDeleteProgram(entry.program_handle);
+    }
+}
+
+ProgramBatch::Handle
+ProgramBatch::Add(const char* vertex_shader, const char* fragment_shader,
+                  const AttributeBindings& attributes)
+{
+    const Handle handle = Handle(m_entries.size());
+    m_entries.push_back(Entry());
+    Entry& entry = m_entries.back();
+    entry.shader_handle[(unsigned)ShaderStage::VERTEX] = 0;
+    entry.shader_handle[(unsigned)ShaderStage::FRAGMENT] = 0;
+    entry.program_handle = 0;
+    entry.key = 0;
+    entry.status = Status::PENDING;
+    entry.build_timer.start();
+
+    if (m_cache) {
+        const char* sources[] = {vertex_shader, fragment_shader};
+        entry.key = cacheKey(*m_cache, sources, attributes);
+        entry.program_handle = m_cache->load(entry.key);
+        if (entry.program_handle) {
+            entry.status = Status::READY;
+            return handle;
+        }
+    }
+
+    // Link straight after compiling, without asking whether the compile
+    // succeeded; a failed compile fails the link, and waiting for the
+    // answer is what this class avoids
+    if (vertex_shader) {
+        entry.shader_handle[(unsigned)ShaderStage::VERTEX] = startCompile(GL_VERTEX_SHADER, vertex_shader);
+    }
+    if (fragment_shader) {
+        entry.shader_handle[(unsigned)ShaderStage::FRAGMENT] = startCompile(GL_FRAGMENT_SHADER, fragment_shader);
+    }
+    entry.program_handle = startLink(entry.shader_handle, (unsigned)ShaderStage::COUNT,
+                                     m_cache && m_cache->enabled(), attributes);
+    ++m_pending;
+    return handle;
+}
+
+unsigned
+ProgramBatch::Poll(float budget_seconds)
+{
+    util::Timer timer;
+    timer.start();
+
+    bool completed_any = false;
+    for (Entry& entry : m_entries) {
+        if (entry.status != Status::PENDING) {
+            continue;
+        }
+        if (!isComplete(entry)) {
+            if (Capabilities::current().parallelShaderCompile()) {
+                continue;
+            }
+            timer.stop();
+            if (completed_any && timer.getTotalSeconds() >= budget_seconds) {
+                break;
+            }
+            timer.start();
+        }
+        complete(entry);
+        completed_any = true;
+    }
+
+    return m_pending;
+}
+
+void
+ProgramBatch::Finish()
+{
+    for (Entry& entry : m_entries) {
+        if (entry.status == Status::PENDING) {
+            complete(entry);
+        }
+    }
+}
+
+Program::Ptr
+ProgramBatch::Take(Handle handle, ErrorMessagePtr* error)
+{
+    Entry& entry = m_entries[handle];
+    if (entry.status == Status::PENDING) {
+        complete(entry);
+    }
+
+    switch (entry.status) {
+    case Status::READY: {
+        Program::Ptr program(new Program(entry.program_handle));
+        entry.program_handle = 0;
+        entry.status = Status::TAKEN;
+        return program;
+    }
+    case Status::FAILED:
+        if (error) {
+            *error = move(entry.error);
+        }
+        return Program::Ptr();
+    default:
+        assert(!"Cannot take a program twice");
+        return Program::Ptr();
+    }
+}
+
+bool
+ProgramBatch::isComplete(const Entry& entry) const
+{
+#ifdef GL_COMPLETION_STATUS_KHR
+    if (Capabilities::current().parallelShaderCompile()) {
+        GLint complete = GL_FALSE;
+        glGetProgramiv(entry.program_handle, GL_COMPLETION_STATUS_KHR, &complete);
+        return complete == GL_TRUE;
+    }
+#endif
+    return false;
+}
+
+void
+ProgramBatch::complete(Entry& entry)
+{
+    assert(entry.status == Status::PENDING);
+    --m_pending;
+
+    GLint success;
+    glGetProgramiv(entry.program_handle, GL_LINK_STATUS, &success);
+    entry.build_timer.stop();
+    if (success) {
+        validate(entry.program_handle);
+        if (m_cache) {
+            // Builds overlap, so this counts time spent on other programs
+            // and waiting for Poll() too; it is what the caller waited
+            m_cache->store(entry.key, entry.program_handle, entry.build_timer.getLastSeconds());
+        }
+        entry.status = Status::READY;
+    } else {
+        // A compile log says more than the link failure it caused
+        for (GLuint shader_handle : entry.shader_handle) {
+            GLint compiled = GL_TRUE;
+            if (shader_handle) {
+                glGetShaderiv(shader_handle, GL_COMPILE_STATUS, &compiled);
+            }
+            if (!compiled) {
+                entry.error = dumpShaderInfo(shader_handle);
+                break;
+            }
+        }
+        if (!entry.error) {
+            entry.error = dumpProgramInfo(entry.program_handle);
+        }
+        glDeleteProgram(entry.program_handle);
+        entry.program_handle = 0;
+        entry.status = Status::FAILED;
+    }
+
+    deleteShaders(entry);
+}
+
+void
+ProgramBatch::deleteShaders(Entry& entry)
+{
+    for (GLuint& shader_handle : entry.shader_handle) {
+        if (shader_handle) {
+            if (entry.program_handle) {
+                glDetachShader(entry.program_handle, shader_handle);
+            }
+            glDeleteShader(shader_handle);
+            shader_handle = 0;
+        }
+    }
+}
+
+
 #pragma mark Static Routines
 
 static GLuint
-compile(GLenum type, const char* shader)
+startCompile(GLenum type, const char* shader)
 {
     GLuint shader_handle = glCreateShader(type);
     glShaderSource(shader_handle, 1, &shader, 0);
     glCompileShader(shader_handle);
+    return shader_handle;
+}
+
+
+static GLuint
+compile(GLenum type, const char* shader)
+{
+    GLuint shader_handle = startCompile(type, shader);
 
     GLint success;
     glGetShaderiv(shader_handle, GL_COMPILE_STATUS, &success);
     if (!success) {
-        GLint log_length;
-        glGetShaderiv(shader_handle, GL_INFO_LOG_LENGTH, &log_length);
-        GLchar* info_log = new GLchar[log_length];
-        RETURN_ON_ALLOC_FAILURE(info_log, (glDeleteShader(shader_handle), 0));
-
-        glGetShaderInfoLog(shader_handle, log_length, 0, info_log);
-
+        unique_ptr<GLchar[]> info_log = dumpShaderInfo(shader_handle);
         glDeleteShader(shader_handle);
-        throw unique_ptr<GLchar[]>(info_log);
+        throw info_log;
     }
 
     return shader_handle;
 }
 
 
+static uint64_t
+cacheKey(const ProgramBinaryCache& cache, const char* const* sources,
+         const AttributeBindings& attributes)
+{
+    // The attribute bindings are linked into the binary too
+    string bindings;
+    for (const auto& attribute : attributes) {
+        bindings += to_string(attribute.first) + ' ' + attribute.second + '\n';
+    }
+
+    const char* keyed[(unsigned)ShaderStage::COUNT + 1];
+    for (unsigned i = 0; i < (unsigned)ShaderStage::COUNT; ++i) {
+        keyed[i] = sources[i];
+    }
+    keyed[(unsigned)ShaderStage::COUNT] = bindings.c_str();
+    return cache.key(keyed, bindings.empty() ? (unsigned)ShaderStage::COUNT
+                                             : (unsigned)ShaderStage::COUNT + 1);
+}
+
+
 static GLuint
-link(GLuint* shader_handles, unsigned count)
+startLink(GLuint* shader_handles, unsigned count, bool retrievable,
+          const AttributeBindings& attributes)
 {
     GLuint program_handle = glCreateProgram();
     assert(program_handle);
 
+#ifdef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    if (retrievable) {
+        glProgramParameteri(program_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+#endif
+
     for (unsigned i = 0; i < count; ++i)
     {
         if (shader_handles[i]) {
@@ -240,7 +669,20 @@ link(GLuint* shader_handles, unsigned count)
         }
     }
 
+    for (const auto& attribute : attributes) {
+        glBindAttribLocation(program_handle, attribute.first, attribute.second.c_str());
+    }
+
     glLinkProgram(program_handle);
+    return program_handle;
+}
+
+
+static GLuint
+link(GLuint* shader_handles, unsigned count, bool retrievable,
+     const AttributeBindings& attributes)
+{
+    GLuint program_handle = startLink(shader_handles, count, retrievable, attributes);
 
     GLint success;
     glGetProgramiv(program_handle, GL_LINK_STATUS, &success);
@@ -250,10 +692,60 @@ link(GLuint* shader_handles, unsigned count)
         throw info_log;
     }
 
+    validate(program_handle);
     return program_handle;
 }
 
 
+static void
+validate(GLuint program)
+{
+    // Validation depends on the state bound at the time, so a failure here
+    // is only a warning; the driver reports the real problem when drawing
+    glValidateProgram(program);
+
+    GLint success;
+    glGetProgramiv(program, GL_VALIDATE_STATUS, &success);
+    if (!success) {
+        cout << "Program #" << program << " failed validation with message:\n"
+             << dumpProgramInfo(program).get() << endl;
+    }
+}
+
+
+static bool
+isIntegerType(GLenum type)
+{
+    switch (type) {
+    case GL_INT:
+    case GL_BOOL:
+    case GL_SAMPLER_1D:
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_3D:
+    case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_1D_SHADOW:
+    case GL_SAMPLER_2D_SHADOW:
+        return true;
+    default:
+        return false;
+    }
+}
+
+
+static unique_ptr<GLchar[]>
+dumpShaderInfo(GLuint shader)
+{
+    GLint log_length;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
+    GLchar* info_log = new GLchar[log_length];
+    RETURN_ON_ALLOC_FAILURE(info_log, unique_ptr<GLchar[]>());
+
+    glGetShaderInfoLog(shader, log_length, 0, info_log);
+
+    return unique_ptr<GLchar[]>(info_log);
+}
+
+
 static unique_ptr<char[]>
 dumpProgramInfo(GLuint program)
 {
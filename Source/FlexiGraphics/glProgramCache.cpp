@@ -0,0 +1,182 @@
+//
+//  glProgramCache.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include "Timer.h"
+#include "glCapabilities.h"
+#include "glProgramCache.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+/// Starts every cache file, followed by the binary format and length
+static const uint32_t FILE_MAGIC = 0x31425046; // "FPB1"
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+
+static uint64_t hash(uint64_t hash, const char* text);
+
+ProgramBinaryCache::ProgramBinaryCache(const string& directory)
+    : m_directory(directory)
+    , m_driver_hash(FNV_OFFSET_BASIS)
+    , m_stats()
+{
+    if (!m_directory.empty() && m_directory[m_directory.size() - 1] != '/') {
+        m_directory += '/';
+    }
+
+    const GLenum identity[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    for (GLenum name : identity) {
+        m_driver_hash = hash(m_driver_hash, reinterpret_cast<const char*>(glGetString(name)));
+    }
+}
+
+bool
+ProgramBinaryCache::enabled() const
+{
+    return Capabilities::current().programBinaries();
+}
+
+uint64_t
+ProgramBinaryCache::key(const char* const* sources, unsigned count) const
+{
+    uint64_t key = m_driver_hash;
+    for (unsigned i = 0; i < count; ++i) {
+        // Hash the terminators too, so that moving text between stages
+        // changes the key
+        key = hash(key, sources[i]);
+        key = hash(key, "\x1f");
+    }
+    return key;
+}
+
+GLuint
+ProgramBinaryCache::load(uint64_t key)
+{
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    if (!enabled()) {
+        ++m_stats.misses;
+        return 0;
+    }
+
+    util::Timer timer;
+    timer.start();
+
+    ifstream file(path(key).c_str(), ios::binary);
+    uint32_t magic = 0, format = 0, length = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof magic);
+    file.read(reinterpret_cast<char*>(&format), sizeof format);
+    file.read(reinterpret_cast<char*>(&length), sizeof length);
+    if (!file || magic != FILE_MAGIC || !length) {
+        ++m_stats.misses;
+        return 0;
+    }
+
+    unique_ptr<char[]> binary(new char[length]);
+    if (!file.read(binary.get(), length)) {
+        ++m_stats.misses;
+        return 0;
+    }
+
+    const GLuint program = glCreateProgram();
+    glProgramBinary(program, format, binary.get(), GLsizei(length));
+
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        ++m_stats.rejected;
+        ++m_stats.misses;
+        return 0;
+    }
+
+    timer.stop();
+    ++m_stats.hits;
+    m_stats.load_seconds += timer.getLastSeconds();
+    return program;
+#else
+    ++m_stats.misses;
+    return 0;
+#endif
+}
+
+void
+ProgramBinaryCache::store(uint64_t key, GLuint program, float build_seconds)
+{
+    m_stats.build_seconds += build_seconds;
+
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    if (!enabled()) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    unique_ptr<char[]> binary(new char[length]);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.get());
+
+    // Write to a temporary file first, so that a crash cannot leave a
+    // truncated binary under the real name
+    const string file_path = path(key);
+    const string temporary_path = file_path + ".tmp";
+    {
+        ofstream file(temporary_path.c_str(), ios::binary | ios::trunc);
+        const uint32_t header[] = { FILE_MAGIC, uint32_t(format), uint32_t(length) };
+        file.write(reinterpret_cast<const char*>(header), sizeof header);
+        file.write(binary.get(), length);
+        if (!file) {
+            cout << "Could not write program binary " << temporary_path << endl;
+            return;
+        }
+    }
+    if (rename(temporary_path.c_str(), file_path.c_str()) == 0) {
+        ++m_stats.stores;
+    } else {
+        remove(temporary_path.c_str());
+    }
+#endif
+}
+
+void
+ProgramBinaryCache::report() const
+{
+    cout << "Program cache: " << m_stats.hits << " programs loaded in "
+         << m_stats.load_seconds * 1000 << " ms, " << m_stats.misses
+         << " built from source in " << m_stats.build_seconds * 1000 << " ms ("
+         << m_stats.rejected << " binaries rejected, " << m_stats.stores << " stored)" << endl;
+}
+
+string
+ProgramBinaryCache::path(uint64_t key) const
+{
+    char name[24];
+    snprintf(name, sizeof name, "%016llx.bin", static_cast<unsigned long long>(key));
+    return m_directory + name;
+}
+
+#pragma mark Static Routines
+
+static uint64_t
+hash(uint64_t hash, const char* text)
+{
+    // 64-bit FNV-1a
+    for (const char* c = text ? text : ""; *c; ++c) {
+        hash = (hash ^ uint8_t(*c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+CLOSE_FLEXI_NAMESPACE2()
@@ -0,0 +1,191 @@
+//
+//  glRingBuffer.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include "glCapabilities.h"
+#include "glRingBuffer.h"
+#include "glStateCache.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+/// Alignment for targets without rules of their own; enough for any vertex
+/// attribute or std140 member
+static const GLsizeiptr MIN_ALIGNMENT = 16;
+
+static GLsizeiptr roundUp(GLsizeiptr size, GLsizeiptr alignment);
+
+RingBuffer::Ptr
+RingBuffer::make(GLenum target, GLsizeiptr capacity)
+{
+#ifdef GL_MAP_PERSISTENT_BIT
+    if (!Capabilities::current().bufferStorage() || capacity <= 0) {
+        return Ptr();
+    }
+
+    Ptr ring(new RingBuffer(target));
+#ifdef GL_UNIFORM_BUFFER
+    if (target == GL_UNIFORM_BUFFER) {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        ring->m_alignment = max(ring->m_alignment, GLsizeiptr(alignment));
+    }
+#endif
+    // Allocations never straddle the end, so a whole number of alignments
+    // keeps the first one after wrapping aligned
+    ring->m_capacity = roundUp(capacity, ring->m_alignment);
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &ring->m_buffer);
+    StateCache::current().bindBuffer(target, ring->m_buffer);
+    glBufferStorage(target, ring->m_capacity, 0, flags);
+    ring->m_data = static_cast<uint8_t*>(glMapBufferRange(target, 0, ring->m_capacity, flags));
+    if (!ring->m_data) {
+        cout << "Could not map a " << ring->m_capacity << " byte ring buffer" << endl;
+        return Ptr();
+    }
+
+    return ring;
+#else
+    return Ptr();
+#endif
+}
+
+RingBuffer::RingBuffer(GLenum target)
+    : m_target(target)
+    , m_buffer(0)
+    , m_capacity(0)
+    , m_alignment(MIN_ALIGNMENT)
+    , m_data(0)
+    , m_head(0)
+    , m_frame_begin(0)
+{
+    m_stats.frames = 0;
+    m_stats.stalls = 0;
+    m_stats.stall_seconds = 0;
+    m_stats.bytes = 0;
+    m_stats.peak_frame_bytes = 0;
+    m_stats.failures = 0;
+}
+
+RingBuffer::~RingBuffer()
+{
+#ifdef GL_MAP_PERSISTENT_BIT
+    for (const Frame& frame : m_frames) {
+        glDeleteSync(frame.fence);
+    }
+
+    StateCache& cache = StateCache::current();
+    if (m_data) {
+        cache.bindBuffer(m_target, m_buffer);
+        glUnmapBuffer(m_target);
+    }
+    cache.forgetBuffer(m_buffer);
+    glDeleteBuffers(1, &m_buffer);
+#endif
+}
+
+RingBuffer::Allocation
+RingBuffer::allocate(GLsizeiptr size)
+{
+    const Allocation none = { 0, 0, 0 };
+    const uint64_t capacity = uint64_t(m_capacity);
+    size = roundUp(max(size, GLsizeiptr(1)), m_alignment);
+
+    // Skip the rest of the buffer rather than split the allocation
+    uint64_t position = m_head;
+    if (position % capacity + size > capacity) {
+        position += capacity - position % capacity;
+    }
+    if (position + size - m_frame_begin > capacity) {
+        ++m_stats.failures;
+        return none;
+    }
+
+    // Wait out the frames still reading the space this would take
+    while (!m_frames.empty() && position + size > m_frames.front().begin + capacity) {
+        retireOldest();
+    }
+
+    m_head = position + size;
+    const Allocation allocation = { m_data + position % capacity, GLintptr(position % capacity), size };
+    return allocation;
+}
+
+void
+RingBuffer::endFrame()
+{
+#ifdef GL_MAP_PERSISTENT_BIT
+    const GLsizeiptr frame_bytes = GLsizeiptr(m_head - m_frame_begin);
+    if (!frame_bytes) {
+        return;
+    }
+
+    ++m_stats.frames;
+    m_stats.bytes += frame_bytes;
+    m_stats.peak_frame_bytes = max(m_stats.peak_frame_bytes, frame_bytes);
+
+    const Frame frame = { glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_frame_begin };
+    m_frames.push_back(frame);
+    m_frame_begin = m_head;
+
+    // Forget frames the GPU has already finished, without waiting on the rest
+    while (!m_frames.empty()) {
+        const GLenum status = glClientWaitSync(m_frames.front().fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        glDeleteSync(m_frames.front().fence);
+        m_frames.pop_front();
+    }
+#endif
+}
+
+void
+RingBuffer::retireOldest()
+{
+#ifdef GL_MAP_PERSISTENT_BIT
+    const Frame& frame = m_frames.front();
+    GLenum status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        ++m_stats.stalls;
+        m_stall_timer.start();
+        do {
+            status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        m_stall_timer.stop();
+        m_stats.stall_seconds += m_stall_timer.getLastSeconds();
+    }
+    assert(status != GL_WAIT_FAILED);
+
+    glDeleteSync(frame.fence);
+    m_frames.pop_front();
+#endif
+}
+
+void
+RingBuffer::report() const
+{
+    cout << "Ring buffer of " << m_capacity << " bytes: " << m_stats.frames << " frames, "
+         << (m_stats.frames ? m_stats.bytes / m_stats.frames : 0) << " bytes per frame ("
+         << m_stats.peak_frame_bytes << " at most), " << m_stats.stalls << " stalls totalling "
+         << m_stats.stall_seconds * 1000 << " ms, " << m_stats.failures << " failed allocations"
+         << endl;
+}
+
+#pragma mark Static Routines
+
+static GLsizeiptr
+roundUp(GLsizeiptr size, GLsizeiptr alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+CLOSE_FLEXI_NAMESPACE2()
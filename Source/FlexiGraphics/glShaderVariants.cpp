@@ -0,0 +1,308 @@
+//
+//  glShaderVariants.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "glProgramCache.h"
+#include "glShaderVariants.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+/// Deepest nesting of includes before a cycle is assumed
+static const unsigned MAX_INCLUDE_DEPTH = 16;
+
+static bool parseInclude(const string& line, string& name);
+static size_t findVersion(const string& source);
+static unsigned glslVersion(const string& source);
+static string lineDirective(unsigned next_line, unsigned version);
+
+#pragma mark ShaderIncludes Methods
+
+ShaderIncludes::ShaderIncludes(const string& directory)
+    : m_directory(directory)
+{
+    if (!m_directory.empty() && m_directory[m_directory.size() - 1] != '/') {
+        m_directory += '/';
+    }
+}
+
+void
+ShaderIncludes::add(const string& name, const string& source)
+{
+    m_sources[name] = source;
+}
+
+bool
+ShaderIncludes::resolve(const string& source, string& expanded) const
+{
+    set<string> included;
+    expanded.clear();
+    return resolve(source, expanded, included, glslVersion(source), 0);
+}
+
+bool
+ShaderIncludes::resolve
+(
+    const string& source,
+    string& expanded,
+    set<string>& included,
+    unsigned version,
+    unsigned depth
+) const
+{
+    if (depth > MAX_INCLUDE_DEPTH) {
+        cout << "Shader includes nest more than " << MAX_INCLUDE_DEPTH << " deep" << endl;
+        return false;
+    }
+
+    istringstream lines(source);
+    string line, name;
+    for (unsigned number = 1; getline(lines, line); ++number) {
+        if (!parseInclude(line, name)) {
+            expanded += line;
+            expanded += '\n';
+            continue;
+        }
+
+        // Keep the line, so that the lines after it keep their numbers
+        if (!included.insert(name).second) {
+            expanded += '\n';
+            continue;
+        }
+
+        string include;
+        if (!find(name, include)) {
+            cout << "Cannot find shader include \"" << name << '"' << endl;
+            return false;
+        }
+        expanded += lineDirective(1, version);
+        if (!resolve(include, expanded, included, version, depth + 1)) {
+            return false;
+        }
+        expanded += lineDirective(number + 1, version);
+    }
+
+    return true;
+}
+
+bool
+ShaderIncludes::find(const string& name, string& source) const
+{
+    const auto added = m_sources.find(name);
+    if (added != m_sources.end()) {
+        source = added->second;
+        return true;
+    }
+
+    if (m_directory.empty()) {
+        return false;
+    }
+
+    ifstream file((m_directory + name).c_str());
+    if (!file) {
+        return false;
+    }
+    ostringstream contents;
+    contents << file.rdbuf();
+    source = contents.str();
+    return true;
+}
+
+
+#pragma mark ShaderVariants Methods
+
+ShaderVariants::ShaderVariants
+(
+    const ShaderIncludes& includes,
+    const char* vertex_shader,
+    const char* fragment_shader
+)
+    : m_key_bits(0)
+    , m_cache(0)
+    , m_stats()
+{
+    if (vertex_shader && !includes.resolve(vertex_shader, m_vertex_shader)) {
+        m_vertex_shader.clear();
+    }
+    if (fragment_shader && !includes.resolve(fragment_shader, m_fragment_shader)) {
+        m_fragment_shader.clear();
+    }
+}
+
+ShaderVariants::Feature
+ShaderVariants::addFeature(const char* define, unsigned bits)
+{
+    assert(bits > 0 && m_key_bits + bits <= 32 && "Permutation keys hold 32 bits of features");
+
+    const Feature feature = { m_key_bits, bits };
+    m_features.push_back(make_pair(string(define), feature));
+    m_key_bits += bits;
+    return feature;
+}
+
+Program*
+ShaderVariants::get(Key key)
+{
+    const auto found = m_variants.find(key);
+    if (found != m_variants.end()) {
+        // Variants that failed stay in the map as null
+        if (found->second) {
+            ++m_stats.hits;
+        } else {
+            ++m_stats.failed;
+        }
+        return found->second.get();
+    }
+
+    Program::Ptr& variant = m_variants[key];
+    if (m_vertex_shader.empty() && m_fragment_shader.empty()) {
+        ++m_stats.failed;
+        return 0;
+    }
+
+    const string vertex_shader = specialize(m_vertex_shader, key);
+    const string fragment_shader = specialize(m_fragment_shader, key);
+
+    ProgramBuilder builder;
+    builder.SetCache(m_cache);
+    ProgramBuilder::ErrorMessagePtr error_msg;
+    if (!vertex_shader.empty()) {
+        error_msg = builder.SetShader(ShaderStage::VERTEX, vertex_shader.c_str());
+    }
+    if (!error_msg && !fragment_shader.empty()) {
+        error_msg = builder.SetShader(ShaderStage::FRAGMENT, fragment_shader.c_str());
+    }
+    if (!error_msg) {
+        error_msg = builder.Link();
+    }
+    if (error_msg) {
+        cout << "Shader variant 0x" << hex << key << dec << " failed with message:\n"
+             << error_msg.get() << endl;
+        ++m_stats.failed;
+        return 0;
+    }
+
+    variant = builder.Build();
+    ++m_stats.compiled;
+    return variant.get();
+}
+
+void
+ShaderVariants::report() const
+{
+    cout << "Shader variants: " << m_stats.compiled << " compiled, " << m_stats.hits
+         << " reused, " << m_stats.failed << " failed" << endl;
+}
+
+string
+ShaderVariants::specialize(const string& source, Key key) const
+{
+    if (source.empty()) {
+        return source;
+    }
+
+    ostringstream defines;
+    for (const auto& feature : m_features) {
+        const unsigned value = (key >> feature.second.shift) & ((Key(1) << feature.second.bits) - 1);
+        if (value) {
+            defines << "#define " << feature.first << ' ' << value << '\n';
+        }
+    }
+
+    // Defines must follow the #version line, which comments and blank
+    // lines may precede; without one, they go first
+    const size_t version = findVersion(source);
+    if (version == string::npos) {
+        return defines.str() + lineDirective(1, glslVersion(source)) + source;
+    }
+
+    const size_t version_end = source.find('\n', version);
+    if (version_end == string::npos) {
+        return source + '\n' + defines.str();
+    }
+    const unsigned next_line = unsigned(count(source.begin(), source.begin() + version_end, '\n')) + 2;
+    return source.substr(0, version_end + 1) + defines.str()
+         + lineDirective(next_line, glslVersion(source)) + source.substr(version_end + 1);
+}
+
+
+#pragma mark Static Routines
+
+static bool
+parseInclude(const string& line, string& name)
+{
+    const size_t hash = line.find_first_not_of(" \t");
+    if (hash == string::npos || line[hash] != '#') {
+        return false;
+    }
+    const size_t directive = line.find_first_not_of(" \t", hash + 1);
+    if (directive == string::npos || line.compare(directive, 7, "include") != 0) {
+        return false;
+    }
+
+    const size_t open = line.find_first_of("\"<", directive + 7);
+    if (open == string::npos) {
+        return false;
+    }
+    const size_t close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+    if (close == string::npos) {
+        return false;
+    }
+
+    name = line.substr(open + 1, close - open - 1);
+    return true;
+}
+
+static size_t
+findVersion(const string& source)
+{
+    // Only a line that starts with the directive counts, not a mention of
+    // it in a comment
+    for (size_t line = 0; line < source.size(); ) {
+        const size_t hash = source.find_first_not_of(" \t", line);
+        if (hash != string::npos && source[hash] == '#') {
+            const size_t directive = source.find_first_not_of(" \t", hash + 1);
+            if (directive != string::npos && source.compare(directive, 7, "version") == 0) {
+                return hash;
+            }
+        }
+        line = source.find('\n', line);
+        if (line == string::npos) {
+            break;
+        }
+        ++line;
+    }
+    return string::npos;
+}
+
+static unsigned
+glslVersion(const string& source)
+{
+    unsigned version = 110;
+    const size_t hash = findVersion(source);
+    if (hash != string::npos) {
+        const size_t directive = source.find("version", hash);
+        istringstream(source.substr(directive + 7, 8)) >> version;
+    }
+    return version;
+}
+
+static string
+lineDirective(unsigned next_line, unsigned version)
+{
+    // Before GLSL 3.30, #line N numbered the line after it N + 1
+    ostringstream directive;
+    directive << "#line " << (version < 330 ? next_line - 1 : next_line) << '\n';
+    return directive.str();
+}
+
+CLOSE_FLEXI_NAMESPACE2()
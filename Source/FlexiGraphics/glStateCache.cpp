@@ -0,0 +1,256 @@
+//
+//  glStateCache.cpp
+//  Flexigin
+//
+//  Created by Steven Bloemer on 10/19/26.
+//  Copyright (c) 2026 Steven Bloemer. All rights reserved.
+//
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "glStateCache.h"
+
+OPEN_FLEXI_NAMESPACE2(graphics, gl)
+
+using namespace std;
+
+static const GLenum g_buffer_targets[] = {
+    GL_ARRAY_BUFFER,
+    GL_ELEMENT_ARRAY_BUFFER,
+#ifdef GL_UNIFORM_BUFFER
+    GL_UNIFORM_BUFFER,
+#endif
+#ifdef GL_DRAW_INDIRECT_BUFFER
+    GL_DRAW_INDIRECT_BUFFER,
+#endif
+#ifdef GL_COPY_READ_BUFFER
+    GL_COPY_READ_BUFFER,
+    GL_COPY_WRITE_BUFFER,
+#endif
+};
+
+const GLuint StateCache::UNKNOWN;
+
+StateCache&
+StateCache::current()
+{
+    static StateCache cache;
+    return cache;
+}
+
+StateCache::StateCache()
+{
+    static_assert(countof(g_buffer_targets) <= MAX_BUFFER_TARGETS, "Too many buffer targets");
+    invalidate();
+    m_last_frame = m_frame;
+}
+
+void
+StateCache::invalidate()
+{
+    m_program = UNKNOWN;
+    m_vertex_array = UNKNOWN;
+    fill(m_buffers, m_buffers + MAX_BUFFER_TARGETS, UNKNOWN);
+    fill(m_uniform_bindings, m_uniform_bindings + UNIFORM_BINDINGS, UNKNOWN);
+    fill(m_capabilities, m_capabilities + CAPABILITIES, GLenum(GL_NONE));
+    m_blend_source = m_blend_destination = UNKNOWN;
+    m_depth_func = UNKNOWN;
+    m_depth_mask = UNKNOWN;
+    m_cull_face = UNKNOWN;
+    memset(m_light_known, 0, sizeof m_light_known);
+    m_frame.calls = m_frame.calls_saved = 0;
+}
+
+bool
+StateCache::useProgram(GLuint program)
+{
+    if (!issue(program != m_program)) {
+        return false;
+    }
+    glUseProgram(m_program = program);
+    return true;
+}
+
+bool
+StateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    const unsigned slot = bufferSlot(target);
+    if (slot == MAX_BUFFER_TARGETS) {
+        glBindBuffer(target, buffer);
+        return issue(true);
+    }
+    if (!issue(buffer != m_buffers[slot])) {
+        return false;
+    }
+    glBindBuffer(target, m_buffers[slot] = buffer);
+    return true;
+}
+
+bool
+StateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+#ifdef GL_UNIFORM_BUFFER
+    const bool cached = target == GL_UNIFORM_BUFFER && index < UNIFORM_BINDINGS;
+    if (!issue(!cached || buffer != m_uniform_bindings[index])) {
+        return false;
+    }
+    if (cached) {
+        m_uniform_bindings[index] = buffer;
+    }
+
+    const unsigned slot = bufferSlot(target);
+    if (slot != MAX_BUFFER_TARGETS) {
+        m_buffers[slot] = buffer;
+    }
+    glBindBufferBase(target, index, buffer);
+    return true;
+#else
+    assert(!"Indexed buffer bindings need GL 3.0 headers");
+    return false;
+#endif
+}
+
+bool
+StateCache::bindVertexArray(GLuint vertex_array)
+{
+    if (!issue(vertex_array != m_vertex_array)) {
+        return false;
+    }
+    glBindVertexArray(m_vertex_array = vertex_array);
+#ifndef FLEXI_GL_APPLE_VERTEX_ARRAYS
+    m_buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+#endif
+    return true;
+}
+
+void
+StateCache::forgetBuffer(GLuint buffer)
+{
+    replace(m_buffers, m_buffers + MAX_BUFFER_TARGETS, buffer, UNKNOWN);
+    replace(m_uniform_bindings, m_uniform_bindings + UNIFORM_BINDINGS, buffer, UNKNOWN);
+}
+
+void
+StateCache::forgetVertexArray(GLuint vertex_array)
+{
+    if (m_vertex_array == vertex_array) {
+        m_vertex_array = UNKNOWN;
+    }
+}
+
+bool
+StateCache::setEnabled(GLenum capability, bool enabled)
+{
+    unsigned i = 0;
+    while (i < CAPABILITIES && m_capabilities[i] != capability && m_capabilities[i] != GL_NONE) {
+        ++i;
+    }
+    if (i < CAPABILITIES) {
+        if (m_capabilities[i] == capability && !issue(m_enabled[i] != enabled)) {
+            return false;
+        }
+        if (m_capabilities[i] == GL_NONE) {
+            issue(true);
+        }
+        m_capabilities[i] = capability;
+        m_enabled[i] = enabled;
+    } else {
+        // Too many capabilities to track; pass this one through
+        issue(true);
+    }
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    return true;
+}
+
+bool
+StateCache::blendFunc(GLenum source, GLenum destination)
+{
+    if (!issue(source != m_blend_source || destination != m_blend_destination)) {
+        return false;
+    }
+    glBlendFunc(m_blend_source = source, m_blend_destination = destination);
+    return true;
+}
+
+bool
+StateCache::depthFunc(GLenum func)
+{
+    if (!issue(func != m_depth_func)) {
+        return false;
+    }
+    glDepthFunc(m_depth_func = func);
+    return true;
+}
+
+bool
+StateCache::depthMask(GLboolean mask)
+{
+    if (!issue(mask != m_depth_mask)) {
+        return false;
+    }
+    m_depth_mask = mask;
+    glDepthMask(mask);
+    return true;
+}
+
+bool
+StateCache::cullFace(GLenum mode)
+{
+    if (!issue(mode != m_cull_face)) {
+        return false;
+    }
+    glCullFace(m_cull_face = mode);
+    return true;
+}
+
+bool
+StateCache::lightfv(GLenum light, GLenum parameter, const GLfloat* values)
+{
+    unsigned color;
+    switch (parameter) {
+    case GL_AMBIENT:  color = 0; break;
+    case GL_DIFFUSE:  color = 1; break;
+    case GL_SPECULAR: color = 2; break;
+    default:          color = LIGHT_COLORS; break;
+    }
+
+    const unsigned index = light - GL_LIGHT0;
+    if (index < LIGHTS && color < LIGHT_COLORS) {
+        GLfloat* cached = m_light_colors[index][color];
+        if (!issue(!m_light_known[index][color] || !equal(values, values + 4, cached))) {
+            return false;
+        }
+        copy(values, values + 4, cached);
+        m_light_known[index][color] = true;
+    } else {
+        issue(true);
+    }
+
+    glLightfv(light, parameter, values);
+    return true;
+}
+
+void
+StateCache::endFrame()
+{
+    m_last_frame = m_frame;
+    m_frame.calls = m_frame.calls_saved = 0;
+}
+
+unsigned
+StateCache::bufferSlot(GLenum target)
+{
+    for (unsigned i = 0; i < countof(g_buffer_targets); ++i) {
+        if (g_buffer_targets[i] == target) {
+            return i;
+        }
+    }
+    return MAX_BUFFER_TARGETS;
+}
+
+CLOSE_FLEXI_NAMESPACE2()
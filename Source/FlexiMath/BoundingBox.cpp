@@ -0,0 +1,170 @@
+/**
+ * @file
+ * @brief Definitions for BoundingBox class.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "BoundingBox.h"
+#include "Matrix4x3.h"
+
+namespace flexi {
+namespace math {
+namespace fpu_math {
+
+const BoundingBox BoundingBox::EMPTY;
+
+BoundingBox::BoundingBox()
+    : min(FLT_MAX, FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+{ }
+
+BoundingBox::BoundingBox(const Vector3f& min, const Vector3f& max)
+    : min(min), max(max)
+{ }
+
+bool BoundingBox::isEmpty() const
+{
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+Vector3f BoundingBox::getCenter() const
+{
+    return Vector3f((min.x + max.x) * 0.5f,
+                    (min.y + max.y) * 0.5f,
+                    (min.z + max.z) * 0.5f);
+}
+
+Vector3f BoundingBox::getExtents() const
+{
+    return Vector3f((max.x - min.x) * 0.5f,
+                    (max.y - min.y) * 0.5f,
+                    (max.z - min.z) * 0.5f);
+}
+
+void BoundingBox::setEmpty()
+{
+    min.set(FLT_MAX, FLT_MAX, FLT_MAX);
+    max.set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+}
+
+BoundingBox& BoundingBox::extend(const Vector3f& p)
+{
+    if (p.x < min.x) min.x = p.x;
+    if (p.y < min.y) min.y = p.y;
+    if (p.z < min.z) min.z = p.z;
+    if (p.x > max.x) max.x = p.x;
+    if (p.y > max.y) max.y = p.y;
+    if (p.z > max.z) max.z = p.z;
+    return *this;
+}
+
+BoundingBox& BoundingBox::extend(const BoundingBox& b)
+{
+    // An empty box has min > max, so it never moves either corner
+    if (b.min.x < min.x) min.x = b.min.x;
+    if (b.min.y < min.y) min.y = b.min.y;
+    if (b.min.z < min.z) min.z = b.min.z;
+    if (b.max.x > max.x) max.x = b.max.x;
+    if (b.max.y > max.y) max.y = b.max.y;
+    if (b.max.z > max.z) max.z = b.max.z;
+    return *this;
+}
+
+bool BoundingBox::contains(const Vector3f& p) const
+{
+    return p.x >= min.x && p.x <= max.x
+        && p.y >= min.y && p.y <= max.y
+        && p.z >= min.z && p.z <= max.z;
+}
+
+bool BoundingBox::contains(const BoundingBox& b) const
+{
+    return b.min.x >= min.x && b.max.x <= max.x
+        && b.min.y >= min.y && b.max.y <= max.y
+        && b.min.z >= min.z && b.max.z <= max.z;
+}
+
+bool BoundingBox::intersects(const BoundingBox& b) const
+{
+    return b.min.x <= max.x && b.max.x >= min.x
+        && b.min.y <= max.y && b.max.y >= min.y
+        && b.min.z <= max.z && b.max.z >= min.z;
+}
+
+bool BoundingBox::intersectsSphere(const Vector3f& center, float radius) const
+{
+    // Squared distance from the center to the nearest point of the box
+    float distanceSquared = 0;
+    for (unsigned axis = 0; axis < 3; ++axis) {
+        const float c = center.adr()[axis];
+        const float lo = min.adr()[axis], hi = max.adr()[axis];
+        const float d = c < lo ? lo - c : (c > hi ? c - hi : 0.0f);
+        distanceSquared += d * d;
+    }
+    return distanceSquared <= radius * radius;
+}
+
+bool BoundingBox::insideSphere(const Vector3f& center, float radius) const
+{
+    // Squared distance from the center to the farthest corner of the box
+    float distanceSquared = 0;
+    for (unsigned axis = 0; axis < 3; ++axis) {
+        const float c = center.adr()[axis];
+        const float d = std::max(fabsf(c - min.adr()[axis]), fabsf(max.adr()[axis] - c));
+        distanceSquared += d * d;
+    }
+    return distanceSquared <= radius * radius;
+}
+
+bool BoundingBox::intersectsRay(const Vector3f& origin, const Vector3f& inverseDirection,
+                                float maxDistance, float& entryDistance) const
+{
+    float enter = 0, exit = maxDistance;
+    for (unsigned axis = 0; axis < 3; ++axis) {
+        const float o = origin.adr()[axis], inverse = inverseDirection.adr()[axis];
+        float t0 = (min.adr()[axis] - o) * inverse;
+        float t1 = (max.adr()[axis] - o) * inverse;
+        if (t0 > t1)
+            std::swap(t0, t1);
+
+        // Comparisons with NaN (origin on a slab plane of a parallel ray) are
+        // false, which leaves enter and exit unchanged.
+        if (t0 > enter) enter = t0;
+        if (t1 < exit)  exit = t1;
+        if (enter > exit)
+            return false;
+    }
+    entryDistance = enter;
+    return true;
+}
+
+BoundingBox BoundingBox::transformed(const Matrix4x3& M) const
+{
+    if (isEmpty()) {
+        return BoundingBox();
+    }
+
+    // Transform the center, then project the extents onto each world axis
+    // (Arvo's method) instead of transforming all eight corners.
+    const float cx = (min.x + max.x) * 0.5f, ex = (max.x - min.x) * 0.5f;
+    const float cy = (min.y + max.y) * 0.5f, ey = (max.y - min.y) * 0.5f;
+    const float cz = (min.z + max.z) * 0.5f, ez = (max.z - min.z) * 0.5f;
+
+    const Vector3f* const R = M.rot;
+    const Vector3f center(cx*R[0].x + cy*R[1].x + cz*R[2].x + M.translation.x,
+                          cx*R[0].y + cy*R[1].y + cz*R[2].y + M.translation.y,
+                          cx*R[0].z + cy*R[1].z + cz*R[2].z + M.translation.z);
+    const Vector3f extents(ex*fabsf(R[0].x) + ey*fabsf(R[1].x) + ez*fabsf(R[2].x),
+                           ex*fabsf(R[0].y) + ey*fabsf(R[1].y) + ez*fabsf(R[2].y),
+                           ex*fabsf(R[0].z) + ey*fabsf(R[1].z) + ez*fabsf(R[2].z));
+
+    return BoundingBox(Vector3f(center.x - extents.x, center.y - extents.y, center.z - extents.z),
+                       Vector3f(center.x + extents.x, center.y + extents.y, center.z + extents.z));
+}
+
+} // namespace fpu_math
+} // namespace math
+} // namespace flexi
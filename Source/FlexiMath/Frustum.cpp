@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Definitions for Frustum class.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include <cmath>
+#include "BoundingBox.h"
+#include "Frustum.h"
+#include "Matrix4x3.h"
+
+namespace flexi {
+namespace math {
+namespace fpu_math {
+
+Frustum::Frustum(const float fovy, const float aspect,
+                 const float nearClip, const float farClip,
+                 const Matrix4x3& viewToWorld)
+{
+    const float tanY = tanf(fovy * 0.5f * PI / 180.0f);
+    const float tanX = tanY * aspect;
+
+    // Camera-space planes; each passes through p0 = -distance * normal
+    normal[LEFT].set( 1.0f,  0.0f, -tanX);
+    normal[RIGHT].set(-1.0f,  0.0f, -tanX);
+    normal[BOTTOM].set(0.0f,  1.0f, -tanY);
+    normal[TOP].set(   0.0f, -1.0f, -tanY);
+    normal[NEAR_PLANE].set(0.0f, 0.0f, -1.0f);
+    normal[FAR_PLANE].set( 0.0f, 0.0f,  1.0f);
+
+    const Vector3f origin = viewToWorld.getTranslation();
+    for (unsigned i = 0; i < PLANE_COUNT; ++i) {
+        const Vector3f n = normal[i].getNormalized();
+        const Vector3f* const R = viewToWorld.rot;
+        normal[i].set(n.x*R[0].x + n.y*R[1].x + n.z*R[2].x,
+                      n.x*R[0].y + n.y*R[1].y + n.z*R[2].y,
+                      n.x*R[0].z + n.y*R[1].z + n.z*R[2].z);
+        normal[i].normalized();
+    }
+
+    // The side planes pass through the eye; near and far are offset along -z
+    for (unsigned i = LEFT; i <= TOP; ++i) {
+        distance[i] = -normal[i].dot(origin);
+    }
+    distance[NEAR_PLANE] = -normal[NEAR_PLANE].dot(origin) - nearClip;
+    distance[FAR_PLANE]  = -normal[FAR_PLANE].dot(origin) + farClip;
+}
+
+Frustum::Containment
+Frustum::classify(const BoundingBox& box, unsigned& planeMask) const
+{
+    if (box.isEmpty()) {
+        return OUTSIDE;
+    }
+
+    const float cx = (box.min.x + box.max.x) * 0.5f, ex = (box.max.x - box.min.x) * 0.5f;
+    const float cy = (box.min.y + box.max.y) * 0.5f, ey = (box.max.y - box.min.y) * 0.5f;
+    const float cz = (box.min.z + box.max.z) * 0.5f, ez = (box.max.z - box.min.z) * 0.5f;
+
+    for (unsigned i = 0; i < PLANE_COUNT; ++i) {
+        const unsigned bit = 1u << i;
+        if (!(planeMask & bit)) {
+            continue;
+        }
+
+        const Vector3f& n = normal[i];
+        const float s = n.x*cx + n.y*cy + n.z*cz + distance[i];
+        const float r = ex*fabsf(n.x) + ey*fabsf(n.y) + ez*fabsf(n.z);
+
+        if (s < -r) {
+            return OUTSIDE;
+        } else if (s >= r) {
+            planeMask &= ~bit;
+        }
+    }
+
+    return planeMask ? INTERSECTS : INSIDE;
+}
+
+Frustum::Containment Frustum::classify(const BoundingBox& box) const
+{
+    unsigned planeMask = ALL_PLANES;
+    return classify(box, planeMask);
+}
+
+bool Frustum::intersects(const BoundingBox& box) const
+{
+    return classify(box) != OUTSIDE;
+}
+
+} // namespace fpu_math
+} // namespace math
+} // namespace flexi
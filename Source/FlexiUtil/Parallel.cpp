@@ -0,0 +1,276 @@
+/**
+ * @file
+ * @brief Definitions for parallelFor and the thread pool behind it.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "Parallel.h"
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include "windows.h"
+#else
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+
+namespace flexi {
+namespace util {
+
+namespace {
+
+/// Shared by the threads of one parallelFor call
+struct Work
+{
+    const std::function<void (unsigned)>* task;
+    unsigned taskCount;
+#ifdef _WIN32
+    volatile LONG next;
+#else
+    std::atomic<unsigned> next;
+#endif
+
+    /// Runs tasks until none are left
+    void run() {
+        for (;;) {
+#ifdef _WIN32
+            const unsigned index = unsigned(InterlockedIncrement(&next) - 1);
+#else
+            const unsigned index = next.fetch_add(1);
+#endif
+            if (index >= taskCount)
+                return;
+            (*task)(index);
+        }
+    }
+};
+
+/**
+ * Threads kept for the life of the program and woken for each parallelFor
+ * call, so that a call costs a wake-up rather than a thread start per core.
+ * Every pool thread takes part in every call; those that find no task left
+ * go straight back to sleep.
+ */
+class WorkerPool
+{
+    WorkerPool(const WorkerPool&);
+    WorkerPool& operator=(const WorkerPool&);
+
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    /**
+     * Runs @a work on the calling thread and every pool thread. Returns false,
+     * without running anything, if another call is using the pool, as when
+     * parallelFor is called from within a task.
+     */
+    bool run(Work& work);
+
+private:
+    void start(unsigned threadCount);
+    void loop();
+#ifdef _WIN32
+    static DWORD WINAPI threadMain(LPVOID pool);
+#endif
+
+private:
+    Work* work;
+    bool stopping;
+    /// Set once start() has run, so that a pool that got no threads does not
+    /// try again on every call
+    bool started;
+#ifdef _WIN32
+    volatile LONG inUse;
+    volatile LONG busy;
+    HANDLE wake;
+    HANDLE done;
+    std::vector<HANDLE> threads;
+#else
+    std::atomic<bool> inUse;
+    unsigned busy;
+    unsigned generation;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::vector<std::thread> threads;
+#endif
+};
+
+WorkerPool::WorkerPool()
+    : work(0), stopping(false), started(false), inUse(false), busy(0)
+#ifdef _WIN32
+    , wake(CreateSemaphore(0, 0, LONG_MAX, 0))
+    , done(CreateEvent(0, FALSE, FALSE, 0))
+#else
+    , generation(0)
+#endif
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+#ifdef _WIN32
+    stopping = true;
+    if (!threads.empty())
+        ReleaseSemaphore(wake, LONG(threads.size()), 0);
+    // One at a time, since WaitForMultipleObjects takes at most 64 handles
+    for (size_t i = 0; i < threads.size(); ++i) {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+    }
+    CloseHandle(wake);
+    CloseHandle(done);
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+#endif
+}
+
+bool WorkerPool::run(Work& work)
+{
+#ifdef _WIN32
+    if (InterlockedCompareExchange(&inUse, 1, 0) != 0)
+        return false;
+#else
+    if (inUse.exchange(true))
+        return false;
+#endif
+
+    // The calling thread is one of the workers
+    if (!started) {
+        started = true;
+        start(getWorkerCount() - 1);
+    }
+
+#ifdef _WIN32
+    this->work = &work;
+    busy = LONG(threads.size());
+    if (busy)
+        ReleaseSemaphore(wake, busy, 0);
+    work.run();
+    if (!threads.empty())
+        WaitForSingleObject(done, INFINITE);
+    InterlockedExchange(&inUse, 0);
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->work = &work;
+        busy = unsigned(threads.size());
+        ++generation;
+    }
+    wake.notify_all();
+    work.run();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (busy)
+            done.wait(lock);
+    }
+    inUse = false;
+#endif
+    return true;
+} // WorkerPool::run()
+
+void WorkerPool::start(unsigned threadCount)
+{
+    for (unsigned i = 0; i < threadCount; ++i) {
+#ifdef _WIN32
+        const HANDLE thread = CreateThread(0, 0, threadMain, this, 0, 0);
+        // Carry on with the threads we have; with none, tasks run on the caller
+        if (!thread)
+            break;
+        threads.push_back(thread);
+#else
+        try {
+            threads.push_back(std::thread(&WorkerPool::loop, this));
+        } catch (const std::system_error&) {
+            // As above: carry on with the threads we have
+            break;
+        }
+#endif
+    }
+} // WorkerPool::start()
+
+void WorkerPool::loop()
+{
+#ifdef _WIN32
+    for (;;) {
+        WaitForSingleObject(wake, INFINITE);
+        if (stopping)
+            return;
+        work->run();
+        if (InterlockedDecrement(&busy) == 0)
+            SetEvent(done);
+    }
+#else
+    unsigned seen = 0;
+    for (;;) {
+        Work* current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping && generation == seen)
+                wake.wait(lock);
+            if (stopping)
+                return;
+            seen = generation;
+            current = work;
+        }
+        current->run();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0)
+                done.notify_one();
+        }
+    }
+#endif
+} // WorkerPool::loop()
+
+#ifdef _WIN32
+DWORD WINAPI WorkerPool::threadMain(LPVOID pool)
+{
+    static_cast<WorkerPool*>(pool)->loop();
+    return 0;
+}
+#endif
+
+WorkerPool pool;
+
+} // namespace
+
+unsigned getWorkerCount()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const unsigned count = unsigned(info.dwNumberOfProcessors);
+#else
+    const unsigned count = std::thread::hardware_concurrency();
+#endif
+    return count ? count : 1;
+} // getWorkerCount()
+
+void parallelFor(unsigned taskCount, const std::function<void (unsigned)>& task)
+{
+    Work work;
+    work.task = &task;
+    work.taskCount = taskCount;
+    work.next = 0;
+
+    // A lone task, a single core or a busy pool: run on the calling thread
+    if (taskCount <= 1 || getWorkerCount() <= 1 || !pool.run(work))
+        work.run();
+} // parallelFor()
+
+} // namespace util
+} // namespace flexi
@@ -3,26 +3,54 @@
  * @brief Definitions for Timer class.
  * @author   Steven Bloemer
  * @date     12/9/2010
- * @lastedit 12/9/2010
+ * @lastedit 10/19/2026
  */
 #include "Timer.h"
 #include "DebugDefs.h"
+#ifndef _WIN32
+#include <chrono>
+#endif
 
 namespace flexi {
 namespace util {
 
 float Timer::period = 0.0f; // Initializes static class variable
 
-void Timer::start()
+Timer::Ticks Timer::readCounter()
 {
-    // Get the current time
+#ifdef _WIN32
     LARGE_INTEGER now;
     QueryPerformanceCounter(&now);
+    return now.QuadPart;
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+} // Timer::readCounter()
+
+Timer::Ticks Timer::getFrequency()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    BOOL supportsCounter = QueryPerformanceFrequency(&frequency);
+    flexiAssert(supportsCounter != 0); // bail if counter unsupported
+    flexiAssert(frequency.QuadPart > 0);
+    return frequency.QuadPart;
+#else
+    typedef std::chrono::steady_clock::period Period;
+    static_assert(Period::num == 1, "steady_clock must tick a whole number of times per second");
+    return Period::den;
+#endif
+} // Timer::getFrequency()
+
+void Timer::start()
+{
+    // Get the current time
+    const Ticks now = readCounter();
 
     // If the timer is currently running, stop it.
-    if (startTime.QuadPart != -1) {
-        lastDelta.QuadPart = now.QuadPart - startTime.QuadPart;
-        totalTime.QuadPart += lastDelta.QuadPart;
+    if (startTime != -1) {
+        lastDelta = now - startTime;
+        totalTime += lastDelta;
         ++intervalCount;
     } // Timer is now definitely stopped
 
@@ -31,17 +59,16 @@ void Timer::start()
 
 void Timer::stop()
 {
-    flexiAssert(startTime.QuadPart == -1);
+    flexiAssert(startTime != -1);
 
     // Get the current time
-    LARGE_INTEGER now;
-    QueryPerformanceCounter(&now);
+    const Ticks now = readCounter();
 
     // Record the last interval and stop the timer
-    lastDelta.QuadPart = now.QuadPart - startTime.QuadPart;
-    totalTime.QuadPart += lastDelta.QuadPart;
+    lastDelta = now - startTime;
+    totalTime += lastDelta;
     ++intervalCount;
-    startTime.QuadPart = -1; // Signals that the timer is stopped
+    startTime = -1; // Signals that the timer is stopped
 } // Timer::stop()
 
 void Timer::reset()
@@ -50,9 +77,9 @@ void Timer::reset()
     // initialization. This is enforced by the invariants of intervalCount
     
     // The start time is -1 when the timer is not running
-    startTime.QuadPart = -1;
+    startTime = -1;
 
-    totalTime.QuadPart = 0;
+    totalTime = 0;
          intervalCount = 0;
 } // Timer::reset()
 
@@ -63,7 +90,7 @@ float Timer::getLastSeconds() const
         return -1.0f;
     } else {
         // Compute the time in seconds of the last interval and return it
-        return (lastDelta.QuadPart * Timer::period);
+        return (lastDelta * Timer::period);
     }
 } // Timer::getLastSeconds()
 
@@ -74,7 +101,7 @@ float Timer::getTotalSeconds() const
         return -1.0f;
     } else {
         // Compute the time in seconds of the total time and return it
-        return (totalTime.QuadPart * Timer::period);
+        return (totalTime * Timer::period);
     }
 } // Timer::getTotalSeconds()
 
@@ -85,7 +112,7 @@ float Timer::getAvgSeconds() const
         return -1.0f;
     } else {
         // Compute the average interval time
-        const double avg = totalTime.QuadPart / double(intervalCount);
+        const double avg = totalTime / double(intervalCount);
         // Convert to seconds and return
         return float(avg * Timer::period);
     }
@@ -100,12 +127,7 @@ Timer::Timer()
 {
     // Initialize cycle period if not already initialized
     if (Timer::period == 0.0f) {
-        LARGE_INTEGER frequency;
-        BOOL supportsCounter = QueryPerformanceFrequency(&frequency);
-        flexiAssert(supportsCounter != 0); // bail if counter unsupported
-        flexiAssert(frequency.QuadPart > 0);
-        // From here on we can assume that high performance counters are supported
-        Timer::period = 1.0f / frequency.QuadPart;
+        Timer::period = float(1.0 / getFrequency());
     }
     // Initialize fields
     reset();
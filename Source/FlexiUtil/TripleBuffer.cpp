@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @brief Definitions for TripleBufferSlots.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "TripleBuffer.h"
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include "windows.h"
+#endif
+
+namespace flexi {
+namespace util {
+
+namespace {
+
+const long FRESH = 4;
+const long SLOT_MASK = 3;
+
+/// Atomically stores @a value in @a target, returning what it held before
+long exchange(volatile long& target, long value)
+{
+#ifdef _WIN32
+    return InterlockedExchange(&target, value);
+#else
+    return __atomic_exchange_n(&target, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+long load(const volatile long& source)
+{
+#ifdef _WIN32
+    // Aligned reads of volatile longs acquire under Visual C++
+    return source;
+#else
+    return __atomic_load_n(&source, __ATOMIC_ACQUIRE);
+#endif
+}
+
+} // namespace
+
+TripleBufferSlots::TripleBufferSlots()
+    : shared(1), back(2), front(0) {}
+
+bool TripleBufferSlots::publish()
+{
+    const long previous = exchange(shared, long(back) | FRESH);
+    back = unsigned(previous & SLOT_MASK);
+    return (previous & FRESH) != 0;
+} // TripleBufferSlots::publish()
+
+bool TripleBufferSlots::acquire()
+{
+    if (!(load(shared) & FRESH))
+        return false;
+    // Only the reader clears FRESH, so the shared slot is still fresh here
+    front = unsigned(exchange(shared, long(front)) & SLOT_MASK);
+    return true;
+} // TripleBufferSlots::acquire()
+
+} // namespace util
+} // namespace flexi
@@ -5,19 +5,22 @@
 //  Created by Steven Bloemer on 11/22/12.
 //  Copyright (c) 2012 Steven Bloemer. All rights reserved.
 //
+#include <chrono>
 #include <iostream>
 #include <cstdint>
+#include <cstring>
 
 #include "FlexiMath.h"
 #include "Neverland.h"
+#include "glCapabilities.h"
 
 using namespace std;
 using namespace flexi::math;
 
 struct Vertex
 {
-    static const unsigned POSITION_OFFSET = 0;
-    static const unsigned NORMAL_OFFSET   = sizeof(Vector3f);
+    static const unsigned POSITION_OFFSET = sizeof(Vector3f);
+    static const unsigned NORMAL_OFFSET   = 0;
     
     Vector3f normal;
     Vector3f position;
@@ -82,27 +85,300 @@ static const uint16_t g_cube_indices[] = {
     20, 21, 22,  20, 22, 23, // Bottom
 };
 
+static const uint32_t CUBE_MESH = 0;
+/// Cubes along each side of the grid
+static const unsigned CUBE_GRID = 8;
+/// Frames averaged by each draw time report
+static const unsigned DRAW_REPORT_FRAMES = 100;
+/// The first of the four attributes holding each instance's transform
+static const GLuint INSTANCE_ATTRIBUTE = 12;
+/// Frames of instance transforms the ring buffer holds
+static const unsigned STREAMED_FRAMES = 3;
+/// Where linked programs are kept between runs; must exist
+static const char* const PROGRAM_CACHE_DIRECTORY = "/tmp";
+/// Seconds each frame may spend waiting on program builds
+static const float PROGRAM_BUILD_BUDGET = 0.002f;
+
+#define IMMEDIATE      0
+#define DRAW_ARRAYS    1
+#define DRAW_ELEMENTS  2 // From client arrays
+#define BUFFER_OBJECTS 3 // From the cube's gl::Mesh
+#define INSTANCED      4 // One instanced draw of the cube's gl::Mesh
+#define MULTI_DRAW_INDIRECT 5 // One indirect draw per state bucket from a gl::MeshPool
+#define TECHNIQUE MULTI_DRAW_INDIRECT
+
+/// Transforms each cube by its instance's axes and translation, then lights
+/// it the way the fixed-function pipeline does for BUFFER_OBJECTS: one
+/// directional light, a local viewer and per-vertex shading
+static const char* g_instanced_vertex_shader =
+    "#version 120\n"
+    "attribute vec3 instance_x, instance_y, instance_z, instance_translation;\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    vec3 position = gl_Vertex.x * instance_x + gl_Vertex.y * instance_y\n"
+    "                  + gl_Vertex.z * instance_z + instance_translation;\n"
+    "    vec3 normal = gl_Normal.x * instance_x + gl_Normal.y * instance_y + gl_Normal.z * instance_z;\n"
+    "    vec4 eye = gl_ModelViewMatrix * vec4(position, 1.0);\n"
+    "    vec3 n = normalize(gl_NormalMatrix * normal);\n"
+    "    vec3 l = normalize(gl_LightSource[0].position.xyz);\n"
+    "    vec3 h = normalize(l - normalize(eye.xyz));\n"
+    "    float diffuse = max(dot(n, l), 0.0);\n"
+    "    float specular = diffuse > 0.0 ? pow(max(dot(n, h), 0.0), gl_FrontMaterial.shininess) : 0.0;\n"
+    "    color = gl_FrontLightModelProduct.sceneColor + gl_FrontLightProduct[0].ambient\n"
+    "          + diffuse * gl_FrontLightProduct[0].diffuse + specular * gl_FrontLightProduct[0].specular;\n"
+    "    color.a = gl_FrontMaterial.diffuse.a;\n"
+    "    gl_Position = gl_ProjectionMatrix * eye;\n"
+    "}\n";
+
+static const char* g_instanced_fragment_shader =
+    "#version 120\n"
+    "varying vec4 color;\n"
+    "void main() {\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+/// Draws a snapshot's items with the fixed-function pipeline, from buffer
+/// objects when given the cube mesh and from client arrays otherwise
+struct FixedFunctionSubmitter
+{
+    gl::Mesh* mesh;
+
+    explicit FixedFunctionSubmitter(gl::Mesh* mesh) : mesh(mesh) {}
+
+    ~FixedFunctionSubmitter() {
+        if (mesh) {
+            mesh->unbind();
+        }
+    }
+
+    void bindProgram(uint32_t) {}
+    void bindMaterial(uint32_t) {}
+
+    void bindMesh(uint32_t mesh_id) {
+        assert(mesh_id == CUBE_MESH);
+        if (mesh) {
+            mesh->bind();
+        } else {
+            glInterleavedArrays(GL_N3F_V3F, 0, g_cube_vertices);
+        }
+    }
+
+    void draw(const DrawItem& item) {
+        glPushMatrix();
+        glMultMatrixf(Matrix4x4(*item.transform).adr());
+        if (mesh) {
+            mesh->draw();
+        } else {
+            glDrawElements(GL_TRIANGLES,
+                           array_size(g_cube_indices),
+                           GL_UNSIGNED_SHORT,
+                           g_cube_indices);
+        }
+        glPopMatrix();
+    }
+};
+
+/// The layout of g_cube_vertices
+static gl::VertexLayout cubeLayout()
+{
+    return gl::VertexLayout(sizeof(Vertex), {
+        { gl::VertexSemantic::NORMAL,   3, GL_FLOAT, Vertex::NORMAL_OFFSET,   0, GL_FALSE },
+        { gl::VertexSemantic::POSITION, 3, GL_FLOAT, Vertex::POSITION_OFFSET, 0, GL_FALSE },
+    });
+}
+
+/// Points @a instances at @a count transforms, written into the ring buffer
+/// if there is one and uploaded to the instance buffer otherwise
+static void streamInstances(gl::InstanceBuffer& instances, gl::RingBuffer* ring,
+                            const Matrix4x3* transforms, size_t count)
+{
+    const GLsizeiptr size = GLsizeiptr(count * sizeof(Matrix4x3));
+    const gl::RingBuffer::Allocation allocation = ring ? ring->allocate(size)
+                                                       : gl::RingBuffer::Allocation();
+    if (ring && allocation.data) {
+        memcpy(allocation.data, transforms, size);
+        instances.bind(ring->buffer(), allocation.offset);
+    } else {
+        instances.update(transforms, GLsizei(count));
+        instances.bind();
+    }
+}
+
+/// Draws each group of a snapshot's items with one instanced draw of the
+/// cube mesh, reading their transforms from an instance buffer
+struct InstancedSubmitter
+{
+    gl::Program& program;
+    gl::Mesh& mesh;
+    gl::InstanceBuffer& instances;
+    gl::RingBuffer* ring;
+    std::vector<Matrix4x3>& transforms;
+
+    InstancedSubmitter(gl::Program& program, gl::Mesh& mesh, gl::InstanceBuffer& instances,
+                       gl::RingBuffer* ring, std::vector<Matrix4x3>& transforms)
+        : program(program), mesh(mesh), instances(instances), ring(ring), transforms(transforms)
+    {}
+
+    ~InstancedSubmitter() {
+        instances.unbind();
+        mesh.unbind();
+        program.deactivate();
+    }
+
+    void bindProgram(uint32_t) { program.activate(); }
+    void bindMaterial(uint32_t) {}
+
+    void bindMesh(uint32_t mesh_id) {
+        assert(mesh_id == CUBE_MESH);
+        mesh.bind();
+    }
+
+    void drawInstances(const DrawItem* const* items, size_t count) {
+        transforms.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            transforms[i] = *items[i]->transform;
+        }
+        streamInstances(instances, ring, &transforms[0], count);
+        mesh.drawInstanced(GLsizei(count));
+    }
+};
+
+/// Writes each group of a snapshot's items into an indirect buffer, to be
+/// drawn once the whole snapshot has been submitted, and their transforms
+/// into one array that every indirect command indexes
+struct MultiDrawSubmitter
+{
+    gl::DrawIndirectBuffer& draws;
+    const gl::MeshPool::Range& cube;
+    std::vector<Matrix4x3>& transforms;
+
+    MultiDrawSubmitter(gl::DrawIndirectBuffer& draws, const gl::MeshPool::Range& cube,
+                       std::vector<Matrix4x3>& transforms)
+        : draws(draws), cube(cube), transforms(transforms)
+    {
+        draws.clear();
+        transforms.clear();
+    }
+
+    // The pool holds every mesh, so only program and material changes need
+    // a bucket of their own
+    void bindProgram(uint32_t) { draws.startBucket(); }
+    void bindMaterial(uint32_t) { draws.startBucket(); }
+    void bindMesh(uint32_t mesh_id) { assert(mesh_id == CUBE_MESH); }
+
+    void drawInstances(const DrawItem* const* items, size_t count) {
+        draws.add(cube, GLuint(count), GLuint(transforms.size()));
+        for (size_t i = 0; i < count; ++i) {
+            transforms.push_back(*items[i]->transform);
+        }
+    }
+};
+
 Neverland::Neverland()
-    : m_clear_color(Color4f(0,0,0))
+    : m_frame(0)
+    , m_simulating(true)
+    , m_clear_color(Color4f(0,0,0))
     , m_light(Vector4f(-1, -1, 1, 0),       // Position
               Vector4f(0.3f, 0.3, 0.3f),    // Ambient color
               Vector4f(0.7f, 0.7f, 0.7f),   // Diffuse color
               Vector4f(1, 1, 1))            // Specular color
 {
     m_dirty_state.dirty = ~0;
+
+    for (unsigned i = 0; i < CUBE_GRID * CUBE_GRID * CUBE_GRID; ++i) {
+        DrawableNode* cube = new DrawableNode(0, 0, CUBE_MESH);
+        m_scene.setLocalBounds(*cube, BoundingBox(Vector3f(-0.5f, -0.5f, -0.5f),
+                                                  Vector3f( 0.5f,  0.5f,  0.5f)));
+        m_scene.addChild(m_scene.getRoot(), *cube);
+        m_cubes.push_back(cube);
+    }
+
+    // Publish the first frame before anything can be drawn
+    step();
+    m_simulation = std::thread(&Neverland::simulate, this);
+}
+
+Neverland::~Neverland()
+{
+    m_simulating = false;
+    m_simulation.join();
+}
+
+void Neverland::simulate()
+{
+    while (m_simulating) {
+        step();
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+}
+
+void Neverland::step()
+{
+    ++m_frame;
+
+    // Spin each cube of the grid a little out of step with its neighbours
+    const Vector3f axis = Vector3f(0.5f, 0.5f, 0.3f).normalized();
+    const float half_grid = (CUBE_GRID - 1) / 2.0f;
+    for (unsigned i = 0; i < m_cubes.size(); ++i) {
+        const unsigned x = i % CUBE_GRID, y = i / CUBE_GRID % CUBE_GRID, z = i / (CUBE_GRID * CUBE_GRID);
+        const Vector3f position((x - half_grid) * 1.5f, (y - half_grid) * 1.5f, -20.0f - z * 2);
+        const RotationMatrix spin(axis, (m_frame + i * 7) * PI / 180);
+        m_scene.setLocalTransform(*m_cubes[i], Matrix4x3(spin, Vector3f(1, 1, 1), position));
+    }
+    m_scene.updateTransforms();
+
+    m_snapshots.getBack().capture(m_scene, SceneSnapshot::View(), m_frame);
+    m_snapshots.publish();
 }
 
 void Neverland::draw(unsigned width, unsigned height)
 {
     cout << __FUNCTION__ << '(' << width << ", " << height << ')' << endl ;
 
+    m_snapshots.acquire();
+
     updateDrawState();
+    collectPrograms();
+
+    if (m_profiler) {
+        m_profiler->beginFrame();
+    }
+    {
+        gl::GpuProfiler::Scope frame_scope(m_profiler.get(), "draw");
+
+        m_camera.handleDimensionChange(width, height);
 
-    m_camera.handleDimensionChange(width, height);
+        {
+            gl::GpuProfiler::Scope clear_scope(m_profiler.get(), "clear");
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        }
 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        gl::GpuProfiler::Scope draw_scope(m_profiler.get(), "drawStuff");
+        m_draw_timer.start();
+        drawStuff();
+        m_draw_timer.stop();
+    }
+    if (m_profiler) {
+        m_profiler->endFrame();
+    }
+    if (m_ring) {
+        m_ring->endFrame();
+    }
 
-    drawStuff();
+    gl::StateCache& state = gl::StateCache::current();
+    state.endFrame();
+    if (m_draw_timer.getIntervalCount() == DRAW_REPORT_FRAMES) {
+        cout << "drawStuff averaged " << m_draw_timer.getAvgSeconds() * 1000 << " ms over "
+             << DRAW_REPORT_FRAMES << " frames; last frame made " << state.lastFrame().calls
+             << " state calls and saved " << state.lastFrame().calls_saved << endl;
+        m_draw_timer.reset();
+        if (m_ring) {
+            m_ring->report();
+        }
+        if (m_profiler) {
+            m_profiler->report();
+        }
+    }
 
     glFlush();
 }
@@ -121,12 +397,38 @@ void Neverland::updateDrawState()
 
     UPDATE_STATE(clear_color,
         glClearColor(clearColor().r, clearColor().g, clearColor().b, clearColor().a))
-    UPDATE_STATE(depth_test, glEnable(GL_DEPTH_TEST))
-    UPDATE_STATE(vertex_array, glEnableClientState(GL_VERTEX_ARRAY))
+    UPDATE_STATE(depth_test, gl::StateCache::current().enable(GL_DEPTH_TEST))
+    UPDATE_STATE(vertex_array, {
+        glEnableClientState(GL_VERTEX_ARRAY);
+
+        m_cube_mesh = gl::Mesh::make(cubeLayout(),
+                                     g_cube_vertices, array_size(g_cube_vertices),
+                                     g_cube_indices, GL_UNSIGNED_SHORT, array_size(g_cube_indices));
+
+        // Without instanced arrays, INSTANCED and MULTI_DRAW_INDIRECT fall back
+        // to BUFFER_OBJECTS
+        if ((TECHNIQUE == INSTANCED || TECHNIQUE == MULTI_DRAW_INDIRECT)
+            && gl::Capabilities::current().instancedArrays())
+        {
+            // Built in the background; until it is ready, frames are drawn
+            // as for BUFFER_OBJECTS
+            m_program_cache.reset(new gl::ProgramBinaryCache(PROGRAM_CACHE_DIRECTORY));
+            m_program_batch.reset(new gl::ProgramBatch(m_program_cache.get()));
+
+            gl::AttributeBindings attributes;
+            attributes.push_back(make_pair(INSTANCE_ATTRIBUTE + 0, string("instance_x")));
+            attributes.push_back(make_pair(INSTANCE_ATTRIBUTE + 1, string("instance_y")));
+            attributes.push_back(make_pair(INSTANCE_ATTRIBUTE + 2, string("instance_z")));
+            attributes.push_back(make_pair(INSTANCE_ATTRIBUTE + 3, string("instance_translation")));
+            m_instanced_program = m_program_batch->Add(g_instanced_vertex_shader,
+                                                       g_instanced_fragment_shader, attributes);
+        }
+    })
     UPDATE_STATE(lighting, {
 
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
+        gl::StateCache& state = gl::StateCache::current();
+        state.enable(GL_CULL_FACE);
+        state.cullFace(GL_BACK);
 
         GLfloat ambient_material[4] = { 0.3f, 0, 0, 1.0f };
         glMaterialfv(GL_FRONT, GL_AMBIENT, ambient_material);
@@ -141,19 +443,49 @@ void Neverland::updateDrawState()
         glMaterialfv(GL_FRONT, GL_SHININESS, mat_shininess);
 
         glShadeModel(GL_SMOOTH);
-        glEnable(GL_LIGHTING);
+        state.enable(GL_LIGHTING);
         glLightModeli(GL_LIGHT_MODEL_LOCAL_VIEWER, GL_TRUE);
     })
+    UPDATE_STATE(profiler, m_profiler = gl::GpuProfiler::make())
 }
 
-#define IMMEDIATE     0
-#define DRAW_ARRAYS   1
-#define DRAW_ELEMENTS 2
-#define TECHNIQUE DRAW_ELEMENTS
+void Neverland::collectPrograms()
+{
+    if (!m_program_batch || m_program_batch->Poll(PROGRAM_BUILD_BUDGET)) {
+        return;
+    }
+
+    gl::ProgramBatch::ErrorMessagePtr error_msg;
+    m_program = m_program_batch->Take(m_instanced_program, &error_msg);
+    m_program_batch.reset();
+    m_program_cache->report();
+    if (!m_program) {
+        cout << "Instanced program failed with message:\n" << error_msg.get() << endl;
+        return;
+    }
+
+    m_instances = gl::InstanceBuffer::make(gl::InstanceBuffer::transforms(INSTANCE_ATTRIBUTE));
+    const unsigned cubes = CUBE_GRID * CUBE_GRID * CUBE_GRID;
+    m_ring = gl::RingBuffer::make(GL_ARRAY_BUFFER, STREAMED_FRAMES * cubes * sizeof(Matrix4x3));
+
+    // Without multi-draw indirect, MULTI_DRAW_INDIRECT falls back to INSTANCED
+    if (TECHNIQUE == MULTI_DRAW_INDIRECT && m_instances) {
+        m_draws = gl::DrawIndirectBuffer::make();
+    }
+    if (m_draws) {
+        m_mesh_pool = gl::MeshPool::make(cubeLayout(), GL_UNSIGNED_SHORT,
+                                         array_size(g_cube_vertices), array_size(g_cube_indices));
+        m_mesh_pool->add(g_cube_vertices, array_size(g_cube_vertices),
+                         g_cube_indices, array_size(g_cube_indices), &m_cube_range);
+    }
+}
 
 void Neverland::drawStuff()
 {
+#if TECHNIQUE != DRAW_ELEMENTS && TECHNIQUE != BUFFER_OBJECTS && TECHNIQUE != INSTANCED \
+    && TECHNIQUE != MULTI_DRAW_INDIRECT
     static unsigned angle = 0;
+#endif
 
     cout << __FUNCTION__ << "()" << endl;
 
@@ -162,18 +494,40 @@ void Neverland::drawStuff()
 #if TECHNIQUE == DRAW_ARRAYS
     glVertexPointer(3, GL_FLOAT, sizeof(g_triangle[0]), g_triangle);
     glDrawArrays(GL_TRIANGLES, 0, 3);
-#elif TECHNIQUE == DRAW_ELEMENTS
-    glPushMatrix();
-    glTranslatef(0, 0, -5);
-    glRotatef(angle++, 0.5f, 0.5f, 0.3f);
-
-    glInterleavedArrays(GL_N3F_V3F, 0, g_cube_vertices);
-    glDrawElements(GL_TRIANGLES,
-                   array_size(g_cube_indices),
-                   GL_UNSIGNED_SHORT,
-                   g_cube_indices);
-
-    glPopMatrix();
+#elif TECHNIQUE == DRAW_ELEMENTS || TECHNIQUE == BUFFER_OBJECTS || TECHNIQUE == INSTANCED \
+    || TECHNIQUE == MULTI_DRAW_INDIRECT
+    // The simulation thread may already be changing the scene; only the
+    // acquired snapshot is safe to read here
+    if (m_draws) {
+        {
+            gl::GpuProfiler::Scope submit_scope(m_profiler.get(), "submit");
+            MultiDrawSubmitter submitter(*m_draws, m_cube_range, m_instance_transforms);
+            m_snapshots.getFront().submitInstanced(submitter);
+        }
+        if (!m_instance_transforms.empty()) {
+            m_draws->upload();
+
+            // Every bucket shares Neverland's one program and material
+            gl::GpuProfiler::Scope draw_scope(m_profiler.get(), "multi-draw");
+            m_program->activate();
+            m_mesh_pool->bind();
+            streamInstances(*m_instances, m_ring.get(),
+                            &m_instance_transforms[0], m_instance_transforms.size());
+            for (unsigned bucket = 0; bucket < m_draws->bucketCount(); ++bucket) {
+                m_draws->draw(bucket, *m_mesh_pool);
+            }
+            m_instances->unbind();
+            m_mesh_pool->unbind();
+            m_program->deactivate();
+        }
+    } else if (m_program && m_instances) {
+        InstancedSubmitter submitter(*m_program, *m_cube_mesh, *m_instances, m_ring.get(),
+                                     m_instance_transforms);
+        m_snapshots.getFront().submitInstanced(submitter);
+    } else {
+        FixedFunctionSubmitter submitter(TECHNIQUE != DRAW_ELEMENTS ? m_cube_mesh.get() : 0);
+        m_snapshots.getFront().submit(submitter);
+    }
 #elif TECHNIQUE == IMMEDIATE
     glPushMatrix();
     glTranslatef(0, 0, -70);
@@ -8,10 +8,23 @@
 #ifndef __Flexigin__Neverland__
 #define __Flexigin__Neverland__
 
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 #include "Camera.h"
+#include "DrawableNode.h"
+#include "Scene.h"
+#include "SceneSnapshot.h"
+#include "Timer.h"
+#include "TripleBuffer.h"
 #include "glLight.h"
+#include "glMesh.h"
+#include "glProfiler.h"
 #include "glProgram.h"
+#include "glProgramCache.h"
+#include "glRingBuffer.h"
+#include "glStateCache.h"
 
 using namespace flexi;
 using namespace flexi::graphics;
@@ -27,6 +40,9 @@ struct Color4f {
 struct Neverland
 {
     Neverland();
+    ~Neverland();
+
+    /// Draws the newest snapshot the simulation thread has published
     void draw(unsigned width, unsigned height);
 
     const Color4f& clearColor() const { return m_clear_color; }
@@ -37,13 +53,47 @@ struct Neverland
 
 protected:
     void updateDrawState();
+    /// Takes the instanced program once its batch has built it, and sets up
+    /// what draws with it
+    void collectPrograms();
     void drawStuff();
 
+    /// Runs on m_simulation: steps the scene about 60 times a second
+    void simulate();
+    /// Advances the scene one frame and publishes a snapshot of it
+    void step();
+
 private:
+    // Simulation thread state
+    Scene m_scene;
+    std::vector<DrawableNode*> m_cubes;
+    unsigned m_frame;
+
+    // Handed from the simulation thread to the render thread
+    util::TripleBuffer<SceneSnapshot> m_snapshots;
+    std::atomic<bool> m_simulating;
+    std::thread m_simulation;
+
+    // Render thread state
     Camera m_camera;
     gl::Light m_light;
     gl::Program::Ptr m_program;
+    std::unique_ptr<gl::ProgramBinaryCache> m_program_cache;
+    /// Null once the instanced program has been taken
+    std::unique_ptr<gl::ProgramBatch> m_program_batch;
+    gl::ProgramBatch::Handle m_instanced_program;
+    gl::Mesh::Ptr m_cube_mesh;
+    gl::InstanceBuffer::Ptr m_instances;
+    /// Streams m_instances' transforms when the context can map persistently
+    gl::RingBuffer::Ptr m_ring;
+    std::vector<math::Matrix4x3> m_instance_transforms;
+    gl::MeshPool::Ptr m_mesh_pool;
+    gl::MeshPool::Range m_cube_range;
+    gl::DrawIndirectBuffer::Ptr m_draws;
     Color4f m_clear_color;
+    util::Timer m_draw_timer;
+    /// Null when the context lacks timer queries
+    gl::GpuProfiler::Ptr m_profiler;
 
     union DirtyState{
         struct {
@@ -51,6 +101,7 @@ private:
             bool depth_test   : 1;
             bool vertex_array : 1;
             bool lighting     : 1;
+            bool profiler     : 1;
         };
 
         uint32_t dirty;
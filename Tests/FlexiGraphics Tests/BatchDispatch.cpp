@@ -0,0 +1,128 @@
+/**
+ * @file
+ * @brief Benchmarks type-bucketed batch dispatch against per-node dispatch.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\InstanceNode.h"
+#include "FlexiGraphics\NodeBuckets.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiGraphics\Visit.h"
+#include "FlexiUtil\Span.h"
+#include "FlexiUtil\Timer.h"
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+/// Stand-ins for per-type render or update work
+float work(const Node& node) { return node.getWorldTransform().getTranslation().y + 1; }
+float work(const InnerNode& innerNode) { return innerNode.getWorldTransform().getTranslation().x; }
+float work(const InstanceNode& instance) { return instance.getWorldTransform().getTranslation().z; }
+
+struct PerNodeVisitor
+{
+    float sum;
+
+    PerNodeVisitor() : sum(0) {}
+
+    void visit(Node& node) { sum += work(node); }
+    void visit(InstanceNode& instance) { sum += work(instance); }
+    void visit(InnerNode& innerNode) {
+        sum += work(innerNode);
+        Visit::children(innerNode, *this);
+    }
+};
+
+struct BatchVisitor
+{
+    float sum;
+
+    BatchVisitor() : sum(0) {}
+
+    template <typename N>
+    void visit(Span<N*> nodes) {
+        for (typename Span<N*>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+            sum += work(**it);
+    }
+};
+
+/// Builds a tree whose inner nodes hold a random mix of leaves and instances
+InnerNode& buildMixedTree(unsigned depth, const shared_ptr<Scene>& prototype) {
+    const unsigned BREADTH = 8;
+    InnerNode& root = *new InnerNode();
+    for (unsigned i = 0; i < BREADTH; ++i) {
+        if (depth)
+            root.addChild(buildMixedTree(depth-1, prototype));
+        else if (rand() % 2)
+            root.addChild(*new Node());
+        else
+            root.addChild(*new InstanceNode(prototype));
+    }
+    return root;
+}
+
+} // namespace
+
+
+/**
+ * Runs the same per-type work over a ~300K node scene of interleaved node
+ * types, dispatching per node and in type-bucketed batches. Each frame runs
+ * several visitors over the scene, as update and render submission would;
+ * the bucketed version gathers once per frame and dispatches each visitor.
+ */
+void runBatchDispatchBenchmark()
+{
+    const unsigned FRAME_COUNT = 10;
+    const unsigned VISITORS_PER_FRAME = 3;
+
+    shared_ptr<Scene> prototype(new Scene());
+    Scene scene;
+    srand(1);
+    scene.addChild(scene.getRoot(), buildMixedTree(5, prototype));
+    scene.updateTransforms();
+
+    Timer perNode, gather, dispatch;
+    float perNodeSum = 0, batchSum = 0;
+    NodeBuckets buckets;
+
+    for (unsigned frame = 0; frame < FRAME_COUNT; ++frame) {
+        perNode.start();
+        for (unsigned i = 0; i < VISITORS_PER_FRAME; ++i) {
+            PerNodeVisitor perNodeVisitor;
+            Visit::node(scene.getRoot(), perNodeVisitor);
+            perNodeSum = perNodeVisitor.sum;
+        }
+        perNode.stop();
+
+        buckets.clear();
+        gather.start();
+        buckets.gather(scene.getRoot());
+        gather.stop();
+
+        dispatch.start();
+        for (unsigned i = 0; i < VISITORS_PER_FRAME; ++i) {
+            BatchVisitor batchVisitor;
+            buckets.dispatch(batchVisitor);
+            batchSum = batchVisitor.sum;
+        }
+        dispatch.stop();
+    }
+
+    printf("%u nodes of 3 interleaved types, %u visitors per frame\n",
+           unsigned(buckets.size()), VISITORS_PER_FRAME);
+    printf("  per-node dispatch: %.3f ms/frame\n", perNode.getAvgSeconds() * 1000);
+    printf("  bucketed: %.3f ms to gather, %.3f ms to dispatch (%.3f ms/frame)\n",
+           gather.getAvgSeconds() * 1000, dispatch.getAvgSeconds() * 1000,
+           (gather.getAvgSeconds() + dispatch.getAvgSeconds()) * 1000);
+    printf("  checksums: per-node %g, bucketed %g\n", perNodeSum, batchSum);
+}
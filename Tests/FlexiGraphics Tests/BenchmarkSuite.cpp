@@ -0,0 +1,424 @@
+/**
+ * @file
+ * @brief Compares the scene graph dispatch designs over several tree shapes,
+ *        with repeated runs, statistical summaries and JSON output.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\Visit.h"
+#include "FlexiGraphics\Spatial.h"
+#include "FlexiGraphics\VNode.h"
+#include "FlexiGraphics\Visitor.h"
+#include "FlexiGraphics\NodeBase.h"
+#include "FlexiGraphics\Leaf.h"
+#include "FlexiUtil\Timer.h"
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::util;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+// Visitors
+
+struct NodeCounter
+{
+    unsigned nodeCount;
+
+    NodeCounter() : nodeCount(0) {}
+
+    void visit(Node&) {
+        ++nodeCount;
+    }
+
+    void visit(InnerNode& in) {
+        ++nodeCount;
+        Visit::children(in, *this);
+    }
+};
+
+struct VNodeCounter: public Visitor
+{
+    unsigned nodeCount;
+
+    VNodeCounter() : nodeCount(0) {}
+
+    virtual void visitSpatial(Spatial&) { ++nodeCount; }
+    virtual void visitNode(VNode& vn) {
+        ++nodeCount;
+        vn.visitChildren(*this);
+    }
+};
+
+struct EnumNodeCounter
+{
+    unsigned nodeCount;
+
+    EnumNodeCounter() : nodeCount(0) {}
+
+    void visitNodeBase(NodeBase&) { ++nodeCount; }
+    void visitLeaf(Leaf& leaf) {
+        ++nodeCount;
+        leaf.visitChildren(*this);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Designs
+
+/// Registry dispatch through Visit
+struct VisitDesign
+{
+    typedef Node Base;
+    typedef InnerNode InnerType;
+    typedef Node LeafType;
+
+    static const char* name() { return "Visit/Node"; }
+
+    static unsigned count(Base& root) {
+        NodeCounter counter;
+        Visit::node(root, counter);
+        return counter.nodeCount;
+    }
+};
+
+/// Classic double dispatch through virtual accept()
+struct VirtualDesign
+{
+    typedef Spatial Base;
+    typedef VNode InnerType;
+    typedef Spatial LeafType;
+
+    static const char* name() { return "Spatial/VNode"; }
+
+    static unsigned count(Base& root) {
+        VNodeCounter counter;
+        root.accept(counter);
+        return counter.nodeCount;
+    }
+};
+
+/// Switch on a stored node type
+struct EnumDesign
+{
+    typedef NodeBase Base;
+    typedef Leaf InnerType;
+    typedef NodeBase LeafType;
+
+    static const char* name() { return "NodeBase/Leaf"; }
+
+    static unsigned count(Base& root) {
+        EnumNodeCounter counter;
+        root.accept(counter);
+        return counter.nodeCount;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Shapes
+
+/**
+ * A tree topology shared by every design. Node 0 is the root and every other
+ * node's parent has a smaller index. Nodes are allocated in allocationOrder,
+ * which is shuffled for shapes whose memory layout should not follow the tree.
+ */
+struct Shape
+{
+    const char* name;
+    vector<unsigned> parentOf;
+    vector<unsigned> childCount;
+    vector<unsigned> allocationOrder;
+};
+
+unsigned randomIndex(unsigned count) {
+    return (rand() * (RAND_MAX + 1u) + rand()) % count;
+}
+
+void finishShape(Shape& shape, bool shuffle) {
+    const unsigned nodeCount = unsigned(shape.parentOf.size());
+    shape.childCount.assign(nodeCount, 0);
+    for (unsigned i = 1; i < nodeCount; ++i)
+        ++shape.childCount[shape.parentOf[i]];
+
+    shape.allocationOrder.resize(nodeCount);
+    for (unsigned i = 0; i < nodeCount; ++i)
+        shape.allocationOrder[i] = i;
+    if (shuffle) {
+        for (unsigned i = nodeCount - 1; i > 0; --i)
+            swap(shape.allocationOrder[i], shape.allocationOrder[randomIndex(i + 1)]);
+    }
+}
+
+/// Two levels: about sqrt(n) inner nodes under the root, each with as many leaves
+Shape makeWide(unsigned nodeCount) {
+    Shape shape;
+    shape.name = "wide";
+    const unsigned breadth = max(1u, unsigned(sqrt(double(nodeCount))));
+
+    shape.parentOf.resize(nodeCount, 0);
+    for (unsigned i = breadth + 1; i < nodeCount; ++i)
+        shape.parentOf[i] = 1 + i % breadth;
+
+    finishShape(shape, false);
+    return shape;
+}
+
+/// Chains of 1024 nodes hanging from the root
+Shape makeDeep(unsigned nodeCount) {
+    const unsigned DEPTH = 1024;
+    Shape shape;
+    shape.name = "deep";
+
+    shape.parentOf.resize(nodeCount, 0);
+    for (unsigned i = 1; i < nodeCount; ++i)
+        shape.parentOf[i] = (i - 1) % DEPTH == 0 ? 0 : i - 1;
+
+    finishShape(shape, false);
+    return shape;
+}
+
+/// Each node attached to a uniformly chosen earlier node
+Shape makeRandom(unsigned nodeCount) {
+    Shape shape;
+    shape.name = "random";
+
+    shape.parentOf.resize(nodeCount, 0);
+    for (unsigned i = 1; i < nodeCount; ++i)
+        shape.parentOf[i] = randomIndex(i);
+
+    finishShape(shape, false);
+    return shape;
+}
+
+void addSkewedSubtree(Shape& shape, unsigned parent, unsigned size) {
+    const unsigned self = unsigned(shape.parentOf.size());
+    shape.parentOf.push_back(parent);
+
+    const unsigned rest = size - 1;
+    if (rest) {
+        const unsigned heavy = max(1u, rest * 9 / 10);
+        addSkewedSubtree(shape, self, heavy);
+        if (rest > heavy)
+            addSkewedSubtree(shape, self, rest - heavy);
+    }
+}
+
+/// Binary splits giving 90% of each subtree to one side, allocated shuffled
+Shape makeSkewedShuffled(unsigned nodeCount) {
+    Shape shape;
+    shape.name = "skewed-shuffled";
+
+    shape.parentOf.reserve(nodeCount);
+    addSkewedSubtree(shape, 0, nodeCount);
+
+    finishShape(shape, true);
+    return shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Measurement
+
+struct Stats
+{
+    double min, median, mean, stddev, max;
+};
+
+Stats summarize(vector<double> samples) {
+    Stats stats = { 0, 0, 0, 0, 0 };
+    if (samples.empty())
+        return stats;
+
+    sort(samples.begin(), samples.end());
+    const size_t count = samples.size();
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.median = count % 2 ? samples[count / 2]
+                             : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+
+    for (size_t i = 0; i < count; ++i)
+        stats.mean += samples[i];
+    stats.mean /= count;
+
+    for (size_t i = 0; i < count; ++i)
+        stats.stddev += (samples[i] - stats.mean) * (samples[i] - stats.mean);
+    stats.stddev = count > 1 ? sqrt(stats.stddev / (count - 1)) : 0;
+
+    return stats;
+}
+
+enum Operation { BUILD, TRAVERSE, MUTATE, DESTROY, OPERATION_COUNT };
+const char* const OPERATION_NAMES[OPERATION_COUNT] = { "build", "traverse", "mutate", "destroy" };
+
+struct Result
+{
+    const char* design;
+    const char* shape;
+    unsigned nodeCount;
+    double bytesPerNode;
+    Stats ms[OPERATION_COUNT];
+};
+
+/// Allocates and links @a shape's nodes; @a inners receives the inner nodes
+template <typename Design>
+typename Design::Base* build(const Shape& shape, vector<typename Design::InnerType*>& inners) {
+    typedef typename Design::Base Base;
+    typedef typename Design::InnerType InnerType;
+    typedef typename Design::LeafType LeafType;
+
+    const unsigned nodeCount = unsigned(shape.parentOf.size());
+    vector<Base*> nodes(nodeCount);
+    inners.assign(nodeCount, 0);
+
+    for (unsigned k = 0; k < nodeCount; ++k) {
+        const unsigned i = shape.allocationOrder[k];
+        if (shape.childCount[i]) {
+            inners[i] = new InnerType();
+            nodes[i] = inners[i];
+        } else {
+            nodes[i] = new LeafType();
+        }
+    }
+
+    // addChild() prepends, so link in reverse to keep children in index order
+    for (unsigned i = nodeCount - 1; i > 0; --i)
+        inners[shape.parentOf[i]]->addChild(*nodes[i]);
+
+    return nodes[0];
+}
+
+/**
+ * Builds, counts, grows by 1% and deletes @a shape with @a Design, @a repeats
+ * times over.
+ */
+template <typename Design>
+Result measure(const Shape& shape, unsigned repeats) {
+    typedef typename Design::Base Base;
+    typedef typename Design::InnerType InnerType;
+    typedef typename Design::LeafType LeafType;
+
+    const unsigned nodeCount = unsigned(shape.parentOf.size());
+    vector<double> samples[OPERATION_COUNT];
+
+    for (unsigned r = 0; r < repeats; ++r) {
+        Timer timer;
+        vector<InnerType*> inners;
+
+        timer.start();
+        Base* root = build<Design>(shape, inners);
+        timer.stop();
+        samples[BUILD].push_back(timer.getLastSeconds() * 1000);
+
+        inners.erase(remove(inners.begin(), inners.end(), (InnerType*)0), inners.end());
+
+        timer.start();
+        const unsigned counted = Design::count(*root);
+        timer.stop();
+        samples[TRAVERSE].push_back(timer.getLastSeconds() * 1000);
+        if (counted != nodeCount)
+            printf("  %s/%s: counted %u of %u nodes\n", Design::name(), shape.name, counted, nodeCount);
+
+        srand(r + 1);
+        timer.start();
+        for (unsigned i = 0; i < nodeCount / 100; ++i)
+            inners[randomIndex(unsigned(inners.size()))]->addChild(*new LeafType());
+        timer.stop();
+        samples[MUTATE].push_back(timer.getLastSeconds() * 1000);
+
+        timer.start();
+        delete root;
+        timer.stop();
+        samples[DESTROY].push_back(timer.getLastSeconds() * 1000);
+    }
+
+    unsigned innerCount = 0;
+    for (unsigned i = 0; i < nodeCount; ++i)
+        if (shape.childCount[i])
+            ++innerCount;
+
+    Result result;
+    result.design = Design::name();
+    result.shape = shape.name;
+    result.nodeCount = nodeCount;
+    result.bytesPerNode = (innerCount * double(sizeof(InnerType))
+                        + (nodeCount - innerCount) * double(sizeof(LeafType))) / nodeCount;
+    for (unsigned op = 0; op < OPERATION_COUNT; ++op)
+        result.ms[op] = summarize(samples[op]);
+    return result;
+}
+
+void printResult(const Result& result) {
+    printf("%-14s %-16s %6.1f B/node", result.design, result.shape, result.bytesPerNode);
+    for (unsigned op = 0; op < OPERATION_COUNT; ++op)
+        printf("  %s %8.2f +-%6.2f", OPERATION_NAMES[op], result.ms[op].median, result.ms[op].stddev);
+    printf("  (median ms +- stddev)\n");
+}
+
+bool writeJson(const char* path, unsigned repeats, const vector<Result>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "{\n  \"suite\": \"scenegraph\",\n  \"repeats\": %u,\n  \"units\": \"ms\",\n"
+                  "  \"results\": [\n", repeats);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        fprintf(file, "    {\n      \"design\": \"%s\",\n      \"shape\": \"%s\",\n"
+                      "      \"nodeCount\": %u,\n      \"bytesPerNode\": %.2f",
+                result.design, result.shape, result.nodeCount, result.bytesPerNode);
+        for (unsigned op = 0; op < OPERATION_COUNT; ++op) {
+            const Stats& s = result.ms[op];
+            fprintf(file, ",\n      \"%s\": { \"min\": %.4f, \"median\": %.4f, \"mean\": %.4f,"
+                          " \"stddev\": %.4f, \"max\": %.4f }",
+                    OPERATION_NAMES[op], s.min, s.median, s.mean, s.stddev, s.max);
+        }
+        fprintf(file, "\n    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    return fclose(file) == 0;
+}
+
+} // namespace
+
+
+/**
+ * Runs every design over wide, deep, random and skewed-shuffled trees of
+ * about @a nodeCount nodes, @a repeats times each, and prints a summary. If
+ * @a jsonPath is non-null the results are also written there as JSON.
+ * 
+ * @returns false if the JSON file could not be written.
+ */
+bool runBenchmarkSuite(unsigned nodeCount, unsigned repeats, const char* jsonPath)
+{
+    srand(1);
+    vector<Shape> shapes;
+    shapes.push_back(makeWide(nodeCount));
+    shapes.push_back(makeDeep(nodeCount));
+    shapes.push_back(makeRandom(nodeCount));
+    shapes.push_back(makeSkewedShuffled(nodeCount));
+
+    vector<Result> results;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        results.push_back(measure<VisitDesign>(shapes[i], repeats));
+        printResult(results.back());
+        results.push_back(measure<VirtualDesign>(shapes[i], repeats));
+        printResult(results.back());
+        results.push_back(measure<EnumDesign>(shapes[i], repeats));
+        printResult(results.back());
+    }
+
+    if (jsonPath && !writeJson(jsonPath, repeats, results)) {
+        printf("Could not write %s\n", jsonPath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file
+ * @brief Benchmarks building, refitting and querying a BoundingVolumeHierarchy.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\BoundingVolumeHierarchy.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Parallel.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+struct Triangle
+{
+    Vector3f a, b, c;
+
+    BoundingBox getBounds() const {
+        BoundingBox box(a, a);
+        box.extend(b);
+        box.extend(c);
+        return box;
+    }
+};
+
+float randomFloat(float lo, float hi) {
+    return lo + (hi - lo) * (rand() / float(RAND_MAX));
+}
+
+/// Small triangles scattered over a bumpy 1000 x 1000 terrain
+void makeTerrain(unsigned count, vector<Triangle>& triangles) {
+    triangles.resize(count);
+    for (unsigned i = 0; i < count; ++i) {
+        const float x = randomFloat(0, 1000), z = randomFloat(0, 1000);
+        const float y = 20 * sin(x * 0.02f) * cos(z * 0.03f);
+        const Vector3f corner(x, y, z);
+        triangles[i].a = corner;
+        triangles[i].b = corner + Vector3f(randomFloat(0.5f, 2), randomFloat(-1, 1), 0);
+        triangles[i].c = corner + Vector3f(0, randomFloat(-1, 1), randomFloat(0.5f, 2));
+    }
+}
+
+/// Moller-Trumbore; returns the distance along the ray, or -1 for a miss
+float intersect(const Triangle& t, const Vector3f& origin, const Vector3f& direction) {
+    const Vector3f e1 = t.b - t.a, e2 = t.c - t.a;
+    const Vector3f p = direction.cross(e2);
+    const float det = e1.dot(p);
+    if (fabs(det) < 1e-8f)
+        return -1;
+    const float inverse = 1 / det;
+    const Vector3f s = origin - t.a;
+    const float u = s.dot(p) * inverse;
+    if (u < 0 || u > 1)
+        return -1;
+    const Vector3f q = s.cross(e1);
+    const float v = direction.dot(q) * inverse;
+    if (v < 0 || u + v > 1)
+        return -1;
+    return e2.dot(q) * inverse;
+}
+
+/// Finds the nearest triangle hit during BoundingVolumeHierarchy::traverseRay
+struct NearestHit
+{
+    const vector<Triangle>& triangles;
+    Vector3f origin, direction;
+    unsigned tests;
+
+    NearestHit(const vector<Triangle>& triangles, const Vector3f& origin, const Vector3f& direction)
+        : triangles(triangles), origin(origin), direction(direction), tests(0) {}
+
+    bool visit(uint32_t primitive, float& maxDistance) {
+        ++tests;
+        const float t = intersect(triangles[primitive], origin, direction);
+        if (t >= 0 && t < maxDistance)
+            maxDistance = t;
+        return true;
+    }
+
+private:
+    NearestHit& operator=(const NearestHit&);
+};
+
+/// Counts the primitives handed to BoundingVolumeHierarchy::traverseBox
+struct Counter
+{
+    unsigned count;
+    Counter() : count(0) {}
+    void visit(uint32_t) { ++count; }
+};
+
+/// Rays cast down onto the terrain from random points above it
+void makeRay(Vector3f& origin, Vector3f& direction) {
+    origin = Vector3f(randomFloat(0, 1000), 100, randomFloat(0, 1000));
+    direction = Vector3f(randomFloat(-0.5f, 0.5f), -1, randomFloat(-0.5f, 0.5f));
+    direction *= 1.0f / direction.len();
+}
+
+void runAtSize(unsigned triangleCount) {
+    vector<Triangle> triangles;
+    makeTerrain(triangleCount, triangles);
+    vector<BoundingBox> bounds(triangleCount);
+    for (unsigned i = 0; i < triangleCount; ++i)
+        bounds[i] = triangles[i].getBounds();
+
+    BoundingVolumeHierarchy bvh;
+    Timer build;
+    for (unsigned i = 0; i < 3; ++i) {
+        build.start();
+        bvh.build(&bounds[0], triangleCount);
+        build.stop();
+    }
+    printf("  %u triangles: build %.1f ms on %u threads, %u nodes (%u bytes)\n",
+           triangleCount, build.getAvgSeconds() * 1000, getWorkerCount(),
+           unsigned(bvh.getNodeCount()), unsigned(bvh.getNodeCount() * sizeof(BoundingVolumeHierarchy::Node)));
+
+    // Nearest-hit rays, checked against brute force for a few of them
+    const unsigned RAY_COUNT = 200000;
+    vector<Vector3f> origins(RAY_COUNT), directions(RAY_COUNT);
+    for (unsigned i = 0; i < RAY_COUNT; ++i)
+        makeRay(origins[i], directions[i]);
+
+    Timer rays;
+    unsigned hits = 0, tests = 0;
+    rays.start();
+    for (unsigned i = 0; i < RAY_COUNT; ++i) {
+        NearestHit nearest(triangles, origins[i], directions[i]);
+        if (bvh.traverseRay(origins[i], directions[i], 1000, nearest) < 1000)
+            ++hits;
+        tests += nearest.tests;
+    }
+    rays.stop();
+
+    unsigned mismatches = 0;
+    for (unsigned i = 0; i < 10; ++i) {
+        NearestHit nearest(triangles, origins[i], directions[i]);
+        const float fromTree = bvh.traverseRay(origins[i], directions[i], 1000, nearest);
+        float bruteForce = 1000;
+        for (unsigned j = 0; j < triangleCount; ++j) {
+            const float t = intersect(triangles[j], origins[i], directions[i]);
+            if (t >= 0 && t < bruteForce)
+                bruteForce = t;
+        }
+        if (fromTree != bruteForce)
+            ++mismatches;
+    }
+    printf("    rays: %.2f M rays/s on one thread, %.1f%% hit, %.1f triangle tests/ray%s\n",
+           RAY_COUNT / rays.getLastSeconds() * 1e-6, 100.0 * hits / RAY_COUNT,
+           double(tests) / RAY_COUNT, mismatches ? "  MISMATCH" : "");
+
+    // Box queries
+    const unsigned BOX_COUNT = 100000;
+    Timer boxes;
+    unsigned found = 0;
+    boxes.start();
+    for (unsigned i = 0; i < BOX_COUNT; ++i) {
+        const Vector3f center(randomFloat(0, 1000), 0, randomFloat(0, 1000));
+        Counter counter;
+        bvh.traverseBox(BoundingBox(center - Vector3f(5, 25, 5), center + Vector3f(5, 25, 5)), counter);
+        found += counter.count;
+    }
+    boxes.stop();
+    printf("    boxes: %.2f M queries/s, %.1f triangles/query\n",
+           BOX_COUNT / boxes.getLastSeconds() * 1e-6, double(found) / BOX_COUNT);
+
+    // Nudge every triangle and refit
+    for (unsigned i = 0; i < triangleCount; ++i) {
+        const Vector3f step(randomFloat(-0.5f, 0.5f), randomFloat(-0.5f, 0.5f), randomFloat(-0.5f, 0.5f));
+        bounds[i] = BoundingBox(bounds[i].min + step, bounds[i].max + step);
+    }
+    Timer refit;
+    for (unsigned i = 0; i < 3; ++i) {
+        refit.start();
+        bvh.refit(&bounds[0]);
+        refit.stop();
+    }
+    printf("    refit %.2f ms (%.0fx faster than building)\n",
+           refit.getAvgSeconds() * 1000, build.getAvgSeconds() / refit.getAvgSeconds());
+}
+
+} // namespace
+
+
+/**
+ * Builds trees over scattered terrain triangles, times nearest-hit rays and
+ * box queries against them, and times refitting after every triangle moves.
+ */
+void runBvhBenchmark()
+{
+    srand(1);
+    runAtSize(100000);
+    runAtSize(1000000);
+}
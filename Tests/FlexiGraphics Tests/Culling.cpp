@@ -0,0 +1,123 @@
+/**
+ * @file
+ * @brief Benchmarks hierarchical frustum culling against testing every node.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiGraphics\Visit.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cstdio>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+struct VisibleCounter
+{
+    unsigned nodeCount;
+
+    VisibleCounter() : nodeCount(0) {}
+
+    template <typename N>
+    void visit(N&) { ++nodeCount; }
+};
+
+Matrix4x3 translation(float x, float y, float z) {
+    Matrix4x3 m;
+    m.setupTranslation(Vector3f(x, y, z));
+    return m;
+}
+
+/**
+ * Builds a BLOCKS x BLOCKS grid of blocks on the xz plane, each holding a
+ * grid of props, each holding a grid of unit-spaced leaves.
+ */
+void buildCity(Scene& scene, vector<Node*>& allNodes) {
+    const unsigned BLOCKS = 10, PROPS = 10, LEAVES = 10;
+    const BoundingBox leafBounds(Vector3f(-0.4f, 0.0f, -0.4f), Vector3f(0.4f, 1.0f, 0.4f));
+
+    for (unsigned bx = 0; bx < BLOCKS; ++bx)
+    for (unsigned bz = 0; bz < BLOCKS; ++bz) {
+        InnerNode& block = *new InnerNode();
+        scene.setLocalTransform(block, translation(bx * 100.0f, 0, bz * 100.0f));
+        allNodes.push_back(&block);
+
+        for (unsigned px = 0; px < PROPS; ++px)
+        for (unsigned pz = 0; pz < PROPS; ++pz) {
+            InnerNode& prop = *new InnerNode();
+            scene.setLocalTransform(prop, translation(px * 10.0f, 0, pz * 10.0f));
+            allNodes.push_back(&prop);
+
+            for (unsigned lx = 0; lx < LEAVES; ++lx)
+            for (unsigned lz = 0; lz < LEAVES; ++lz) {
+                Node& leaf = *new Node();
+                scene.setLocalTransform(leaf, translation(float(lx), 0, float(lz)));
+                scene.setLocalBounds(leaf, leafBounds);
+                prop.addChild(leaf);
+                allNodes.push_back(&leaf);
+            }
+            block.addChild(prop);
+        }
+        scene.addChild(scene.getRoot(), block);
+    }
+
+    scene.updateTransforms();
+    scene.refitBounds();
+}
+
+} // namespace
+
+
+/**
+ * Computes the visible set for view distances covering increasing portions of
+ * a ~1M node scene, once hierarchically and once by testing every node.
+ */
+void runCullingBenchmark()
+{
+    const unsigned QUERY_COUNT = 10;
+    const float farClips[] = { 10.0f, 50.0f, 200.0f, 1000.0f };
+
+    Scene scene;
+    vector<Node*> allNodes;
+    buildCity(scene, allNodes);
+
+    // Stand at the near edge of the city, looking down -z across it
+    const Matrix4x3 eye = translation(500.0f, 1.0f, 1000.0f);
+
+    for (unsigned i = 0; i < sizeof(farClips) / sizeof(farClips[0]); ++i) {
+        const Frustum frustum(60.0f, 4.0f / 3.0f, 0.5f, farClips[i], eye);
+
+        Timer hierarchical, bruteForce;
+        unsigned visibleCount = 0, bruteForceCount = 0;
+
+        for (unsigned q = 0; q < QUERY_COUNT; ++q) {
+            VisibleCounter counter;
+            hierarchical.start();
+            scene.visitVisible(frustum, counter);
+            hierarchical.stop();
+            visibleCount = counter.nodeCount;
+
+            bruteForceCount = 0;
+            bruteForce.start();
+            for (vector<Node*>::const_iterator it = allNodes.begin(); it != allNodes.end(); ++it)
+                if (frustum.intersects((*it)->getWorldBounds()))
+                    ++bruteForceCount;
+            bruteForce.stop();
+        }
+
+        printf("Far clip %6.0f: %7u of %u nodes visible\n",
+               farClips[i], visibleCount, unsigned(allNodes.size()));
+        printf("  hierarchical: %8.3f ms, brute force: %8.3f ms (%u nodes)\n",
+               hierarchical.getAvgSeconds() * 1000,
+               bruteForce.getAvgSeconds() * 1000, bruteForceCount);
+    }
+}
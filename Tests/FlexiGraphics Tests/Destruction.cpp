@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @brief Benchmarks deferred and pooled subtree destruction against deleting
+ *        a subtree outright.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\NodePool.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiUtil\Timer.h"
+#include <cstdio>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::util;
+
+namespace {
+
+InnerNode& buildTree(unsigned depth, unsigned breadth) {
+    InnerNode& root = *new InnerNode();
+    for (unsigned i = 0; i < breadth; ++i) {
+        if (depth)
+            root.addChild(buildTree(depth-1, breadth));
+        else
+            root.addChild(*new Node());
+    }
+    return root;
+}
+
+InnerNode& buildPooledTree(NodePool& pool, unsigned depth, unsigned breadth) {
+    InnerNode& root = pool.create<InnerNode>();
+    for (unsigned i = 0; i < breadth; ++i) {
+        if (depth)
+            root.addChild(buildPooledTree(pool, depth-1, breadth));
+        else
+            root.addChild(pool.create<Node>());
+    }
+    return root;
+}
+
+} // namespace
+
+
+/**
+ * Unloads a ~1M node subtree four ways: deleting it on the spot, destroying
+ * it through the scene with a per-frame budget, releasing its NodePool, and
+ * running each pooled node's destructor before releasing.
+ */
+void runDestructionBenchmark()
+{
+    const unsigned DEPTH = 18, BREADTH = 2;
+    const float FRAME_BUDGET = 0.002f;
+
+    Scene scene;
+    Timer timer;
+
+    // Immediate deletion
+    InnerNode& immediate = buildTree(DEPTH, BREADTH);
+    scene.addChild(scene.getRoot(), immediate);
+    scene.updateTransforms();
+    timer.start();
+    scene.getRoot().removeChild(immediate);
+    delete &immediate;
+    timer.stop();
+    printf("  delete:   %8.3f ms on one frame\n", timer.getLastSeconds() * 1000);
+
+    // Deferred deletion, spread over frames
+    InnerNode& deferred = buildTree(DEPTH, BREADTH);
+    scene.addChild(scene.getRoot(), deferred);
+    scene.updateTransforms();
+    timer.start();
+    scene.destroy(deferred);
+    timer.stop();
+    const float detachSeconds = timer.getLastSeconds();
+
+    Timer frame;
+    unsigned frameCount = 0, destroyed = 0;
+    float worstFrame = 0;
+    while (scene.hasPendingDestruction()) {
+        frame.start();
+        destroyed += scene.destroyPending(FRAME_BUDGET);
+        frame.stop();
+        if (frame.getLastSeconds() > worstFrame)
+            worstFrame = frame.getLastSeconds();
+        ++frameCount;
+    }
+    printf("  deferred: %8.3f ms to detach, %u nodes over %u frames"
+           " (worst %.3f ms, budget %.3f ms)\n",
+           detachSeconds * 1000, destroyed, frameCount,
+           worstFrame * 1000, FRAME_BUDGET * 1000);
+
+    // Pooled subtree, released in bulk
+    NodePool pool;
+    InnerNode& pooled = buildPooledTree(pool, DEPTH, BREADTH);
+    scene.addChild(scene.getRoot(), pooled);
+    scene.updateTransforms();
+    const unsigned pooledCount = pool.getNodeCount();
+    timer.start();
+    scene.destroy(pooled);
+    pool.release();
+    timer.stop();
+    printf("  pooled:   %8.3f ms to detach and release %u nodes\n",
+           timer.getLastSeconds() * 1000, pooledCount);
+
+    // Pooled subtree, destroyed node by node before release
+    InnerNode& unwound = buildPooledTree(pool, DEPTH, BREADTH);
+    scene.addChild(scene.getRoot(), unwound);
+    scene.updateTransforms();
+    timer.start();
+    scene.destroy(unwound);
+    pool.destroyAll(unwound);
+    timer.stop();
+    printf("  pooled:   %8.3f ms to detach and destroyAll %u nodes\n",
+           timer.getLastSeconds() * 1000, pooledCount);
+}
@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief Benchmarks sorting a frame's draws with RenderQueue.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\DrawableNode.h"
+#include "FlexiGraphics\RenderQueue.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+const unsigned PROGRAMS = 16, MATERIALS = 128, MESHES = 64;
+const float NEAR_CLIP = 1, FAR_CLIP = 1000;
+
+/// Stands in for the GL calls, checking the order it is handed draws in
+struct CountingSubmitter
+{
+    unsigned binds;
+    unsigned outOfOrder;
+    uint64_t lastKey;
+    unsigned lastLayer;
+    float lastBlendedDepth;
+    vector<float>* depths;
+
+    explicit CountingSubmitter(vector<float>& depths)
+        : binds(0), outOfOrder(0), lastKey(0), lastLayer(0), lastBlendedDepth(FAR_CLIP), depths(&depths) {}
+
+    void bindProgram(uint32_t) { ++binds; }
+    void bindMaterial(uint32_t) { ++binds; }
+    void bindMesh(uint32_t) { ++binds; }
+
+    void draw(const DrawItem& item) {
+        if (item.key < lastKey)
+            ++outOfOrder;
+        lastKey = item.key;
+
+        // Blended draws must come back to front
+        const float depth = (*depths)[item.userData];
+        if (DrawKey::getLayer(item.key) == 1) {
+            if (lastLayer == 1 && depth > lastBlendedDepth + 0.01f)
+                ++outOfOrder;
+            lastBlendedDepth = depth;
+        }
+        lastLayer = DrawKey::getLayer(item.key);
+    }
+};
+
+/// Binds that drawing in push order would issue, with and without skipping repeats
+void countUnsorted(const vector<DrawItem>& items, unsigned& naive, unsigned& skipping) {
+    naive = 3 * unsigned(items.size());
+    skipping = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const bool programChanged = i == 0 || items[i].program != items[i - 1].program;
+        skipping += programChanged;
+        skipping += programChanged || items[i].material != items[i - 1].material;
+        skipping += i == 0 || items[i].mesh != items[i - 1].mesh;
+    }
+}
+
+/// Scene order, since DrawableNodes were numbered as they were added
+bool sceneOrder(const DrawItem& a, const DrawItem& b) { return a.userData < b.userData; }
+
+bool keyLess(const DrawItem& a, const DrawItem& b) { return a.key < b.key; }
+
+} // namespace
+
+
+/**
+ * Queues a scene of 20K drawables with 16 programs, 128 materials and 64
+ * meshes, and compares the state changes of drawing them in scene order with
+ * those of the sorted queue. Also times the radix sort against
+ * std::stable_sort, since both keep draws with equal keys in push order.
+ */
+void runDrawSortingBenchmark()
+{
+    srand(1);
+    const unsigned DRAWABLES = 20000;
+    Scene scene;
+    vector<float> depths(DRAWABLES);
+    for (unsigned i = 0; i < DRAWABLES; ++i) {
+        DrawableNode& node = *new DrawableNode(rand() % PROGRAMS, rand() % MATERIALS, rand() % MESHES);
+        if (i % 10 == 0) {
+            node.layer = 1;
+            node.blended = true;
+        }
+        node.userData = i;
+        depths[i] = 2 + float(rand() % 400);
+        Matrix4x3 m;
+        m.setupTranslation(Vector3f(float(rand() % 200) - 100, float(rand() % 200) - 100, -depths[i]));
+        scene.setLocalTransform(node, m);
+        scene.setLocalBounds(node, BoundingBox(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)));
+        scene.addChild(scene.getRoot(), node);
+    }
+    scene.updateTransforms();
+
+    Matrix4x3 view;
+    view.setIdentity();
+    const Frustum frustum(90.0f, 1.0f, NEAR_CLIP, FAR_CLIP, view);
+
+    RenderQueue queue;
+    Timer fill, sort, submit;
+    CountingSubmitter counter(depths);
+    for (unsigned frame = 0; frame < 20; ++frame) {
+        queue.clear();
+        DrawQueueBuilder builder(queue, Vector3f(0, 0, 0), Vector3f(0, 0, -1), NEAR_CLIP, FAR_CLIP);
+        fill.start();
+        scene.visitVisible(frustum, builder);
+        fill.stop();
+        sort.start();
+        queue.sort();
+        sort.stop();
+        counter = CountingSubmitter(depths);
+        submit.start();
+        queue.submit(counter);
+        submit.stop();
+    }
+    const RenderQueue::Stats& stats = queue.getStats();
+
+    // What the same frame costs without sorting
+    vector<DrawItem> pushed;
+    RenderQueue unsortedQueue;
+    {
+        DrawQueueBuilder builder(unsortedQueue, Vector3f(0, 0, 0), Vector3f(0, 0, -1), NEAR_CLIP, FAR_CLIP);
+        scene.visitVisible(frustum, builder);
+    }
+    for (size_t i = 0; i < unsortedQueue.size(); ++i)
+        pushed.push_back(unsortedQueue[i]);
+    std::sort(pushed.begin(), pushed.end(), sceneOrder);
+    unsigned naive, skipping;
+    countUnsorted(pushed, naive, skipping);
+
+    printf("  %u draws: fill %.2f ms, sort %.2f ms, submit %.2f ms%s\n", stats.draws,
+           fill.getAvgSeconds() * 1000, sort.getAvgSeconds() * 1000, submit.getAvgSeconds() * 1000,
+           counter.outOfOrder ? "  OUT OF ORDER" : "");
+    printf("  binds: %u issuing everything, %u skipping repeats in scene order, %u sorted (%u avoided)\n",
+           naive, skipping, stats.getBinds(), stats.getBindsSkipped());
+    printf("    programs %u (%u skipped), materials %u (%u skipped), meshes %u (%u skipped)\n",
+           stats.programBinds, stats.programBindsSkipped, stats.materialBinds,
+           stats.materialBindsSkipped, stats.meshBinds, stats.meshBindsSkipped);
+
+    // Sort throughput on a larger queue
+    const unsigned ITEMS = 200000;
+    vector<DrawItem> items(ITEMS);
+    for (unsigned i = 0; i < ITEMS; ++i) {
+        items[i].key = DrawKey::opaque(rand() % 4, rand() % PROGRAMS, rand() % MATERIALS, rand() % (1 << 24));
+        items[i].userData = i;
+    }
+    Timer radix, comparison;
+    for (unsigned repeat = 0; repeat < 5; ++repeat) {
+        queue.clear();
+        for (unsigned i = 0; i < ITEMS; ++i)
+            queue.push(items[i]);
+        radix.start();
+        queue.sort();
+        radix.stop();
+
+        vector<DrawItem> copy(items);
+        comparison.start();
+        std::stable_sort(copy.begin(), copy.end(), keyLess);
+        comparison.stop();
+    }
+    printf("  sorting %u keys: radix %.2f ms, std::stable_sort %.2f ms\n", ITEMS,
+           radix.getAvgSeconds() * 1000, comparison.getAvgSeconds() * 1000);
+}
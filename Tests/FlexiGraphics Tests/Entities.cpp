@@ -0,0 +1,148 @@
+/**
+ * @file
+ * @brief Benchmarks archetype entity storage against flat scene graph nodes.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\EntityStore.h"
+#include "FlexiGraphics\EntityComponents.h"
+#include "FlexiGraphics\EntityNode.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cstdio>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+/// Where an entity sits relative to the scene root
+struct LocalTransform
+{
+    Matrix4x3 local;
+};
+
+/// Stands in for a renderer's mesh and material references
+struct MeshRef
+{
+    unsigned mesh;
+    unsigned material;
+};
+
+struct VisibleCounter
+{
+    unsigned nodeCount;
+
+    VisibleCounter() : nodeCount(0) {}
+
+    template <typename N>
+    void visit(N&) { ++nodeCount; }
+};
+
+Matrix4x3 translation(float x, float y, float z) {
+    Matrix4x3 m;
+    m.setupTranslation(Vector3f(x, y, z));
+    return m;
+}
+
+} // namespace
+
+
+/**
+ * Places the same ~1M flat objects on a grid as children of one scene node and
+ * as entities (a quarter of them with an extra component, giving two
+ * archetypes), then compares a full transform and bounds update and a frustum
+ * cull over each. Also checks that an EntityNode hands its world transform to
+ * its entity.
+ */
+void runEntityBenchmark()
+{
+    const unsigned SIDE = 1024;
+    const unsigned PASS_COUNT = 10;
+    const BoundingBox objectBounds(Vector3f(-0.4f, 0.0f, -0.4f), Vector3f(0.4f, 1.0f, 0.4f));
+
+    Scene scene;
+    EntityStore store;
+    for (unsigned x = 0; x < SIDE; ++x)
+    for (unsigned z = 0; z < SIDE; ++z) {
+        const Matrix4x3 placement = translation(float(x), 0, float(z));
+
+        Node& node = *new Node();
+        scene.setLocalTransform(node, placement);
+        scene.setLocalBounds(node, objectBounds);
+        scene.addChild(scene.getRoot(), node);
+
+        const Entity entity = store.create();
+        store.add(entity, LocalTransform()).local = placement;
+        store.add(entity, EntityTransform());
+        store.add(entity, EntityBounds()).local = objectBounds;
+        if ((x + z) % 4 == 0)
+            store.add(entity, MeshRef());
+    }
+    scene.updateTransforms();
+
+    Timer graphUpdate, entityUpdate;
+    for (unsigned pass = 0; pass < PASS_COUNT; ++pass) {
+        scene.setLocalTransform(scene.getRoot(), scene.getRoot().getLocalTransform());
+        graphUpdate.start();
+        scene.updateTransforms();
+        graphUpdate.stop();
+
+        const Matrix4x3 rootWorld = scene.getRoot().getWorldTransform();
+        entityUpdate.start();
+        store.each<LocalTransform, EntityTransform>(
+            [&](size_t count, const Entity*, LocalTransform* locals, EntityTransform* transforms) {
+                for (size_t i = 0; i < count; ++i)
+                    transforms[i].world = locals[i].local * rootWorld;
+            });
+        refreshEntityBounds(store);
+        entityUpdate.stop();
+    }
+
+    const Frustum frustum(60.0f, 4.0f / 3.0f, 0.5f, 200.0f, translation(512.0f, 1.0f, 1100.0f));
+    Timer graphCull, entityCull;
+    unsigned graphVisible = 0;
+    vector<Entity> visible;
+    for (unsigned pass = 0; pass < PASS_COUNT; ++pass) {
+        VisibleCounter counter;
+        graphCull.start();
+        scene.visitVisible(frustum, counter);
+        graphCull.stop();
+        graphVisible = counter.nodeCount - 1; // not counting the root
+
+        visible.clear();
+        entityCull.start();
+        cullEntities(store, frustum, visible);
+        entityCull.stop();
+    }
+
+    // An entity hanging off the hierarchy picks up its node's world transform
+    const Entity bridged = store.create();
+    store.add(bridged, EntityTransform());
+    EntityNode& bridge = *new EntityNode(store, bridged);
+    scene.setLocalTransform(bridge, translation(1, 2, 3));
+    scene.addChild(scene.getRoot(), bridge);
+    scene.updateTransforms();
+    const Vector3f& bridgedAt = store.get<EntityTransform>(bridged)->world.getTranslation();
+
+    printf("%u objects, %u archetypes\n", unsigned(store.size() - 1), unsigned(store.getArchetypeCount()));
+    printf("  bytes per object: nodes %u, entities %u\n",
+           unsigned(sizeof(Node) + sizeof(Node*)),
+           unsigned(sizeof(LocalTransform) + sizeof(EntityTransform) + sizeof(EntityBounds)
+                    + sizeof(MeshRef) / 4      // on a quarter of the entities
+                    + sizeof(Entity)           // the archetype's entity column
+                    + 3 * sizeof(uint32_t)));  // the entity's location
+    printf("  update: nodes %.3f ms, entities %.3f ms\n",
+           graphUpdate.getAvgSeconds() * 1000, entityUpdate.getAvgSeconds() * 1000);
+    printf("  cull:   nodes %.3f ms (%u visible), entities %.3f ms (%u visible)\n",
+           graphCull.getAvgSeconds() * 1000, graphVisible,
+           entityCull.getAvgSeconds() * 1000, unsigned(visible.size()));
+    printf("  bridged entity at (%g, %g, %g)\n", bridgedAt.x, bridgedAt.y, bridgedAt.z);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @brief Benchmarks merging a frame's draws into instanced groups.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\DrawableNode.h"
+#include "FlexiGraphics\RenderQueue.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+const unsigned PROGRAMS = 2, MATERIALS = 8, MESHES = 4;
+const float NEAR_CLIP = 1, FAR_CLIP = 1000;
+
+/// Stands in for fixed-function drawing: one matrix upload and call per item
+struct PerItemSubmitter
+{
+    unsigned calls;
+    float sink;
+    vector<unsigned>* drawn;
+
+    explicit PerItemSubmitter(vector<unsigned>& drawn) : calls(0), sink(0), drawn(&drawn) {}
+
+    void bindProgram(uint32_t) {}
+    void bindMaterial(uint32_t) {}
+    void bindMesh(uint32_t) {}
+
+    void draw(const DrawItem& item) {
+        const Matrix4x4 matrix(*item.transform);
+        sink += matrix.adr()[12];
+        ++(*drawn)[item.userData];
+        ++calls;
+    }
+};
+
+/// Stands in for instanced drawing: packs each group's transforms into an
+/// instance array, as an instance buffer upload would
+struct InstancingSubmitter
+{
+    unsigned calls;
+    unsigned blendedOutOfOrder;
+    float lastBlendedDepth;
+    vector<Matrix4x3> instances;
+    vector<unsigned>* drawn;
+    const vector<float>* depths;
+
+    InstancingSubmitter(vector<unsigned>& drawn, const vector<float>& depths)
+        : calls(0), blendedOutOfOrder(0), lastBlendedDepth(FAR_CLIP), drawn(&drawn), depths(&depths) {}
+
+    void bindProgram(uint32_t) {}
+    void bindMaterial(uint32_t) {}
+    void bindMesh(uint32_t) {}
+
+    void drawInstances(const DrawItem* const* items, size_t count) {
+        instances.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            instances[i] = *items[i]->transform;
+            ++(*drawn)[items[i]->userData];
+
+            if (DrawKey::isBlended(items[i]->key)) {
+                const float depth = (*depths)[items[i]->userData];
+                if (depth > lastBlendedDepth + 0.01f)
+                    ++blendedOutOfOrder;
+                lastBlendedDepth = depth;
+            }
+        }
+        ++calls;
+    }
+};
+
+unsigned countMisses(const vector<unsigned>& drawn, unsigned frames) {
+    unsigned misses = 0;
+    for (size_t i = 0; i < drawn.size(); ++i)
+        misses += drawn[i] != frames;
+    return misses;
+}
+
+} // namespace
+
+
+/**
+ * Queues 100K visible drawables sharing 2 programs, 8 materials and 4 meshes,
+ * a tenth of them blended, and compares drawing each item with drawing the
+ * groups submitInstanced() forms. Counts draw calls and times the CPU side
+ * of submission, including packing the instance transforms.
+ */
+void runInstancedDrawBenchmark()
+{
+    srand(1);
+    const unsigned DRAWABLES = 100000;
+    const unsigned FRAMES = 10;
+    Scene scene;
+    vector<float> depths(DRAWABLES);
+    for (unsigned i = 0; i < DRAWABLES; ++i) {
+        DrawableNode& node = *new DrawableNode(rand() % PROGRAMS, rand() % MATERIALS, rand() % MESHES);
+        if (i % 10 == 0) {
+            node.layer = 1;
+            node.blended = true;
+        }
+        node.userData = i;
+        depths[i] = 2 + float(rand() % 400);
+        // Spread within the view, so that every drawable is visible
+        const float spread = 0.9f * depths[i];
+        Matrix4x3 m;
+        m.setupTranslation(Vector3f(spread * (2.0f * rand() / RAND_MAX - 1),
+                                    spread * (2.0f * rand() / RAND_MAX - 1), -depths[i]));
+        scene.setLocalTransform(node, m);
+        scene.setLocalBounds(node, BoundingBox(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)));
+        scene.addChild(scene.getRoot(), node);
+    }
+    scene.updateTransforms();
+
+    Matrix4x3 view;
+    view.setIdentity();
+    const Frustum frustum(90.0f, 1.0f, NEAR_CLIP, FAR_CLIP, view);
+
+    RenderQueue queue;
+    DrawQueueBuilder builder(queue, Vector3f(0, 0, 0), Vector3f(0, 0, -1), NEAR_CLIP, FAR_CLIP);
+    scene.visitVisible(frustum, builder);
+    queue.sort();
+
+    vector<unsigned> perItemDrawn(DRAWABLES), instancedDrawn(DRAWABLES);
+    PerItemSubmitter perItem(perItemDrawn);
+    InstancingSubmitter instancing(instancedDrawn, depths);
+    Timer perItemTimer, instancedTimer;
+    for (unsigned frame = 0; frame < FRAMES; ++frame) {
+        perItem.calls = instancing.calls = 0;
+        instancing.lastBlendedDepth = FAR_CLIP;
+        perItemTimer.start();
+        queue.submit(perItem);
+        perItemTimer.stop();
+        instancedTimer.start();
+        queue.submitInstanced(instancing);
+        instancedTimer.stop();
+    }
+    const RenderQueue::Stats& stats = queue.getStats();
+
+    printf("  %u visible of %u drawables\n", unsigned(queue.size()), DRAWABLES);
+    printf("  per item:  %u draw calls, submit %.2f ms\n",
+           perItem.calls, perItemTimer.getAvgSeconds() * 1000);
+    printf("  instanced: %u draw calls, %u binds, submit %.2f ms%s\n",
+           stats.drawCalls, stats.getBinds(), instancedTimer.getAvgSeconds() * 1000,
+           instancing.blendedOutOfOrder ? "  BLENDED OUT OF ORDER" : "");
+    const unsigned misses = countMisses(perItemDrawn, FRAMES) + countMisses(instancedDrawn, FRAMES);
+    if (misses)
+        printf("  %u items not drawn exactly once per frame\n", misses);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file
+ * @brief Benchmarks shared-subtree instancing against deep-cloned subtrees.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\InstanceNode.h"
+#include "FlexiGraphics\InstanceBatches.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiGraphics\Visit.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <memory>
+#include <cstdio>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+const unsigned PROPS = 100, LEAVES = 10;
+
+struct VisibleCounter
+{
+    unsigned nodeCount;
+
+    VisibleCounter() : nodeCount(0) {}
+
+    template <typename N>
+    void visit(N&) { ++nodeCount; }
+
+    template <typename N>
+    void visit(N&, const InstanceContext*) { ++nodeCount; }
+};
+
+/// Counts a whole subtree and the bytes of its nodes
+struct NodeCounter
+{
+    unsigned nodeCount;
+    size_t bytes;
+
+    NodeCounter() : nodeCount(0), bytes(0) {}
+
+    template <typename N>
+    void visit(N&) { ++nodeCount; bytes += sizeof(N); }
+
+    void visit(InnerNode& innerNode) {
+        ++nodeCount;
+        bytes += sizeof(InnerNode);
+        Visit::children(innerNode, *this);
+    }
+};
+
+Matrix4x3 translation(float x, float y, float z) {
+    Matrix4x3 m;
+    m.setupTranslation(Vector3f(x, y, z));
+    return m;
+}
+
+/// Adds a prop of LEAVES x LEAVES unit-spaced leaves under @a parent
+void addProp(Scene& scene, InnerNode& parent, const Matrix4x3& transform) {
+    const BoundingBox leafBounds(Vector3f(-0.4f, 0.0f, -0.4f), Vector3f(0.4f, 1.0f, 0.4f));
+
+    InnerNode& prop = *new InnerNode();
+    scene.setLocalTransform(prop, transform);
+    for (unsigned lx = 0; lx < LEAVES; ++lx)
+    for (unsigned lz = 0; lz < LEAVES; ++lz) {
+        Node& leaf = *new Node();
+        scene.setLocalTransform(leaf, translation(float(lx), 0, float(lz)));
+        scene.setLocalBounds(leaf, leafBounds);
+        prop.addChild(leaf);
+    }
+    scene.addChild(parent, prop);
+}
+
+Matrix4x3 propPlacement(unsigned px, unsigned pz) {
+    return translation(px * 10.0f, 0, pz * 10.0f);
+}
+
+} // namespace
+
+
+/**
+ * Fills a PROPS x PROPS grid with the same prop, once as deep clones and once
+ * as instances of a single prototype, and compares their memory, update and
+ * culling costs, and how many batches the visible instances fall into.
+ */
+void runInstancingBenchmark()
+{
+    Timer cloneBuild, instanceBuild;
+
+    cloneBuild.start();
+    Scene cloned;
+    for (unsigned px = 0; px < PROPS; ++px)
+    for (unsigned pz = 0; pz < PROPS; ++pz)
+        addProp(cloned, cloned.getRoot(), propPlacement(px, pz));
+    cloned.updateTransforms();
+    cloned.refitBounds();
+    cloneBuild.stop();
+
+    instanceBuild.start();
+    shared_ptr<Scene> prototype(new Scene());
+    addProp(*prototype, prototype->getRoot(), translation(0, 0, 0));
+
+    Scene instanced;
+    for (unsigned px = 0; px < PROPS; ++px)
+    for (unsigned pz = 0; pz < PROPS; ++pz) {
+        InstanceNode& instance = *new InstanceNode(prototype);
+        instanced.setLocalTransform(instance, propPlacement(px, pz));
+        instanced.addChild(instanced.getRoot(), instance);
+    }
+    instanced.updateTransforms();
+    instanced.refitBounds();
+    instanceBuild.stop();
+
+    NodeCounter cloneNodes, instanceNodes, prototypeNodes;
+    Visit::node(cloned.getRoot(), cloneNodes);
+    Visit::node(instanced.getRoot(), instanceNodes);
+    Visit::node(prototype->getRoot(), prototypeNodes);
+
+    printf("%u props of %u nodes each\n", PROPS * PROPS, LEAVES * LEAVES + 1);
+    printf("  cloned:    %7u nodes, %6.1f MB, built in %.3f ms\n",
+           cloneNodes.nodeCount, cloneNodes.bytes / 1048576.0,
+           cloneBuild.getAvgSeconds() * 1000);
+    printf("  instanced: %7u nodes, %6.1f MB, built in %.3f ms\n",
+           instanceNodes.nodeCount + prototypeNodes.nodeCount,
+           (instanceNodes.bytes + prototypeNodes.bytes) / 1048576.0,
+           instanceBuild.getAvgSeconds() * 1000);
+
+    // Full transform updates
+    Timer cloneUpdate, instanceUpdate;
+    for (unsigned i = 0; i < 10; ++i) {
+        cloned.setLocalTransform(cloned.getRoot(), cloned.getRoot().getLocalTransform());
+        cloneUpdate.start();
+        cloned.updateTransforms();
+        cloneUpdate.stop();
+
+        instanced.setLocalTransform(instanced.getRoot(), instanced.getRoot().getLocalTransform());
+        instanceUpdate.start();
+        instanced.updateTransforms();
+        instanceUpdate.stop();
+    }
+    printf("  full update: cloned %.3f ms, instanced %.3f ms\n",
+           cloneUpdate.getAvgSeconds() * 1000, instanceUpdate.getAvgSeconds() * 1000);
+
+    // Cull from the near edge looking across the grid
+    const Frustum frustum(60.0f, 4.0f / 3.0f, 0.5f, 200.0f, translation(500.0f, 1.0f, 1000.0f));
+    Timer cloneCull, instanceCull, batching;
+    VisibleCounter cloneVisible, instanceVisible;
+    InstanceBatches batches;
+
+    for (unsigned i = 0; i < 10; ++i) {
+        cloneVisible = VisibleCounter();
+        cloneCull.start();
+        cloned.visitVisible(frustum, cloneVisible);
+        cloneCull.stop();
+
+        instanceVisible = VisibleCounter();
+        instanceCull.start();
+        instanced.visitVisibleInstances(frustum, instanceVisible);
+        instanceCull.stop();
+
+        batches.clear();
+        batching.start();
+        instanced.visitVisible(frustum, batches);
+        batching.stop();
+    }
+    printf("  cull: cloned %.3f ms (%u nodes), instanced %.3f ms (%u nodes)\n",
+           cloneCull.getAvgSeconds() * 1000, cloneVisible.nodeCount,
+           instanceCull.getAvgSeconds() * 1000, instanceVisible.nodeCount);
+    printf("  batching: %u visible instances in %u batch(es), %.3f ms\n",
+           batches.getInstanceCount(), unsigned(batches.getBatches().size()),
+           batching.getAvgSeconds() * 1000);
+}
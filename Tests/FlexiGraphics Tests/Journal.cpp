@@ -0,0 +1,173 @@
+/**
+ * @file
+ * @brief Benchmarks mirroring a scene through its change journal.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\DrawableNode.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiGraphics\SceneJournal.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+const unsigned GROUPS = 1000, PER_GROUP = 100;
+
+/// Copies drawables' world transforms into a flat array, as an instance
+/// buffer would, by DrawableNode::userData
+struct Mirror
+{
+    vector<Matrix4x3>& transforms;
+    unsigned copies;
+
+    Mirror& operator=(const Mirror&);
+
+    explicit Mirror(vector<Matrix4x3>& transforms) : transforms(transforms), copies(0) {}
+
+    template <typename N>
+    void visit(N& node) { add(&node); }
+
+private:
+    void add(Node*) {}
+    void add(DrawableNode* node) {
+        transforms[node->userData] = node->getWorldTransform();
+        ++copies;
+    }
+};
+
+/// Mirror, walking the whole scene
+struct FullScan
+{
+    Mirror& mirror;
+
+    FullScan& operator=(const FullScan&);
+
+    explicit FullScan(Mirror& mirror) : mirror(mirror) {}
+
+    template <typename N>
+    void visit(N& node) {
+        mirror.visit(node);
+        descend(node);
+    }
+
+private:
+    void descend(Node&) {}
+    void descend(InnerNode& innerNode) { Visit::children(innerNode, *this); }
+};
+
+void applyJournal(const SceneJournal& journal, Mirror& mirror) {
+    for (size_t i = 0; i < journal.size(); ++i)
+        if (journal[i].changes & SceneChange::TRANSFORMED)
+            Visit::node(*journal[i].node, mirror);
+}
+
+unsigned countMismatches(const vector<Matrix4x3>& mirror, const vector<DrawableNode*>& nodes) {
+    unsigned mismatches = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const Vector3f& a = mirror[i].getTranslation();
+        const Vector3f& b = nodes[i]->getWorldTransform().getTranslation();
+        mismatches += a.x != b.x || a.y != b.y || a.z != b.z;
+    }
+    return mismatches;
+}
+
+/// Moves @a count random nodes twice each, as physics substeps might
+void moveNodes(Scene& scene, const vector<DrawableNode*>& nodes, unsigned count, float frame) {
+    for (unsigned i = 0; i < count; ++i) {
+        DrawableNode& node = *nodes[rand() % nodes.size()];
+        Matrix4x3 m;
+        m.setupTranslation(Vector3f(frame, float(i), 0));
+        scene.setLocalTransform(node, m);
+        m.setupTranslation(Vector3f(frame, float(i), 0.5f));
+        scene.setLocalTransform(node, m);
+    }
+}
+
+} // namespace
+
+/**
+ * Times moving 10% of 100K drawables and updating transforms with journaling
+ * off and on, to measure the cost of recording. Then moves 1% per frame and
+ * keeps an array of their world transforms up to date, by rescanning the
+ * scene and by applying the journal.
+ */
+void runSceneJournalBenchmark()
+{
+    srand(1);
+    Scene scene;
+    vector<DrawableNode*> nodes;
+    for (unsigned g = 0; g < GROUPS; ++g) {
+        InnerNode& group = *new InnerNode;
+        scene.addChild(scene.getRoot(), group);
+        for (unsigned i = 0; i < PER_GROUP; ++i) {
+            DrawableNode& node = *new DrawableNode(0, 0, 0);
+            node.userData = unsigned(nodes.size());
+            scene.setLocalBounds(node, BoundingBox(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)));
+            scene.addChild(group, node);
+            nodes.push_back(&node);
+        }
+    }
+    scene.updateTransforms();
+
+    // Journaling overhead: alternate frames with it off and on, so both see
+    // the same caches, moving 10% of the nodes twice each
+    const unsigned MOVES = (GROUPS * PER_GROUP) / 10;
+    Timer plain, recorded;
+    for (unsigned frame = 0; frame < 40; ++frame) {
+        const bool journaling = frame % 2 == 1;
+        scene.setJournaling(journaling);
+        Timer& timer = journaling ? recorded : plain;
+        timer.start();
+        moveNodes(scene, nodes, MOVES, float(frame));
+        scene.updateTransforms();
+        timer.stop();
+        scene.getJournal().clear();
+    }
+    printf("  %u drawables, %u moved twice per frame: moves + update %.3f ms, %.3f ms journaling (%+.1f%%)\n",
+           GROUPS * PER_GROUP, MOVES, plain.getAvgSeconds() * 1000, recorded.getAvgSeconds() * 1000,
+           100 * (recorded.getAvgSeconds() / plain.getAvgSeconds() - 1));
+
+    // Mirroring 1% of the nodes moving each frame
+    vector<Matrix4x3> scanned(nodes.size()), journaled(nodes.size());
+    Mirror scanMirror(scanned), journalMirror(journaled);
+    FullScan fullScan(scanMirror);
+    Visit::node(scene.getRoot(), fullScan);
+    journaled = scanned;
+    scanMirror.copies = 0;
+
+    scene.setJournaling(true);
+    Timer scanning, applying;
+    unsigned records = 0, entries = 0;
+    const unsigned FRAMES = 50;
+    for (unsigned frame = 0; frame < FRAMES; ++frame) {
+        moveNodes(scene, nodes, MOVES / 10, 100.0f + frame);
+        scene.updateTransforms();
+
+        applying.start();
+        applyJournal(scene.getJournal(), journalMirror);
+        applying.stop();
+        records += scene.getJournal().getRecordCount();
+        entries += unsigned(scene.getJournal().size());
+        scene.getJournal().clear();
+
+        scanning.start();
+        Visit::node(scene.getRoot(), fullScan);
+        scanning.stop();
+    }
+    printf("  %u moved per frame: journal holds %u entries from %u records (%u bytes)\n", MOVES / 10,
+           entries / FRAMES, records / FRAMES, unsigned(entries / FRAMES * sizeof(SceneChange)));
+    printf("  mirroring: full rescan %.3f ms (%u copies), journal %.3f ms, %u mismatches\n",
+           scanning.getAvgSeconds() * 1000, scanMirror.copies / FRAMES,
+           applying.getAvgSeconds() * 1000, countMismatches(journaled, nodes) + countMismatches(scanned, nodes));
+}
@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @brief Benchmarks screen-space-error level of detail selection.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Camera.h"
+#include "FlexiGraphics\LodNode.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+const float FOVY = 60, NEAR_CLIP = 0.5f, FAR_CLIP = 2500;
+const unsigned VIEWPORT_WIDTH = 1920, VIEWPORT_HEIGHT = 1080;
+
+/// Each level has a quarter of the triangles of the one before
+const LodLevel LEVELS[] = {
+    { 0, 0.0f,  20000 },
+    { 1, 0.01f, 5000 },
+    { 2, 0.04f, 1250 },
+    { 3, 0.16f, 312 },
+};
+
+struct FrameResult
+{
+    unsigned nodes, changes;
+    unsigned long long triangles, fullDetailTriangles;
+};
+
+/// Culls and selects levels from @a camera placed at @a eye looking down -z
+FrameResult selectFrame(Scene& scene, const Camera& camera, const Vector3f& eye,
+                        float hysteresis, Timer& timer) {
+    Matrix4x3 view;
+    view.setupTranslation(eye);
+    const Frustum frustum = camera.frustum(view);
+
+    LodSelector selector(eye, float(camera.pixelsPerUnit()), 1.0f, hysteresis);
+    timer.start();
+    scene.visitVisible(frustum, selector);
+    selector.select();
+    timer.stop();
+
+    const LodSelector::Stats& stats = selector.getStats();
+    FrameResult result = { stats.nodes, stats.levelChanges, stats.triangles, stats.fullDetailTriangles };
+    return result;
+}
+
+void resetLevels(LodNode* const* nodes, unsigned count) {
+    for (unsigned i = 0; i < count; ++i)
+        nodes[i]->setCurrentLevel(0);
+}
+
+} // namespace
+
+/**
+ * Fills a 1900x1900 unit field with 100K four-level LodNodes and flies a
+ * camera across it, timing culling plus selection and comparing the
+ * triangles drawn with drawing everything at full detail. Then holds the
+ * camera still but for a half-unit jitter, counting level changes with and
+ * without hysteresis to show popping.
+ */
+void runLodBenchmark()
+{
+    srand(1);
+    const unsigned SIDE = 316, COUNT = SIDE * SIDE;
+    const float SPACING = 6;
+    Scene scene;
+    vector<LodNode*> nodes(COUNT);
+    for (unsigned i = 0; i < COUNT; ++i) {
+        LodNode& node = *new LodNode(0, 0, LEVELS, 4);
+        Matrix4x3 m;
+        m.setupTranslation(Vector3f((i % SIDE - SIDE / 2.0f) * SPACING, float(rand() % 4),
+                                    -(i / SIDE * SPACING)));
+        scene.setLocalTransform(node, m);
+        scene.setLocalBounds(node, BoundingBox(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)));
+        scene.addChild(scene.getRoot(), node);
+        nodes[i] = &node;
+    }
+    scene.updateTransforms();
+
+    Camera camera(FOVY, NEAR_CLIP, FAR_CLIP);
+    camera.setViewportSize(VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+
+    // Fly in from beyond the near edge of the field to its middle
+    Timer timer;
+    unsigned long long triangles = 0, fullDetailTriangles = 0;
+    unsigned visible = 0, changes = 0;
+    const unsigned FRAMES = 100;
+    for (unsigned frame = 0; frame < FRAMES; ++frame) {
+        const Vector3f eye(0, 10, 100 - frame * 10.0f);
+        const FrameResult result = selectFrame(scene, camera, eye, 0.25f, timer);
+        visible += result.nodes;
+        changes += result.changes;
+        triangles += result.triangles;
+        fullDetailTriangles += result.fullDetailTriangles;
+    }
+    printf("  %u nodes, %u visible per frame: cull + select %.2f ms per frame, %.1f ns per visible node\n",
+           COUNT, visible / FRAMES, timer.getAvgSeconds() * 1000,
+           timer.getAvgSeconds() * 1e9 / (visible / FRAMES));
+    printf("  triangles per frame: %.2fM selected, %.2fM at full detail (%.1f%%), %u level changes per frame\n",
+           triangles / double(FRAMES) / 1e6, fullDetailTriangles / double(FRAMES) / 1e6,
+           100.0 * triangles / fullDetailTriangles, changes / FRAMES);
+
+    // Popping: a camera jittering in place should settle rather than keep
+    // switching the nodes near each threshold
+    const float hysteresisValues[] = { 0.0f, 0.1f, 0.25f };
+    for (unsigned h = 0; h < 3; ++h) {
+        resetLevels(&nodes[0], COUNT);
+        Timer jitterTimer;
+        selectFrame(scene, camera, Vector3f(0, 10, -400), hysteresisValues[h], jitterTimer);
+        unsigned jitterChanges = 0;
+        const unsigned JITTER_FRAMES = 60;
+        for (unsigned frame = 0; frame < JITTER_FRAMES; ++frame) {
+            const Vector3f eye(0, 10, -400 + (frame % 2 ? 0.5f : -0.5f));
+            jitterChanges += selectFrame(scene, camera, eye, hysteresisValues[h], jitterTimer).changes;
+        }
+        printf("  jittering camera, hysteresis %.2f: %.1f level changes per frame\n",
+               hysteresisValues[h], jitterChanges / float(JITTER_FRAMES));
+    }
+}
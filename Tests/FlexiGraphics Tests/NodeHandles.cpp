@@ -0,0 +1,148 @@
+/**
+ * @file
+ * @brief Benchmarks handle-linked node storage against pointer-linked nodes.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\NodeStore.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::util;
+
+namespace {
+
+/// The pointer-linked equivalent of a NodeStore<unsigned> node
+struct PointerNode
+{
+    PointerNode* parent;
+    PointerNode* child;
+    PointerNode* sibling;
+    unsigned value;
+};
+
+unsigned sumPointerTree(PointerNode* root) {
+    unsigned sum = 0;
+    vector<PointerNode*> pending(1, root);
+    while (!pending.empty()) {
+        PointerNode* node = pending.back();
+        pending.pop_back();
+        sum += node->value;
+        for (PointerNode* child = node->child; child; child = child->sibling)
+            pending.push_back(child);
+    }
+    return sum;
+}
+
+struct ValueSummer
+{
+    unsigned sum;
+
+    ValueSummer() : sum(0) {}
+    void operator()(NodeHandle, unsigned value) { sum += value; }
+};
+
+unsigned randomIndex(unsigned count) {
+    return (rand() * (RAND_MAX + 1u) + rand()) % count;
+}
+
+} // namespace
+
+
+/**
+ * Builds the same randomly shaped ~1M node tree both ways, then compares the
+ * per-node link overhead and depth-first traversal time, before and after
+ * compacting the store, and checks that handles into a destroyed subtree are
+ * detected as stale.
+ */
+void runNodeHandleBenchmark()
+{
+    const unsigned NODE_COUNT = 1 << 20;
+    const unsigned PASS_COUNT = 10;
+
+    // Attach each node to a random earlier one, so that allocation order is
+    // unrelated to traversal order
+    vector<unsigned> parentOf(NODE_COUNT, 0);
+    srand(1);
+    for (unsigned i = 1; i < NODE_COUNT; ++i)
+        parentOf[i] = randomIndex(i);
+
+    vector<PointerNode*> pointerNodes(NODE_COUNT);
+    for (unsigned i = 0; i < NODE_COUNT; ++i) {
+        PointerNode* node = new PointerNode();
+        node->value = i;
+        if (i) {
+            PointerNode* parent = pointerNodes[parentOf[i]];
+            node->parent = parent;
+            node->sibling = parent->child;
+            parent->child = node;
+        }
+        pointerNodes[i] = node;
+    }
+
+    NodeStore<unsigned> store;
+    store.reserve(NODE_COUNT);
+    vector<NodeHandle> handles(NODE_COUNT);
+    for (unsigned i = 0; i < NODE_COUNT; ++i) {
+        handles[i] = store.create(i);
+        if (i)
+            store.addChild(handles[parentOf[i]], handles[i]);
+    }
+
+    Timer pointerTimer, storeTimer, compactTimer, compactedTimer;
+    unsigned pointerSum = 0, storeSum = 0, compactedSum = 0;
+
+    for (unsigned pass = 0; pass < PASS_COUNT; ++pass) {
+        pointerTimer.start();
+        pointerSum = sumPointerTree(pointerNodes[0]);
+        pointerTimer.stop();
+
+        ValueSummer summer;
+        storeTimer.start();
+        store.visitDepthFirst(handles[0], summer);
+        storeTimer.stop();
+        storeSum = summer.sum;
+    }
+
+    compactTimer.start();
+    store.compact(handles[0]);
+    compactTimer.stop();
+
+    for (unsigned pass = 0; pass < PASS_COUNT; ++pass) {
+        ValueSummer summer;
+        compactedTimer.start();
+        store.visitDepthFirst(handles[0], summer);
+        compactedTimer.stop();
+        compactedSum = summer.sum;
+    }
+
+    // Destroy a subtree and count the handles that now detect as stale
+    const NodeHandle victim = handles[1];
+    const size_t sizeBefore = store.size();
+    store.destroy(victim);
+    unsigned staleCount = 0;
+    for (unsigned i = 0; i < NODE_COUNT; ++i) {
+        if (!store.get(handles[i]))
+            ++staleCount;
+    }
+
+    printf("%u nodes\n", NODE_COUNT);
+    printf("  links per node: pointers %u bytes (+ allocator overhead), handles %u bytes\n",
+           unsigned(3 * sizeof(void*)), unsigned(NodeStore<unsigned>::getOverheadPerNode()));
+    printf("  traversal: pointers %.3f ms, handles %.3f ms, handles after compact %.3f ms"
+           " (compact took %.3f ms)\n",
+           pointerTimer.getAvgSeconds() * 1000, storeTimer.getAvgSeconds() * 1000,
+           compactedTimer.getAvgSeconds() * 1000, compactTimer.getLastSeconds() * 1000);
+    printf("  checksums %s\n",
+           pointerSum == storeSum && storeSum == compactedSum ? "match" : "DIFFER");
+    printf("  destroyed %u nodes, %u handles detected as stale\n",
+           unsigned(sizeBefore - store.size()), staleCount);
+
+    for (unsigned i = 0; i < NODE_COUNT; ++i)
+        delete pointerNodes[i];
+}
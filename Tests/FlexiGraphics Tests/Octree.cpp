@@ -0,0 +1,188 @@
+/**
+ * @file
+ * @brief Benchmarks the loose octree against brute-force queries.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\LooseOctree.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+const float WORLD_SIZE = 1000.0f;
+
+float randomFloat(float lo, float hi) {
+    return lo + (hi - lo) * (rand() / float(RAND_MAX));
+}
+
+Vector3f randomPoint() {
+    return Vector3f(randomFloat(0, WORLD_SIZE), randomFloat(0, WORLD_SIZE), randomFloat(0, WORLD_SIZE));
+}
+
+BoundingBox boxAround(const Vector3f& center, float halfSize) {
+    return BoundingBox(Vector3f(center.x - halfSize, center.y - halfSize, center.z - halfSize),
+                       Vector3f(center.x + halfSize, center.y + halfSize, center.z + halfSize));
+}
+
+/// Per-query times in microseconds, and whether the results agreed
+struct QueryTiming
+{
+    Timer octree, bruteForce;
+    size_t octreeHits, bruteForceHits;
+
+    QueryTiming() : octreeHits(0), bruteForceHits(0) {}
+
+    void print(const char* name) const {
+        printf("    %-7s octree %9.2f us, brute force %9.2f us, %7.1f hits/query%s\n", name,
+               octree.getAvgSeconds() * 1e6, bruteForce.getAvgSeconds() * 1e6,
+               double(octreeHits) / octree.getIntervalCount(),
+               octreeHits == bruteForceHits ? "" : "  MISMATCH");
+    }
+};
+
+void runAtSize(unsigned objectCount) {
+    const unsigned QUERY_COUNT = 100;
+
+    vector<BoundingBox> bounds(objectCount);
+    for (unsigned i = 0; i < objectCount; ++i)
+        bounds[i] = boxAround(randomPoint(), randomFloat(0.25f, 2.5f));
+
+    LooseOctree octree(BoundingBox(Vector3f(0, 0, 0), Vector3f(WORLD_SIZE, WORLD_SIZE, WORLD_SIZE)));
+    vector<LooseOctree::ObjectId> ids(objectCount);
+
+    Timer insert, move, rebuild, remove;
+    insert.start();
+    for (unsigned i = 0; i < objectCount; ++i)
+        ids[i] = octree.insert(bounds[i]);
+    insert.stop();
+
+    // Move a tenth of the objects a short way
+    const unsigned moveCount = objectCount / 10;
+    move.start();
+    for (unsigned i = 0; i < moveCount; ++i) {
+        BoundingBox& b = bounds[i * 10];
+        const Vector3f step(randomFloat(-1, 1), randomFloat(-1, 1), randomFloat(-1, 1));
+        b = BoundingBox(b.min + step, b.max + step);
+        octree.move(ids[i * 10], b);
+    }
+    move.stop();
+
+    rebuild.start();
+    octree.rebuild();
+    rebuild.stop();
+
+    printf("  %u objects: insert %.3f us, move %.3f us, rebuild %.3f ms (%u cells)\n",
+           objectCount, insert.getLastSeconds() * 1e6 / objectCount,
+           move.getLastSeconds() * 1e6 / moveCount, rebuild.getLastSeconds() * 1000,
+           unsigned(octree.getCellCount()));
+
+    QueryTiming box, sphere, frustum, ray;
+    vector<LooseOctree::ObjectId> hits;
+    for (unsigned q = 0; q < QUERY_COUNT; ++q) {
+        // Box
+        const BoundingBox region = boxAround(randomPoint(), 25.0f);
+        hits.clear();
+        box.octree.start();
+        octree.queryBox(region, hits);
+        box.octree.stop();
+        box.octreeHits += hits.size();
+
+        size_t count = 0;
+        box.bruteForce.start();
+        for (unsigned i = 0; i < objectCount; ++i)
+            if (region.intersects(bounds[i]))
+                ++count;
+        box.bruteForce.stop();
+        box.bruteForceHits += count;
+
+        // Sphere
+        const Vector3f center = randomPoint();
+        hits.clear();
+        sphere.octree.start();
+        octree.querySphere(center, 25.0f, hits);
+        sphere.octree.stop();
+        sphere.octreeHits += hits.size();
+
+        count = 0;
+        sphere.bruteForce.start();
+        for (unsigned i = 0; i < objectCount; ++i)
+            if (bounds[i].intersectsSphere(center, 25.0f))
+                ++count;
+        sphere.bruteForce.stop();
+        sphere.bruteForceHits += count;
+
+        // Frustum, looking into the world from a random point
+        Matrix4x3 eye;
+        eye.setupTranslation(Vector3f(randomFloat(0, WORLD_SIZE), randomFloat(0, WORLD_SIZE), WORLD_SIZE));
+        const Frustum view(60.0f, 4.0f / 3.0f, 0.5f, 100.0f, eye);
+        hits.clear();
+        frustum.octree.start();
+        octree.queryFrustum(view, hits);
+        frustum.octree.stop();
+        frustum.octreeHits += hits.size();
+
+        count = 0;
+        frustum.bruteForce.start();
+        for (unsigned i = 0; i < objectCount; ++i)
+            if (view.intersects(bounds[i]))
+                ++count;
+        frustum.bruteForce.stop();
+        frustum.bruteForceHits += count;
+
+        // Ray across the world
+        const Vector3f origin = randomPoint();
+        Vector3f direction = randomPoint() - origin;
+        direction *= 1.0f / direction.len();
+        const Vector3f inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        hits.clear();
+        ray.octree.start();
+        octree.queryRay(origin, direction, WORLD_SIZE, hits);
+        ray.octree.stop();
+        ray.octreeHits += hits.size();
+
+        count = 0;
+        ray.bruteForce.start();
+        for (unsigned i = 0; i < objectCount; ++i) {
+            float entry;
+            if (bounds[i].intersectsRay(origin, inverse, WORLD_SIZE, entry))
+                ++count;
+        }
+        ray.bruteForce.stop();
+        ray.bruteForceHits += count;
+    }
+    box.print("box");
+    sphere.print("sphere");
+    frustum.print("frustum");
+    ray.print("ray");
+
+    remove.start();
+    for (unsigned i = 0; i < objectCount; ++i)
+        octree.remove(ids[i]);
+    remove.stop();
+    printf("    remove %.3f us\n", remove.getLastSeconds() * 1e6 / objectCount);
+}
+
+} // namespace
+
+
+/**
+ * Fills a 1000^3 world with 10K to 1M small objects and times octree updates
+ * and box, sphere, frustum and ray queries against testing every object.
+ */
+void runOctreeBenchmark()
+{
+    srand(1);
+    runAtSize(10000);
+    runAtSize(100000);
+    runAtSize(1000000);
+}
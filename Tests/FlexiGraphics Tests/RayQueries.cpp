@@ -0,0 +1,252 @@
+/**
+ * @file
+ * @brief Benchmarks batched ray queries against a triangle mesh.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\RayCaster.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+/// Laid out like Neverland's cube vertices: the position follows the normal
+struct Vertex
+{
+    Vector3f normal, position;
+};
+
+float randomFloat(float lo, float hi) {
+    return lo + (hi - lo) * (rand() / float(RAND_MAX));
+}
+
+/// A rolling heightfield of (size - 1)^2 * 2 triangles over [0, 1000]^2
+void makeTerrain(unsigned size, vector<Vertex>& vertices, vector<uint32_t>& indices) {
+    const float step = 1000.0f / (size - 1);
+    vertices.resize(size * size);
+    for (unsigned z = 0; z < size; ++z) {
+        for (unsigned x = 0; x < size; ++x) {
+            const float height = 20 * sin(x * step * 0.02f) * cos(z * step * 0.03f);
+            vertices[z * size + x].position = Vector3f(x * step, height, z * step);
+            vertices[z * size + x].normal = Vector3f(0, 1, 0);
+        }
+    }
+    indices.clear();
+    for (unsigned z = 0; z + 1 < size; ++z) {
+        for (unsigned x = 0; x + 1 < size; ++x) {
+            const uint32_t corner = z * size + x;
+            const uint32_t quad[6] = { corner, corner + size, corner + 1,
+                                       corner + 1, corner + size, corner + size + 1 };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+}
+
+/// The nearest hit by testing every triangle, or -1
+float bruteForce(const vector<Vertex>& vertices, const vector<uint32_t>& indices, const Ray& ray) {
+    float nearest = -1;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const Vector3f& a = vertices[indices[i]].position;
+        const Vector3f e1 = vertices[indices[i + 1]].position - a;
+        const Vector3f e2 = vertices[indices[i + 2]].position - a;
+        const Vector3f p = ray.direction.cross(e2);
+        const float det = e1.dot(p);
+        if (fabs(det) < 1e-12f)
+            continue;
+        const Vector3f s = ray.origin - a;
+        const float u = s.dot(p) / det;
+        const Vector3f q = s.cross(e1);
+        const float v = ray.direction.dot(q) / det;
+        const float t = e2.dot(q) / det;
+        if (u >= 0 && v >= 0 && u + v <= 1 && t >= 0 && t <= ray.maxDistance && (nearest < 0 || t < nearest))
+            nearest = t;
+    }
+    return nearest;
+}
+
+/// A grid of rays through neighbouring pixels of a camera looking down at the terrain
+void makeCameraRays(unsigned size, vector<Ray>& rays) {
+    rays.resize(size * size);
+    const Vector3f eye(500, 300, -100);
+    for (unsigned y = 0; y < size; ++y) {
+        for (unsigned x = 0; x < size; ++x) {
+            Vector3f direction(x / float(size) - 0.5f, -0.6f - y / float(size) * 0.4f, 1);
+            direction *= 1.0f / direction.len();
+            rays[y * size + x] = Ray(eye, direction, 5000);
+        }
+    }
+}
+
+/// Rays between random points, as from scattered line-of-sight checks
+void makeRandomRays(unsigned count, vector<Ray>& rays) {
+    rays.resize(count);
+    for (unsigned i = 0; i < count; ++i) {
+        const Vector3f from(randomFloat(0, 1000), randomFloat(-20, 60), randomFloat(0, 1000));
+        const Vector3f to(randomFloat(0, 1000), randomFloat(-20, 60), randomFloat(0, 1000));
+        rays[i] = Ray(from, to - from, 1);
+    }
+}
+
+/// Traverses one ray at a time, as the baseline for packet traversal
+typedef BasicRayCaster<internal::Float1> SingleRayCaster;
+
+template <typename Caster>
+void castBatch(const char* name, const Caster& caster, const vector<Ray>& rays,
+               const vector<Vertex>& vertices, const vector<uint32_t>& indices) {
+    const size_t count = rays.size();
+    vector<RayHit> nearest(count);
+    vector<char> occludedStorage(count);
+    bool* occluded = reinterpret_cast<bool*>(&occludedStorage[0]);
+    vector<RayHit> all;
+
+    Timer nearestTimer, anyTimer, allTimer;
+    nearestTimer.start();
+    caster.castNearest(&rays[0], &nearest[0], count);
+    nearestTimer.stop();
+    anyTimer.start();
+    caster.castAny(&rays[0], occluded, count);
+    anyTimer.stop();
+    allTimer.start();
+    caster.castAll(&rays[0], count, all);
+    allTimer.stop();
+
+    // Check a sample against brute force and the three modes against each other
+    unsigned hitCount = 0, mismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        hitCount += nearest[i].isHit();
+        if (nearest[i].isHit() != occluded[i])
+            ++mismatches;
+    }
+    for (size_t i = 0; i < count; i += count / 16) {
+        const float expected = bruteForce(vertices, indices, rays[i]);
+        if ((expected >= 0) != nearest[i].isHit()
+                || (expected >= 0 && fabs(expected - nearest[i].distance) > 1e-3f * expected))
+            ++mismatches;
+    }
+    size_t firsts = 0;
+    for (size_t i = 0; i < all.size(); ++i) {
+        if (i == 0 || all[i].ray != all[i - 1].ray) {
+            ++firsts;
+            if (all[i].distance != nearest[all[i].ray].distance)
+                ++mismatches;
+        }
+    }
+    if (firsts != hitCount)
+        ++mismatches;
+
+    printf("    %-7s nearest %6.2f M rays/s, any %6.2f M rays/s, all %6.2f M rays/s, %.0f%% hit%s\n",
+           name, count / nearestTimer.getLastSeconds() * 1e-6, count / anyTimer.getLastSeconds() * 1e-6,
+           count / allTimer.getLastSeconds() * 1e-6, 100.0 * hitCount / count,
+           mismatches ? "  MISMATCH" : "");
+}
+
+/// Picks the cube from Neverland, whose positions are interleaved with normals
+bool pickCube() {
+    static const Vertex cube[] = {
+        { Vector3f(0, 0, -1), Vector3f(-0.5f, -0.5f, -0.5f) }, { Vector3f(0, 0, -1), Vector3f(-0.5f, 0.5f, -0.5f) },
+        { Vector3f(0, 0, -1), Vector3f( 0.5f,  0.5f, -0.5f) }, { Vector3f(0, 0, -1), Vector3f( 0.5f, -0.5f, -0.5f) },
+        { Vector3f(0, 0,  1), Vector3f(-0.5f, -0.5f,  0.5f) }, { Vector3f(0, 0,  1), Vector3f( 0.5f, -0.5f,  0.5f) },
+        { Vector3f(0, 0,  1), Vector3f( 0.5f,  0.5f,  0.5f) }, { Vector3f(0, 0,  1), Vector3f(-0.5f,  0.5f,  0.5f) },
+    };
+    static const uint16_t indices[] = { 0, 1, 2,  0, 2, 3,  4, 5, 6,  4, 6, 7 };
+
+    RayCaster caster;
+    caster.build(cube[0].position.adr(), sizeof(Vertex), indices, 4);
+    const Ray rays[2] = { Ray(Vector3f(0.1f, 0.2f, 5), Vector3f(0, 0, -1), 100),
+                          Ray(Vector3f(2, 0, 5), Vector3f(0, 0, -1), 100) };
+    RayHit hits[2];
+    caster.castNearest(rays, hits, 2);
+    return hits[0].triangle >= 2 && fabs(hits[0].distance - 4.5f) < 1e-5f && !hits[1].isHit();
+}
+
+/**
+ * Casts rays parallel to the z axis that lie on the planes of a unit square's
+ * bounding box, with +0 and -0 in their other components, where the slab
+ * test meets 0 * inf. Returns the number that disagree with brute force.
+ */
+template <typename Caster>
+unsigned castAlongFaces() {
+    vector<Vertex> square(4);
+    square[0].position = Vector3f(-0.5f, -0.5f, 0);
+    square[1].position = Vector3f(-0.5f,  0.5f, 0);
+    square[2].position = Vector3f( 0.5f,  0.5f, 0);
+    square[3].position = Vector3f( 0.5f, -0.5f, 0);
+    const uint32_t quad[6] = { 0, 1, 2,  0, 2, 3 };
+    const vector<uint32_t> indices(quad, quad + 6);
+
+    Caster caster;
+    caster.build(square[0].position.adr(), sizeof(Vertex), &indices[0], 2);
+
+    const float planes[2] = { -0.5f, 0.5f };
+    const float zeros[2] = { 0.0f, -0.0f };
+    vector<Ray> rays;
+    for (unsigned plane = 0; plane < 2; ++plane) {
+        for (unsigned zero = 0; zero < 2; ++zero) {
+            rays.push_back(Ray(Vector3f(planes[plane], 0.1f, 5), Vector3f(zeros[zero], 0, -1), 100));
+            rays.push_back(Ray(Vector3f(0.1f, planes[plane], 5), Vector3f(0, zeros[zero], -1), 100));
+        }
+    }
+    vector<RayHit> hits(rays.size());
+    caster.castNearest(&rays[0], &hits[0], rays.size());
+
+    unsigned mismatches = 0;
+    for (size_t i = 0; i < rays.size(); ++i) {
+        const float expected = bruteForce(square, indices, rays[i]);
+        if ((expected >= 0) != hits[i].isHit()
+                || (expected >= 0 && fabs(expected - hits[i].distance) > 1e-5f))
+            ++mismatches;
+    }
+    return mismatches;
+}
+
+} // namespace
+
+
+/**
+ * Casts camera-grid rays and random line-of-sight rays at a 500K-triangle
+ * terrain and reports nearest, any and all hit throughput, both in packets
+ * and one ray at a time. First checks picking and rays along box faces.
+ */
+void runRayQueryBenchmark()
+{
+    srand(1);
+    printf("  packet width %u, %s\n", RayCaster::PACKET_WIDTH,
+           pickCube() ? "cube picked" : "cube pick FAILED");
+    const unsigned faceMismatches = castAlongFaces<RayCaster>() + castAlongFaces<SingleRayCaster>();
+    printf("  rays along box faces %s\n", faceMismatches ? "MISMATCH" : "match brute force");
+
+    vector<Vertex> vertices;
+    vector<uint32_t> indices;
+    makeTerrain(501, vertices, indices);
+    RayCaster caster;
+    SingleRayCaster single;
+    Timer build;
+    build.start();
+    caster.build(vertices[0].position.adr(), sizeof(Vertex), &indices[0], unsigned(indices.size() / 3));
+    build.stop();
+    single.build(vertices[0].position.adr(), sizeof(Vertex), &indices[0], unsigned(indices.size() / 3));
+    printf("  %u triangles built in %.1f ms\n", unsigned(caster.getTriangleCount()),
+           build.getLastSeconds() * 1000);
+
+    vector<Ray> rays;
+    makeCameraRays(1024, rays);
+    printf("  packets:\n");
+    castBatch("camera", caster, rays, vertices, indices);
+    printf("  single rays:\n");
+    castBatch("camera", single, rays, vertices, indices);
+    makeRandomRays(1 << 18, rays);
+    printf("  packets:\n");
+    castBatch("random", caster, rays, vertices, indices);
+    printf("  single rays:\n");
+    castBatch("random", single, rays, vertices, indices);
+}
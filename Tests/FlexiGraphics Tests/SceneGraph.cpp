@@ -1,27 +1,19 @@
 /**
  * @file
- * @brief Integration tests for the scene graph.
+ * @brief Entry point for the scene graph benchmarks.
  * @author   Steven Bloemer
  * @date     4/17/2011
- * @lastedit 4/17/2011
+ * @lastedit 10/19/2026
  */
 #include "FlexiGraphics\Node.h"
 #include "FlexiGraphics\InnerNode.h"
 #include "FlexiGraphics\Visit.h"
-#include "FlexiGraphics\Spatial.h"
-#include "FlexiGraphics\VNode.h"
-#include "FlexiGraphics\Visitor.h"
-#include "FlexiGraphics\NodeBase.h"
-#include "FlexiGraphics\Leaf.h"
-#include "FlexiUtil\Timer.h"
 #include <string>
 #include <iostream>
-#include <iomanip>
-#include <cstdio>
+#include <cstdlib>
 
 using namespace std;
 using namespace flexi::graphics;
-using namespace flexi::util;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -50,101 +42,115 @@ public:
     }
 };
 
-struct NodeCounter
-{
-    unsigned nodeCount;
-
-    NodeCounter() : nodeCount(0) {}
+////////////////////////////////////////////////////////////////////////////////
+// Benchmarks defined in other files
+
+bool runBenchmarkSuite(unsigned nodeCount, unsigned repeats, const char* jsonPath);
+void runTransformBenchmark();
+void runCullingBenchmark();
+void runNodeHandleBenchmark();
+void runInstancingBenchmark();
+void runDestructionBenchmark();
+void runBatchDispatchBenchmark();
+void runEntityBenchmark();
+void runOctreeBenchmark();
+void runBvhBenchmark();
+void runRayQueryBenchmark();
+void runDrawSortingBenchmark();
+void runLodBenchmark();
+void runSnapshotBenchmark();
+void runSceneJournalBenchmark();
+void runInstancedDrawBenchmark();
 
-    void visit(Node&) {
-        ++nodeCount;
+//---------------------------------------------------------------------------
+// MAIN METHOD:
+//---------------------------------------------------------------------------
+/**
+ * Usage: SceneGraph [--nodes N] [--repeats N] [--json FILE] [--suite-only]
+ * 
+ * Runs the benchmark suite over trees of about N nodes (default 1M), repeating
+ * each measurement N times (default 5), optionally writing the results to
+ * FILE as JSON. Unless --suite-only is given, the feature benchmarks run
+ * afterwards. Exits with a nonzero status on bad arguments or output errors.
+ */
+int main(int argc, char* argv[])
+{
+    unsigned nodeCount = 1 << 20;
+    unsigned repeats = 5;
+    const char* jsonPath = 0;
+    bool suiteOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg == "--nodes" && i + 1 < argc)
+            nodeCount = unsigned(atoi(argv[++i]));
+        else if (arg == "--repeats" && i + 1 < argc)
+            repeats = unsigned(atoi(argv[++i]));
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (arg == "--suite-only")
+            suiteOnly = true;
+        else {
+            cerr << "Usage: " << argv[0]
+                 << " [--nodes N] [--repeats N] [--json FILE] [--suite-only]" << endl;
+            return 2;
+        }
     }
-
-    void visit(InnerNode& in) {
-        ++nodeCount;
-        Visit::children(in, *this);
+    if (nodeCount < 2 || repeats < 1) {
+        cerr << "--nodes must be at least 2 and --repeats at least 1" << endl;
+        return 2;
     }
-};
 
-struct VNodeCounter: public Visitor
-{
-    unsigned nodeCount;
+    cout << "Running the scene graph benchmark suite" << endl;
+    if (!runBenchmarkSuite(nodeCount, repeats, jsonPath))
+        return 1;
+    if (suiteOnly)
+        return 0;
 
-    VNodeCounter() : nodeCount(0) {}
+    cout << "Testing incremental transform updates" << endl;
+    runTransformBenchmark();
 
-    virtual void visitSpatial(Spatial&) { ++nodeCount; }
-    virtual void visitNode(VNode& vn) {
-        ++nodeCount;
-        vn.visitChildren(*this);
-    }
-};
+    cout << "Testing hierarchical frustum culling" << endl;
+    runCullingBenchmark();
 
-struct EnumNodeCounter
-{
-    unsigned nodeCount;
+    cout << "Testing generational node handles" << endl;
+    runNodeHandleBenchmark();
 
-    EnumNodeCounter() : nodeCount(0) {}
+    cout << "Testing shared-subtree instancing" << endl;
+    runInstancingBenchmark();
 
-    void visitNodeBase(NodeBase& nb) {++nodeCount;}
-    void visitLeaf(Leaf& leaf) {
-        ++nodeCount;
-        leaf.visitChildren(*this);
-    }
-};
+    cout << "Testing deferred subtree destruction" << endl;
+    runDestructionBenchmark();
 
-////////////////////////////////////////////////////////////////////////////////
-// Test templates
+    cout << "Testing type-bucketed batch dispatch" << endl;
+    runBatchDispatchBenchmark();
 
-template <typename N, typename L>
-N& buildTree(unsigned depth, unsigned breadth) {
-    N& root = *new N();
-    if (depth)
-        for (unsigned i = 0; i < breadth; ++i)
-            root.addChild(buildTree<N,L>(depth-1, breadth));
-    else
-        root.addChild(*new L()).addChild(*new L());
+    cout << "Testing archetype entity storage" << endl;
+    runEntityBenchmark();
 
-    return root;
-}
+    cout << "Testing loose octree queries" << endl;
+    runOctreeBenchmark();
 
-template <typename Counter, typename N, typename L, typename RunFxn>
-void runTest(RunFxn run_it) {
-    L& root = buildTree<N,L>(22,2);
+    cout << "Testing bounding volume hierarchy build and queries" << endl;
+    runBvhBenchmark();
 
-    Counter counter;
-    Timer timer;
+    cout << "Testing batched ray queries" << endl;
+    runRayQueryBenchmark();
 
-    timer.start();
-    run_it(root, counter);
-    timer.stop();
+    cout << "Testing sorted render queue" << endl;
+    runDrawSortingBenchmark();
 
-    delete &root;
+    cout << "Testing screen-space-error LOD selection" << endl;
+    runLodBenchmark();
 
-    printf("Counted %d nodes in %.2f seconds\n", counter.nodeCount, timer.getLastSeconds());
-}
+    cout << "Testing double-buffered scene snapshots" << endl;
+    runSnapshotBenchmark();
 
+    cout << "Testing scene change journal" << endl;
+    runSceneJournalBenchmark();
 
-//---------------------------------------------------------------------------
-// MAIN METHOD:
-//---------------------------------------------------------------------------
-void main()
-{
-    cout << "Testing with InnerNode/Node" << endl;
-    runTest<NodeCounter,InnerNode,Node>([](Node& n, NodeCounter& c) {
-        Visit::node(n,c);
-    });
-
-    cout << "Testing with VNode/Spatial" << endl;
-    runTest<VNodeCounter,VNode,Spatial>([](Spatial& sp, VNodeCounter& vc) {
-        sp.accept(vc);
-    });
-
-    cout << "Testing with NodeBase/Leaf" << endl;
-    runTest<EnumNodeCounter,Leaf,NodeBase>([](NodeBase& nb, EnumNodeCounter& ec) {
-        nb.accept(ec);
-    });
-
-    cout << "\nEnter a character to exit";
-    std::string s;
-    std::cin >> s;
+    cout << "Testing instanced draw merging" << endl;
+    runInstancedDrawBenchmark();
+
+    return 0;
 }
\ No newline at end of file
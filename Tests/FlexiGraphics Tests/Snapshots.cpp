@@ -0,0 +1,196 @@
+/**
+ * @file
+ * @brief Benchmarks handing scene snapshots from a simulation thread to a
+ *        render thread.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\DrawableNode.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiGraphics\SceneSnapshot.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Parallel.h"
+#include "FlexiUtil\Timer.h"
+#include "FlexiUtil\TripleBuffer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include "windows.h"
+#else
+#include <thread>
+#endif
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+const unsigned DRAWABLES = 20000;
+
+/// Checks that every draw of a snapshot was captured in the same frame
+struct CheckingSubmitter
+{
+    float frame;
+    unsigned draws, torn;
+
+    explicit CheckingSubmitter(unsigned frame) : frame(float(frame)), draws(0), torn(0) {}
+
+    void bindProgram(uint32_t) {}
+    void bindMaterial(uint32_t) {}
+    void bindMesh(uint32_t) {}
+
+    void draw(const DrawItem& item) {
+        ++draws;
+        torn += item.transform->getTranslation().y != frame;
+    }
+};
+
+/// Moves every node to height @a frame and captures the result
+struct Simulation
+{
+    Scene scene;
+    vector<DrawableNode*> nodes;
+    vector<Vector3f> positions;
+
+    Simulation() {
+        for (unsigned i = 0; i < DRAWABLES; ++i) {
+            DrawableNode& node = *new DrawableNode(rand() % 16, rand() % 128, rand() % 64);
+            scene.setLocalBounds(node, BoundingBox(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)));
+            scene.addChild(scene.getRoot(), node);
+            nodes.push_back(&node);
+            positions.push_back(Vector3f(float(rand() % 200) - 100, 0, -2 - float(rand() % 400)));
+        }
+    }
+
+    void step(unsigned frame, SceneSnapshot& snapshot) {
+        for (unsigned i = 0; i < DRAWABLES; ++i) {
+            Matrix4x3 m;
+            m.setupTranslation(Vector3f(positions[i].x, float(frame), positions[i].z));
+            scene.setLocalTransform(*nodes[i], m);
+        }
+        scene.updateTransforms();
+        snapshot.capture(scene, SceneSnapshot::View(), frame);
+    }
+};
+
+/// Both sides of an overlapped run, each for its own thread
+struct Pipeline
+{
+    Simulation& simulation;
+    TripleBuffer<SceneSnapshot> snapshots;
+    unsigned frames;
+    unsigned rendered, torn;
+
+    Pipeline& operator=(const Pipeline&);
+
+    Pipeline(Simulation& simulation, unsigned frames)
+        : simulation(simulation), frames(frames), rendered(0), torn(0) {}
+
+    void simulate() {
+        for (unsigned frame = 1; frame <= frames; ++frame) {
+            simulation.step(frame, snapshots.getBack());
+            snapshots.publish();
+        }
+    }
+
+    /// Renders whatever is newest until the last frame has been drawn
+    void render() {
+        unsigned frame = 0;
+        while (frame != frames) {
+            if (!snapshots.acquire())
+                continue;
+            SceneSnapshot& snapshot = snapshots.getFront();
+            CheckingSubmitter submitter(snapshot.getFrame());
+            snapshot.submit(submitter);
+            frame = snapshot.getFrame();
+            torn += submitter.torn;
+            ++rendered;
+        }
+    }
+};
+
+#ifdef _WIN32
+DWORD WINAPI runRenderer(LPVOID pipeline)
+{
+    static_cast<Pipeline*>(pipeline)->render();
+    return 0;
+}
+#endif
+
+} // namespace
+
+/**
+ * Moves 20K drawables every frame, capturing a snapshot and submitting it,
+ * first one after the other on one thread, then with simulation and
+ * submission on two threads sharing a TripleBuffer. Every draw checks that
+ * its transform belongs to the frame it was submitted in.
+ */
+void runSnapshotBenchmark()
+{
+    srand(1);
+    Simulation simulation;
+    const unsigned FRAMES = 200;
+
+    // One thread: simulate, capture and submit in turn
+    Timer serial, step, submit;
+    unsigned torn = 0;
+    SceneSnapshot snapshot;
+    serial.start();
+    for (unsigned frame = 1; frame <= FRAMES; ++frame) {
+        step.start();
+        simulation.step(frame, snapshot);
+        step.stop();
+        submit.start();
+        CheckingSubmitter submitter(frame);
+        snapshot.submit(submitter);
+        submit.stop();
+        torn += submitter.torn;
+    }
+    serial.stop();
+    printf("  %u drawables, one thread: %.2f ms per frame (simulate + capture %.2f ms, submit %.2f ms)%s\n",
+           DRAWABLES, serial.getTotalSeconds() * 1000 / FRAMES, step.getAvgSeconds() * 1000,
+           submit.getAvgSeconds() * 1000, torn ? "  TORN" : "");
+
+    // Two threads: frame N is submitted while frame N+1 is simulated. The
+    // renderer spins until the simulation's last frame, so the two sides must
+    // run at the same time; parallelFor may run its tasks one after another.
+    Pipeline pipeline(simulation, FRAMES);
+    Timer overlapped;
+    overlapped.start();
+#ifdef _WIN32
+    const HANDLE renderer = CreateThread(0, 0, runRenderer, &pipeline, 0, 0);
+    flexiAssert(renderer);
+    pipeline.simulate();
+    WaitForSingleObject(renderer, INFINITE);
+    CloseHandle(renderer);
+#else
+    std::thread renderer(&Pipeline::render, &pipeline);
+    pipeline.simulate();
+    renderer.join();
+#endif
+    overlapped.stop();
+    printf("  overlapped on %u cores: %.2f ms per simulated frame, %u frames submitted, %u dropped%s\n",
+           getWorkerCount(), overlapped.getTotalSeconds() * 1000 / FRAMES, pipeline.rendered,
+           pipeline.snapshots.getDroppedCount(), pipeline.torn ? "  TORN" : "");
+
+    // The hand-off itself
+    TripleBuffer<unsigned> buffer;
+    const unsigned HANDOFFS = 1000000;
+    Timer handoff;
+    handoff.start();
+    for (unsigned i = 0; i < HANDOFFS; ++i) {
+        buffer.getBack() = i;
+        buffer.publish();
+        buffer.acquire();
+    }
+    handoff.stop();
+    printf("  publish + acquire: %.1f ns%s\n", handoff.getTotalSeconds() * 1e9 / HANDOFFS,
+           buffer.getFront() == HANDOFFS - 1 ? "" : "  WRONG VALUE");
+}
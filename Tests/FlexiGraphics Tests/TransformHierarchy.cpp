@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @brief Benchmarks incremental world transform updates in the scene graph.
+ * @author   Steven Bloemer
+ * @date     10/19/2026
+ * @lastedit 10/19/2026
+ */
+#include "FlexiGraphics\Node.h"
+#include "FlexiGraphics\InnerNode.h"
+#include "FlexiGraphics\Scene.h"
+#include "FlexiGraphics\Visit.h"
+#include "FlexiMath\FlexiMath.h"
+#include "FlexiUtil\Timer.h"
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using namespace flexi::graphics;
+using namespace flexi::math;
+using namespace flexi::util;
+
+namespace {
+
+struct NodeCollector
+{
+    vector<Node*>& nodes;
+
+    NodeCollector(vector<Node*>& nodes) : nodes(nodes) {}
+
+    void visit(Node& n) { nodes.push_back(&n); }
+    void visit(InnerNode& in) {
+        nodes.push_back(&in);
+        Visit::children(in, *this);
+    }
+
+private:
+    NodeCollector& operator=(const NodeCollector&);
+};
+
+InnerNode& buildTree(unsigned depth, unsigned breadth) {
+    InnerNode& root = *new InnerNode();
+    for (unsigned i = 0; i < breadth; ++i) {
+        if (depth)
+            root.addChild(buildTree(depth-1, breadth));
+        else
+            root.addChild(*new Node());
+    }
+    return root;
+}
+
+} // namespace
+
+
+/**
+ * Moves 1% of a ~1M node scene per frame and compares the incremental update
+ * against forcing every world transform to be recomputed.
+ */
+void runTransformBenchmark()
+{
+    const unsigned FRAME_COUNT = 100;
+
+    Scene scene;
+    scene.addChild(scene.getRoot(), buildTree(18, 2));
+    scene.updateTransforms();
+
+    vector<Node*> nodes;
+    NodeCollector collector(nodes);
+    Visit::children(scene.getRoot(), collector);
+
+    const unsigned moveCount = unsigned(nodes.size() / 100);
+    Matrix4x3 offset;
+    offset.setupTranslation(Vector3f(0.01f, 0.0f, 0.0f));
+
+    Timer incremental, full;
+    unsigned long long recomputed = 0;
+    srand(1);
+
+    for (unsigned frame = 0; frame < FRAME_COUNT; ++frame) {
+        for (unsigned i = 0; i < moveCount; ++i) {
+            Node& node = *nodes[(rand() * (RAND_MAX + 1u) + rand()) % nodes.size()];
+            scene.setLocalTransform(node, node.getLocalTransform() * offset);
+        }
+
+        incremental.start();
+        scene.updateTransforms();
+        incremental.stop();
+        recomputed += scene.getLastUpdateCount();
+
+        scene.setLocalTransform(scene.getRoot(), scene.getRoot().getLocalTransform());
+        full.start();
+        scene.updateTransforms();
+        full.stop();
+    }
+
+    printf("Moved %u of %u nodes per frame\n", moveCount, unsigned(nodes.size()));
+    printf("  incremental: %.3f ms/frame, %llu world transforms/frame\n",
+           incremental.getAvgSeconds() * 1000, recomputed / FRAME_COUNT);
+    printf("  full:        %.3f ms/frame, %u world transforms/frame\n",
+           full.getAvgSeconds() * 1000, scene.getLastUpdateCount());
+}